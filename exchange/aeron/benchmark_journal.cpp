@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark/reporter_console.h"
+#include "time/timestamp.h"
+
+#include "command_option_parser.h"
+#include "configuration.h"
+#include "journal.h"
+
+#include "trader/providers/nasdaq/ouch_handler.h"
+
+using namespace TradingPlatform;
+using namespace TradingPlatform::Aeron;
+
+struct BenchmarkSettings
+{
+    std::string directory = "journal-benchmark";
+    std::size_t messages = 10000000;
+    std::size_t batch = 64;
+    std::size_t segmentSize = DEFAULT_JOURNAL_SEGMENT_SIZE;
+    bool invalid = true;
+};
+
+// Remove all segments left by the previous run
+void cleanup(const std::string &directory)
+{
+    DIR *dir = ::opendir(directory.c_str());
+    if (dir == nullptr)
+        return;
+    while (struct dirent *entry = ::readdir(dir))
+    {
+        if (std::strncmp(entry->d_name, "journal-", 8) == 0)
+            ::unlink((directory + "/" + entry->d_name).c_str());
+    }
+    ::closedir(dir);
+}
+
+void benchmark(const std::string &name, JournalFsync fsync, const BenchmarkSettings &settings)
+{
+    cleanup(settings.directory);
+
+    JournalSettings journalSettings;
+    journalSettings.directory = settings.directory;
+    journalSettings.segmentSize = settings.segmentSize;
+    journalSettings.fsync = fsync;
+
+    std::vector<std::uint64_t> latencies(settings.messages);
+
+    // Append messages imitating the subscriber which commits once per polled buffer
+    uint64_t timestamp_start = CppCommon::Timestamp::nano();
+    {
+        Journal journal(journalSettings);
+        if (journal.isFailed())
+            return;
+
+        OUCH::EnterOrderMessage message = {};
+        message.Type = 'O';
+        message.OrderVerb = 'B';
+        message.Shares = 100;
+        message.OrderbookId = 1;
+        for (size_t i = 0; i < settings.messages; ++i)
+        {
+            uint64_t timestamp = CppCommon::Timestamp::nano();
+            message.OrderToken = static_cast<uint32_t>(i + 1);
+            message.Price = static_cast<uint32_t>(1000 + (i % 100));
+            journal.append(message);
+            if (((i + 1) % settings.batch) == 0)
+                journal.commit();
+            latencies[i] = CppCommon::Timestamp::nano() - timestamp;
+        }
+        journal.commit();
+    }
+    uint64_t timestamp_stop = CppCommon::Timestamp::nano();
+
+    // Replay all records
+    uint64_t replayed = 0;
+    uint64_t tokens = 0;
+    uint64_t timestamp_replay = CppCommon::Timestamp::nano();
+    {
+        Journal journal(journalSettings);
+        replayed = journal.replay([&tokens](const JournalRecord &record, std::uint8_t *frame)
+        {
+            OUCH::EnterOrderMessage message;
+            if (message.deserialize(frame + Journal::FRAME_HEADER_SIZE, record.size - Journal::FRAME_HEADER_SIZE))
+                tokens += message.OrderToken;
+        });
+    }
+    uint64_t timestamp_replayed = CppCommon::Timestamp::nano();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double value)
+    {
+        size_t index = static_cast<size_t>(value * (latencies.size() - 1));
+        return CppBenchmark::ReporterConsole::GenerateTimePeriod(latencies[index]);
+    };
+
+    std::cout << name << std::endl;
+    std::cout << "Append time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
+    std::cout << "Append latency p50: " << percentile(0.50) << std::endl;
+    std::cout << "Append latency p99: " << percentile(0.99) << std::endl;
+    std::cout << "Append latency p99.9: " << percentile(0.999) << std::endl;
+    std::cout << "Append latency max: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(latencies.back()) << std::endl;
+    std::cout << "Replayed records: " << replayed << " (checksum " << tokens << ")" << std::endl;
+    std::cout << "Replay time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_replayed - timestamp_replay) << std::endl;
+    std::cout << "Replay throughput: " << replayed * 1000000000 / std::max<uint64_t>(timestamp_replayed - timestamp_replay, 1) << " records/s" << std::endl;
+    std::cout << std::endl;
+}
+
+BenchmarkSettings parseBenchmarkSettings(int argc, char **argv)
+{
+    BenchmarkSettings settings;
+
+    try
+    {
+        CommandOptionParser parser;
+
+        // Prepare command options parser
+        parser.addOption(CommandOption("benchmark.dir",      1, 1, "Directory used to store journal segments."));
+        parser.addOption(CommandOption("benchmark.messages", 1, 1, "Count of messages to append."));
+        parser.addOption(CommandOption("benchmark.batch",    1, 1, "Count of messages appended between group commits."));
+        parser.addOption(CommandOption("benchmark.segment",  1, 1, "Size of each journal segment file (in bytes)."));
+
+        // Parse command arguments
+        parser.parse(argc, argv);
+
+        // Use specified options
+        settings.directory = parser.getOption("benchmark.dir").getParam(0, settings.directory);
+        settings.messages = static_cast<size_t>(parser.getOption("benchmark.messages").getParamAsInt(0, 1, INT32_MAX, static_cast<int>(settings.messages)));
+        settings.batch = static_cast<size_t>(parser.getOption("benchmark.batch").getParamAsInt(0, 1, INT32_MAX, static_cast<int>(settings.batch)));
+        settings.segmentSize = static_cast<size_t>(parser.getOption("benchmark.segment").getParamAsInt(0, 65536, INT32_MAX, static_cast<int>(settings.segmentSize)));
+        settings.invalid = false;
+    }
+    catch (const aeron::util::SourcedException &e)
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl << std::endl;
+    }
+
+    return settings;
+}
+
+int main(int argc, char **argv)
+{
+    auto settings = parseBenchmarkSettings(argc, argv);
+    if (settings.invalid)
+        return -1;
+
+    std::cout << "Journaling " << settings.messages << " messages with group commit of " << settings.batch << " messages" << std::endl << std::endl;
+
+    benchmark("Fsync never", JournalFsync::NEVER, settings);
+    benchmark("Fsync batch", JournalFsync::BATCH, settings);
+
+    // Sync of every record is orders of magnitude slower, so run it on a small part of messages
+    BenchmarkSettings always = settings;
+    always.messages = std::max<size_t>(settings.messages / 1000, 1);
+    benchmark("Fsync always", JournalFsync::ALWAYS, always);
+
+    cleanup(settings.directory);
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark/reporter_console.h"
+#include "time/timestamp.h"
+
+#include "circular_buffer.h"
+#include "command_option_parser.h"
+#include "configuration.h"
+#include "spsc_ring_buffer.h"
+
+using namespace TradingPlatform;
+using namespace TradingPlatform::Aeron;
+
+struct BenchmarkSettings
+{
+    std::size_t messages = 10000000;
+    std::size_t size = 40;
+    std::size_t bufferSize = DEFAULT_PUBLISHER_BUFFER_SIZE;
+    std::size_t messageSize = DEFAULT_PUBLISHER_MESSAGE_SIZE;
+    bool invalid = true;
+};
+
+// Publisher buffer used before: C circular buffer guarded with a mutex
+class MutexCircularBuffer
+{
+public:
+    MutexCircularBuffer(const BenchmarkSettings &settings)
+        : _settings(settings)
+    {
+        _bufferMessage.resize(_settings.messageSize);
+        _bufferCircular = CircularBufferCreate(_settings.bufferSize);
+    }
+
+    ~MutexCircularBuffer()
+    {
+        CircularBufferFree(_bufferCircular);
+    }
+
+    void publish(void *data, size_t size)
+    {
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> locker(_mutex);
+                auto bufferCapacity = CircularBufferGetCapacity(_bufferCircular);
+                auto bufferUsedBytes = CircularBufferGetDataSize(_bufferCircular);
+                if (bufferCapacity - bufferUsedBytes >= size)
+                {
+                    CircularBufferPush(_bufferCircular, reinterpret_cast<std::uint8_t *>(data), size);
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    size_t consume()
+    {
+        size_t readBytes = 0;
+        {
+            std::lock_guard<std::mutex> locker(_mutex);
+            readBytes = std::min(CircularBufferGetDataSize(_bufferCircular), _settings.messageSize);
+            if (readBytes > 0)
+                readBytes = CircularBufferRead(_bufferCircular, readBytes, &_bufferMessage[0]);
+        }
+        if (readBytes > 0)
+        {
+            std::lock_guard<std::mutex> locker(_mutex);
+            CircularBufferPop(_bufferCircular, readBytes, nullptr);
+        }
+        return readBytes;
+    }
+
+private:
+    BenchmarkSettings _settings;
+    CircularBuffer _bufferCircular = nullptr;
+    std::vector<std::uint8_t> _bufferMessage;
+    std::mutex _mutex;
+};
+
+// Publisher buffer used now: lock-free SPSC ring buffer with in place claims
+class LockFreeRingBuffer
+{
+public:
+    LockFreeRingBuffer(const BenchmarkSettings &settings)
+        : _settings(settings),
+          _bufferRing(settings.bufferSize)
+    {
+    }
+
+    void publish(void *data, size_t size)
+    {
+        std::uint8_t *region;
+        while ((region = _bufferRing.claim(size)) == nullptr)
+            std::this_thread::yield();
+        std::memcpy(region, data, size);
+        _bufferRing.commit(size);
+    }
+
+    size_t consume()
+    {
+        const std::uint8_t *data = nullptr;
+        size_t readBytes = _bufferRing.read(data, _settings.messageSize);
+        if (readBytes > 0)
+            _bufferRing.release(readBytes);
+        return readBytes;
+    }
+
+private:
+    BenchmarkSettings _settings;
+    SPSCRingBuffer _bufferRing;
+};
+
+template <class TBuffer>
+void benchmark(const std::string &name, const BenchmarkSettings &settings)
+{
+    TBuffer buffer(settings);
+
+    std::vector<std::uint8_t> message(settings.size, 0);
+    std::vector<std::uint64_t> latencies(settings.messages);
+
+    // Consumer imitates publisher thread which passes buffered data to Aeron driver
+    size_t totalBytes = 0;
+    std::thread consumer([&]()
+    {
+        size_t expectedBytes = settings.messages * settings.size;
+        while (totalBytes < expectedBytes)
+        {
+            size_t readBytes = buffer.consume();
+            if (readBytes == 0)
+                std::this_thread::yield();
+            totalBytes += readBytes;
+        }
+    });
+
+    uint64_t timestamp_start = CppCommon::Timestamp::nano();
+    for (size_t i = 0; i < settings.messages; ++i)
+    {
+        uint64_t timestamp = CppCommon::Timestamp::nano();
+        buffer.publish(message.data(), message.size());
+        latencies[i] = CppCommon::Timestamp::nano() - timestamp;
+    }
+    consumer.join();
+    uint64_t timestamp_stop = CppCommon::Timestamp::nano();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double value)
+    {
+        size_t index = static_cast<size_t>(value * (latencies.size() - 1));
+        return CppBenchmark::ReporterConsole::GenerateTimePeriod(latencies[index]);
+    };
+
+    std::cout << name << std::endl;
+    std::cout << "Total time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
+    std::cout << "Total bytes: " << totalBytes << std::endl;
+    std::cout << "Publish latency p50: " << percentile(0.50) << std::endl;
+    std::cout << "Publish latency p99: " << percentile(0.99) << std::endl;
+    std::cout << "Publish latency p99.9: " << percentile(0.999) << std::endl;
+    std::cout << "Publish latency max: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(latencies.back()) << std::endl;
+    std::cout << std::endl;
+}
+
+BenchmarkSettings parseBenchmarkSettings(int argc, char **argv)
+{
+    BenchmarkSettings settings;
+
+    try
+    {
+        CommandOptionParser parser;
+
+        // Prepare command options parser
+        parser.addOption(CommandOption("benchmark.messages", 1, 1, "Count of messages to publish."));
+        parser.addOption(CommandOption("benchmark.size",     1, 1, "Size of each published message (in bytes)."));
+        parser.addOption(CommandOption("benchmark.buffer",   1, 1, "Size of buffer used to store cached data before sending to Aeron driver (in bytes)."));
+        parser.addOption(CommandOption("benchmark.message",  1, 1, "Maximal size of message allowed to send to Aeron driver (in bytes)."));
+
+        // Parse command arguments
+        parser.parse(argc, argv);
+
+        // Use specified options
+        settings.messages = static_cast<size_t>(parser.getOption("benchmark.messages").getParamAsInt(0, 1, INT32_MAX, static_cast<int>(settings.messages)));
+        settings.size = static_cast<size_t>(parser.getOption("benchmark.size").getParamAsInt(0, 1, 65535, static_cast<int>(settings.size)));
+        settings.bufferSize = static_cast<size_t>(parser.getOption("benchmark.buffer").getParamAsInt(0, 1024, INT32_MAX, static_cast<int>(settings.bufferSize)));
+        settings.messageSize = static_cast<size_t>(parser.getOption("benchmark.message").getParamAsInt(0, 128, INT32_MAX, static_cast<int>(settings.messageSize)));
+        settings.invalid = false;
+    }
+    catch (const aeron::util::SourcedException &e)
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl << std::endl;
+    }
+
+    return settings;
+}
+
+int main(int argc, char **argv)
+{
+    auto settings = parseBenchmarkSettings(argc, argv);
+    if (settings.invalid)
+        return -1;
+
+    std::cout << "Publishing " << settings.messages << " messages of " << settings.size << " bytes" << std::endl << std::endl;
+
+    benchmark<MutexCircularBuffer>("Mutex + circular buffer", settings);
+    benchmark<LockFreeRingBuffer>("Lock-free SPSC ring buffer", settings);
+
+    return 0;
+}
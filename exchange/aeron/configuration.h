@@ -1,6 +1,8 @@
 #ifndef TRADING_PLATFORM_AERON_CONFIGURATION_H
 #define TRADING_PLATFORM_AERON_CONFIGURATION_H
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace TradingPlatform {
@@ -10,7 +12,28 @@ const static std::string DEFAULT_CHANNEL = "aeron:udp?endpoint=localhost:40123";
 const static std::int32_t DEFAULT_STREAM_ID = 10;
 const static std::size_t DEFAULT_PUBLISHER_BUFFER_SIZE = 128 * 1024 * 1024;
 const static std::size_t DEFAULT_PUBLISHER_MESSAGE_SIZE = 256 * 1024;
+const static bool DEFAULT_PUBLISHER_BATCHING = true;
+const static bool DEFAULT_PUBLISHER_CLAIMING = false;
+const static std::chrono::microseconds DEFAULT_PUBLISHER_BATCH_DEADLINE = std::chrono::microseconds(50);
 const static int DEFAULT_FRAGMENT_COUNT_LIMIT = 1024;
+const static std::size_t DEFAULT_MARKET_PRICE_LADDER = 4096;
+const static std::size_t DEFAULT_MARKET_SHARDS = 1;
+const static std::size_t DEFAULT_MARKET_SHARD_QUEUE_SIZE = 16 * 1024 * 1024;
+const static std::size_t DEFAULT_JOURNAL_SEGMENT_SIZE = 64 * 1024 * 1024;
+const static std::uint64_t DEFAULT_MARKET_SNAPSHOT_INTERVAL = 0;   // Snapshots are disabled
+const static std::size_t DEFAULT_MARKET_BBO_CAPACITY = 65536;   // Symbols with greater IDs are not published
+const static std::size_t DEFAULT_MARKET_TOKEN_ROUTES = 1024 * 1024;   // Older order tokens are routed to all shards
+const static std::size_t DEFAULT_DEPTH_LEVELS = 10;
+const static std::chrono::microseconds DEFAULT_DEPTH_WINDOW = std::chrono::microseconds(100);
+const static std::chrono::milliseconds DEFAULT_DEPTH_REFRESH = std::chrono::milliseconds(1000);
+const static std::size_t DEFAULT_LOG_RING_SIZE = 4 * 1024 * 1024;
+const static std::size_t DEFAULT_LOG_FILE_SIZE = 256 * 1024 * 1024;
+const static std::size_t DEFAULT_LOG_FILES = 8;
+const static std::uint64_t DEFAULT_IDLE_SPINS = 100;
+const static std::uint64_t DEFAULT_IDLE_YIELDS = 10;
+const static std::chrono::microseconds DEFAULT_IDLE_PARK = std::chrono::microseconds(1000);
+const static std::size_t DEFAULT_GATEWAY_QUANTUM = 16;   // Commands of one session merged in a row
+const static std::size_t DEFAULT_GATEWAY_BUFFER_SIZE = 1024 * 1024;   // Responses kept for one slow session
 
 }}
 
@@ -0,0 +1,616 @@
+#ifndef TRADING_PLATFORM_AERON_GATEWAY_H
+#define TRADING_PLATFORM_AERON_GATEWAY_H
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Aeron.h"
+#include "util/Exceptions.h"
+
+#include "configuration.h"
+#include "journal.h"
+#include "logger.h"
+#include "market_shard.h"
+
+#include "trader/matching/fast_hash.h"
+#include "trader/matching/flat_hash_map.h"
+#include "trader/providers/nasdaq/ouch_handler.h"
+
+namespace TradingPlatform {
+namespace Aeron {
+
+
+struct GatewaySettings
+{
+    std::string directory;
+    std::string channel;
+    std::int32_t streamId = DEFAULT_STREAM_ID;
+    std::size_t quantum = DEFAULT_GATEWAY_QUANTUM;
+    std::size_t bufferSize = DEFAULT_GATEWAY_BUFFER_SIZE;
+    bool invalid = true;
+};
+
+
+/**
+ * Gateway session keeps the state of one OUCH client: reassembly context of
+ * frames split between fragments, commands received and not merged into the
+ * engine stream yet, and responses not sent to the client yet.
+ */
+class GatewaySession : public OUCH::OUCHHandler
+{
+    friend class Gateway;
+
+public:
+    struct Command
+    {
+        char type;
+        union
+        {
+            OUCH::EnterOrderMessage enter;
+            OUCH::ReplaceOrderMessage replace;
+            OUCH::CancelOrderMessage cancel;
+        };
+    };
+
+    GatewaySession(std::int32_t id, std::size_t slot)
+        : _id(id)
+        , _slot(slot)
+    {
+    }
+
+    std::int32_t id() const { return _id; }
+
+protected:
+    bool onMessage(const OUCH::EnterOrderMessage &message) override
+    {
+        Command command;
+        command.type = 'O';
+        command.enter = message;
+        _commands.push_back(command);
+        return true;
+    }
+
+    bool onMessage(const OUCH::ReplaceOrderMessage &message) override
+    {
+        Command command;
+        command.type = 'U';
+        command.replace = message;
+        _commands.push_back(command);
+        return true;
+    }
+
+    bool onMessage(const OUCH::CancelOrderMessage &message) override
+    {
+        Command command;
+        command.type = 'X';
+        command.cancel = message;
+        _commands.push_back(command);
+        return true;
+    }
+
+    bool onMessage(const OUCH::UnknownMessage &message) override
+    {
+        Logger::log(LogLevel::ERROR, "[GATE] Unknown message received in session ", _id, ": ", message.Type);
+        return true;
+    }
+
+private:
+    bool pending() const { return _next < _commands.size(); }
+
+    std::int32_t _id;
+    std::size_t _slot;
+    std::vector<Command> _commands;
+    std::size_t _next = 0;
+    bool _scheduled = false;
+    bool _closed = false;
+
+    std::int64_t _registration = 0;
+    std::shared_ptr<aeron::ExclusivePublication> _publication;
+    std::vector<std::uint8_t> _responses;
+    bool _flushing = false;
+};
+
+
+/**
+ * Order entry gateway merges OUCH commands of many client sessions into the
+ * sequenced engine stream and routes OUCH responses back to their sessions
+ * (OUCH subscriber thread only).
+ *
+ * Clients are identified by the Aeron session ID of their publications. Each
+ * session has its own OUCH reassembly context, so frames split between
+ * fragments of one client never mix with frames of the others. Fragments only
+ * queue decoded commands in their sessions. After each poll the gateway merges
+ * queued commands into the sharded market in rounds: every round takes up to
+ * the quantum of commands from each session in turn, so a busy session cannot
+ * delay the others. The sharded market assigns the global sequence number to
+ * every routed command.
+ *
+ * Shards publish OUCH responses into local publishers drained by the gateway.
+ * Every response is routed by its order token to the session which entered
+ * the order and offered to the session publication on the gateway channel
+ * tagged with the client session ID, so each client subscribes only to its
+ * own responses. Orders with tokens already in use, replace and cancel
+ * commands of orders entered by other sessions and commands of orders with a
+ * replace or cancel still in flight are rejected by the gateway.
+ *
+ * The gateway follows the leaves quantity of every order in its responses and
+ * forgets the token when the order is rejected, fully executed or canceled.
+ * Shards respond to a replace with the cancel of the existing order and the
+ * acceptance of the replacement one. If the existing order is done before the
+ * replace reaches the engine, the replacement token is rejected. Orders of
+ * restored market shards have no owner session, because session IDs do not
+ * survive restarts and OUCH sessions carry no other client identity: their
+ * tokens stay in use, replace and cancel commands of them are rejected and
+ * their responses are not routed.
+ *
+ * Responses are buffered while the session publication is not connected or
+ * back pressured, up to the buffer size per session. Sessions are closed at
+ * the end of their streams, responses of their orders are dropped.
+ */
+class Gateway
+{
+public:
+    // Size of big-endian length prefix of OUCH frames
+    static const size_t FRAME_HEADER_SIZE = 2;
+    // Order token offset in OUCH responses: type and timestamp come first
+    static const size_t TOKEN_OFFSET = 1 + sizeof(std::uint64_t);
+    // OUCH reject reason of commands refused by the gateway ('O' is other)
+    static const char REJECT_REASON = 'O';
+
+    Gateway(const GatewaySettings &settings, ShardedMarket &market)
+        : _settings(settings)
+        , _market(market)
+        , _sessions(1024, 0)
+        , _owners(1024 * 1024, 0)
+    {
+        try
+        {
+            if (!_settings.directory.empty())
+                _context.aeronDir(_settings.directory);
+
+            _aeron = aeron::Aeron::connect(_context);
+        }
+        catch (const aeron::SourcedException &e)
+        {
+            std::cerr << "FAILED: " << e.what() << " : " << e.where() << std::endl;
+            _failed = true;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "FAILED: " << e.what() << " : " << std::endl;
+            _failed = true;
+        }
+    }
+
+    Gateway(const Gateway &) = delete;
+    Gateway &operator=(const Gateway &) = delete;
+
+    bool isFailed() const { return _failed; }
+
+    /** Attaches the journal to commit it after every merge. */
+    void setJournal(Journal *journal) { _journal = journal; }
+
+    std::size_t sessions() const { return _sessions.size(); }
+    std::uint64_t unrouted() const { return _unrouted; }
+    std::uint64_t dropped() const { return _dropped; }
+
+    /**
+     * Keeps tokens of live orders of market shards restored from snapshots
+     * and the journal in use without owner sessions. Must be called before
+     * shards are started. Returns the count of restored orders.
+     */
+    std::size_t restore()
+    {
+        std::size_t count = 0;
+        for (std::size_t index = 0; index < _market.shards(); ++index)
+        {
+            for (const auto &order : _market.shard(index).market().orders())
+            {
+                Owner owner;
+                owner.restored = true;
+                owner.leaves = order.second->LeavesQuantity;
+                if (_owners.emplace(order.first, owner).second)
+                    ++count;
+            }
+        }
+        return count;
+    }
+
+    /** Queues commands of the fragment received in the given client session. */
+    bool onFragment(const std::uint8_t *data, std::size_t size, std::int32_t id)
+    {
+        GatewaySession &session = open(id);
+        bool result = session.Process(const_cast<std::uint8_t *>(data), size);
+        if (session.pending() && !session._scheduled)
+        {
+            session._scheduled = true;
+            _schedule.push_back(id);
+        }
+        return result;
+    }
+
+    /** Closes the client session after its queued commands are merged. */
+    void onEndOfStream(std::int32_t id)
+    {
+        GatewaySession *session = find(id);
+        if (session == nullptr)
+            return;
+        if (session->_scheduled)
+            session->_closed = true;
+        else
+            close(*session);
+    }
+
+    /** Merges queued commands into the engine stream and routes responses to sessions. Returns the amount of work done. */
+    int poll()
+    {
+        return merge() + respond();
+    }
+
+private:
+    // Token of no order, OUCH order tokens are 32-bit
+    static const std::uint64_t NO_TOKEN = std::numeric_limits<std::uint64_t>::max();
+
+    struct Owner
+    {
+        std::int32_t session = 0;
+        std::uint64_t leaves = 0;
+        std::uint64_t replacement = NO_TOKEN;   // Replacement token of the replace in flight
+        bool canceled = false;                  // Cancel is in flight
+        bool restored = false;                  // Order of restored market shards has no owner session
+    };
+
+    GatewaySession *find(std::int32_t id)
+    {
+        auto it = _sessions.find(static_cast<std::uint32_t>(id));
+        return (it != _sessions.end()) ? &(*_slots[it->second]) : nullptr;
+    }
+
+    GatewaySession &open(std::int32_t id)
+    {
+        GatewaySession *found = find(id);
+        if (found != nullptr)
+            return *found;
+
+        std::size_t slot = _slots.size();
+        if (!_free.empty())
+        {
+            slot = _free.back();
+            _free.pop_back();
+        }
+        else
+            _slots.emplace_back();
+
+        _slots[slot] = std::make_unique<GatewaySession>(id, slot);
+        _sessions.emplace(static_cast<std::uint32_t>(id), slot);
+
+        // Responses publication is found later, so the subscriber thread does not wait for it
+        const char separator = (_settings.channel.find('?') == std::string::npos) ? '?' : '|';
+        _slots[slot]->_registration = _aeron->addExclusivePublication(_settings.channel + separator + "session-id=" + std::to_string(id), _settings.streamId);
+
+        Logger::log(LogLevel::INFO, "[GATE] Session ", id, " is opened");
+        return *_slots[slot];
+    }
+
+    void close(GatewaySession &session)
+    {
+        Logger::log(LogLevel::INFO, "[GATE] Session ", session.id(), " is closed");
+        _sessions.erase(static_cast<std::uint32_t>(session.id()));
+        _free.push_back(session._slot);
+        _slots[session._slot].reset();
+    }
+
+    int merge()
+    {
+        if (_schedule.empty())
+            return 0;
+
+        while (!_schedule.empty())
+        {
+            std::size_t count = 0;
+            for (std::int32_t id : _schedule)
+            {
+                GatewaySession &session = *find(id);
+                for (std::size_t i = 0; (i < _settings.quantum) && session.pending(); ++i)
+                    route(session, session._commands[session._next++]);
+
+                if (session.pending())
+                    _schedule[count++] = id;
+                else
+                {
+                    session._commands.clear();
+                    session._next = 0;
+                    session._scheduled = false;
+                    if (session._closed)
+                        close(session);
+                }
+            }
+            _schedule.resize(count);
+        }
+
+        // Group commit of all journal records of the merge
+        if (_journal)
+            _journal->commit();
+        return 1;
+    }
+
+    void route(GatewaySession &session, const GatewaySession::Command &command)
+    {
+        bool routed = false;
+        switch (command.type)
+        {
+            case 'O':
+                if (!own(command.enter.OrderToken, session))
+                {
+                    reject(session, command.enter.OrderToken);
+                    break;
+                }
+                routed = _market.route(command.enter);
+                break;
+            case 'U':
+                if ((owned(command.replace.ExistingOrderToken, session) == nullptr) || !own(command.replace.ReplacementOrderToken, session))
+                {
+                    reject(session, command.replace.ReplacementOrderToken);
+                    break;
+                }
+                // Owned order is found again, because the new token could move it
+                owned(command.replace.ExistingOrderToken, session)->replacement = command.replace.ReplacementOrderToken;
+                routed = _market.route(command.replace);
+                break;
+            case 'X':
+            {
+                Owner *owner = owned(command.cancel.OrderToken, session);
+                if (owner == nullptr)
+                {
+                    reject(session, command.cancel.OrderToken);
+                    break;
+                }
+                owner->canceled = true;
+                routed = _market.route(command.cancel);
+                break;
+            }
+            default:
+                break;
+        }
+
+        Logger::log(LogLevel::DEBUG, "[GATE] Command ", command.type, " of session ", session.id(),
+            (routed ? " is routed with sequence " : " is not routed after sequence "), _market.sequence());
+    }
+
+    // Find the order of the session without a replace or cancel in flight, restored orders belong to no session
+    Owner *owned(std::uint64_t token, const GatewaySession &session)
+    {
+        auto it = _owners.find(token);
+        if ((it == _owners.end()) || it->second.restored || it->second.canceled || (it->second.replacement != NO_TOKEN))
+            return nullptr;
+
+        return (it->second.session == session.id()) ? &it->second : nullptr;
+    }
+
+    // Assign the new order token to the session, tokens of live orders are never reused
+    bool own(std::uint64_t token, const GatewaySession &session)
+    {
+        Owner owner;
+        owner.session = session.id();
+        return _owners.emplace(token, owner).second;
+    }
+
+    // Forget the token of the done order, its replace in flight failed in the engine unless the order was canceled by it
+    void finish(std::uint64_t token, bool replaced)
+    {
+        for (;;)
+        {
+            auto it = _owners.find(token);
+            if (it == _owners.end())
+                return;
+
+            const std::uint64_t replacement = it->second.replacement;
+            _owners.erase(it);
+            _market.forget(token);
+            if (replaced || (replacement == NO_TOKEN))
+                return;
+
+            it = _owners.find(replacement);
+            if (it == _owners.end())
+                return;
+            GatewaySession *session = it->second.restored ? nullptr : find(it->second.session);
+            if (session != nullptr)
+                reject(*session, static_cast<std::uint32_t>(replacement));
+
+            // Replacement could have its own replace in flight
+            token = replacement;
+        }
+    }
+
+    void reject(GatewaySession &session, std::uint32_t token)
+    {
+        OUCH::OrderRejectedMessage rejected = {};
+        rejected.Type = 'J';
+        rejected.Timestamp = L2ex::Timestamp::nanosecondsSinceMidnight();
+        rejected.OrderToken = token;
+        rejected.Reason = REJECT_REASON;
+
+        std::uint8_t frame[FRAME_HEADER_SIZE + OUCH::OrderRejectedMessage::SIZE];
+        Publisher::serializeFrame(frame, rejected);
+        respond(session, frame, sizeof(frame));
+    }
+
+    int respond()
+    {
+        int work = 0;
+        for (std::size_t index = 0; index < _market.shards(); ++index)
+        {
+            Publisher &responses = _market.shard(index).responses();
+            const std::uint8_t *data = nullptr;
+            const std::size_t size = responses.read(data);
+            if (size == 0)
+                continue;
+
+            std::size_t position = 0;
+            while (position + FRAME_HEADER_SIZE <= size)
+            {
+                const std::size_t frame = FRAME_HEADER_SIZE + ((static_cast<std::size_t>(data[position]) << 8) | data[position + 1]);
+                if (frame >= FRAME_HEADER_SIZE + TOKEN_OFFSET + sizeof(std::uint32_t))
+                    dispatch(data + position, frame);
+                position += frame;
+            }
+
+            responses.release(size);
+            ++work;
+        }
+
+        // Offer buffered responses, sessions not sent completely are retried after the next poll
+        std::size_t count = 0;
+        for (std::int32_t id : _flush)
+        {
+            GatewaySession *session = find(id);
+            if (session == nullptr)
+                continue;
+            if (flush(*session))
+                session->_flushing = false;
+            else
+                _flush[count++] = id;
+        }
+        _flush.resize(count);
+
+        return work;
+    }
+
+    // Route the response frame to the session of its order token and follow the leaves quantity of the order
+    void dispatch(const std::uint8_t *frame, std::size_t size)
+    {
+        std::uint8_t *message = const_cast<std::uint8_t *>(frame) + FRAME_HEADER_SIZE;
+        const std::uint32_t token = readToken(message + TOKEN_OFFSET);
+        auto it = _owners.find(token);
+        if (it == _owners.end())
+        {
+            ++_unrouted;
+            return;
+        }
+
+        GatewaySession *session = it->second.restored ? nullptr : find(it->second.session);
+        if (session != nullptr)
+            respond(*session, frame, size);
+        else
+            ++_unrouted;
+
+        switch (message[0])
+        {
+            case 'A':
+            {
+                OUCH::OrderAcceptedMessage accepted;
+                if (accepted.deserialize(message, size - FRAME_HEADER_SIZE))
+                    it->second.leaves = accepted.Shares;
+                break;
+            }
+            case 'E':
+            {
+                OUCH::OrderExecutedMessage executed;
+                if (!executed.deserialize(message, size - FRAME_HEADER_SIZE))
+                    break;
+                it->second.leaves -= std::min(it->second.leaves, executed.ExecutedShares);
+                if (it->second.leaves == 0)
+                    finish(token, false);
+                break;
+            }
+            case 'C':
+            {
+                // Remaining quantity of market orders is canceled immediately, their replace always fails
+                OUCH::OrderCanceledMessage canceled;
+                const bool immediate = !canceled.deserialize(message, size - FRAME_HEADER_SIZE) || (canceled.Reason == 'I');
+                finish(token, !immediate);
+                break;
+            }
+            case 'J':
+                finish(token, false);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void respond(GatewaySession &session, const std::uint8_t *frame, std::size_t size)
+    {
+        if (session._responses.size() + size > _settings.bufferSize)
+        {
+            ++_dropped;
+            return;
+        }
+        session._responses.insert(session._responses.end(), frame, frame + size);
+        if (!session._flushing)
+        {
+            session._flushing = true;
+            _flush.push_back(session.id());
+        }
+    }
+
+    // Offer whole frames of buffered responses packed up to the publication payload length
+    bool flush(GatewaySession &session)
+    {
+        if (!session._publication)
+        {
+            session._publication = _aeron->findExclusivePublication(session._registration);
+            if (!session._publication)
+                return false;
+        }
+
+        const std::size_t limit = static_cast<std::size_t>(session._publication->maxPayloadLength());
+        aeron::AtomicBuffer buffer(session._responses.data(), session._responses.size());
+        std::size_t sent = 0;
+        while (sent < session._responses.size())
+        {
+            std::size_t batch = 0;
+            while (sent + batch + FRAME_HEADER_SIZE <= session._responses.size())
+            {
+                const std::uint8_t *frame = session._responses.data() + sent + batch;
+                const std::size_t size = FRAME_HEADER_SIZE + ((static_cast<std::size_t>(frame[0]) << 8) | frame[1]);
+                if ((batch > 0) && (batch + size > limit))
+                    break;
+                batch += size;
+            }
+
+            if (session._publication->offer(buffer, static_cast<aeron::index_t>(sent), static_cast<aeron::index_t>(batch)) < 0)
+                break;
+            sent += batch;
+        }
+
+        session._responses.erase(session._responses.begin(), session._responses.begin() + sent);
+        return session._responses.empty();
+    }
+
+    static std::uint32_t readToken(const std::uint8_t *data)
+    {
+        return (static_cast<std::uint32_t>(data[0]) << 24) | (static_cast<std::uint32_t>(data[1]) << 16) | (static_cast<std::uint32_t>(data[2]) << 8) | data[3];
+    }
+
+    typedef Matching::FlatHashMap<uint64_t, std::size_t, Matching::FastHash> Sessions;
+    typedef Matching::FlatHashMap<uint64_t, Owner, Matching::FastHash> Owners;
+
+    GatewaySettings _settings;
+    ShardedMarket &_market;
+    Journal *_journal = nullptr;
+
+    aeron::Context _context;
+    std::shared_ptr<aeron::Aeron> _aeron;
+
+    Sessions _sessions;
+    std::vector<std::unique_ptr<GatewaySession>> _slots;
+    std::vector<std::size_t> _free;
+    std::vector<std::int32_t> _schedule;
+    std::vector<std::int32_t> _flush;
+    Owners _owners;
+
+    std::uint64_t _unrouted = 0;
+    std::uint64_t _dropped = 0;
+
+    bool _failed = false;
+};
+
+
+}}
+
+#endif // TRADING_PLATFORM_AERON_GATEWAY_H
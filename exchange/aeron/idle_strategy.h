@@ -0,0 +1,149 @@
+#ifndef TRADING_PLATFORM_AERON_IDLE_STRATEGY_H
+#define TRADING_PLATFORM_AERON_IDLE_STRATEGY_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "configuration.h"
+
+namespace TradingPlatform {
+namespace Aeron {
+
+
+enum class IdleStrategyType
+{
+    BUSY_SPIN,      // Spin with the CPU pause hint, lowest latency and a whole core burnt
+    SPIN_YIELD,     // Spin for a while, then yield the core to other threads
+    BACKOFF,        // Spin, yield, then sleep with exponentially growing periods
+    SLEEPING        // Sleep for the fixed period, lowest CPU usage
+};
+
+
+struct IdleSettings
+{
+    IdleStrategyType type = IdleStrategyType::SPIN_YIELD;
+    std::uint64_t spins = DEFAULT_IDLE_SPINS;
+    std::uint64_t yields = DEFAULT_IDLE_YIELDS;
+    std::chrono::microseconds park = DEFAULT_IDLE_PARK;
+};
+
+
+/** Parses the idle strategy name: spin, yield, backoff or sleep. Returns false for unknown names. */
+inline bool parseIdleStrategyType(const std::string &name, IdleStrategyType &type)
+{
+    if (name == "spin")
+        type = IdleStrategyType::BUSY_SPIN;
+    else if (name == "yield")
+        type = IdleStrategyType::SPIN_YIELD;
+    else if (name == "backoff")
+        type = IdleStrategyType::BACKOFF;
+    else if (name == "sleep")
+        type = IdleStrategyType::SLEEPING;
+    else
+        return false;
+    return true;
+}
+
+
+/**
+ * Idle strategy of polling threads selected at runtime.
+ *
+ * Polling loops call idle() after each iteration with the amount of work done.
+ * Any work resets the strategy, so the thread backs off only while it stays
+ * idle. Spin-then-yield spins the given count of iterations before yielding.
+ * Backoff spins and yields the same way, then sleeps for periods doubled from
+ * 1 microsecond up to the park period. Sleeping strategy always sleeps for the
+ * park period.
+ *
+ * Strategy keeps the state of one polling loop and must not be shared between
+ * threads.
+ */
+class IdleStrategy
+{
+public:
+    explicit IdleStrategy(const IdleSettings &settings = IdleSettings())
+        : _settings(settings)
+    {
+    }
+
+    void idle(int workCount)
+    {
+        if (workCount > 0)
+            reset();
+        else
+            idle();
+    }
+
+    void idle()
+    {
+        switch (_settings.type)
+        {
+            case IdleStrategyType::BUSY_SPIN:
+                pause();
+                break;
+            case IdleStrategyType::SPIN_YIELD:
+                if (_spins < _settings.spins)
+                {
+                    ++_spins;
+                    pause();
+                }
+                else
+                    std::this_thread::yield();
+                break;
+            case IdleStrategyType::BACKOFF:
+                if (_spins < _settings.spins)
+                {
+                    ++_spins;
+                    pause();
+                }
+                else if (_yields < _settings.yields)
+                {
+                    ++_yields;
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    std::this_thread::sleep_for(_park);
+                    _park = std::min(_park * 2, std::chrono::microseconds(std::max<std::int64_t>(_settings.park.count(), 1)));
+                }
+                break;
+            case IdleStrategyType::SLEEPING:
+                std::this_thread::sleep_for(_settings.park);
+                break;
+        }
+    }
+
+    void reset()
+    {
+        _spins = 0;
+        _yields = 0;
+        _park = std::chrono::microseconds(1);
+    }
+
+    const IdleSettings &settings() const { return _settings; }
+
+private:
+    static void pause()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+
+    IdleSettings _settings;
+    std::uint64_t _spins = 0;
+    std::uint64_t _yields = 0;
+    std::chrono::microseconds _park{1};
+};
+
+
+}}
+
+#endif // TRADING_PLATFORM_AERON_IDLE_STRATEGY_H
@@ -0,0 +1,353 @@
+#ifndef TRADING_PLATFORM_AERON_JOURNAL_H
+#define TRADING_PLATFORM_AERON_JOURNAL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "configuration.h"
+
+namespace TradingPlatform {
+namespace Aeron {
+
+
+enum class JournalFsync
+{
+    NEVER,      // Leave flushing to the OS page cache
+    BATCH,      // Sync written records once per commit() (group commit)
+    ALWAYS,     // Sync every record before it is routed
+};
+
+
+struct JournalSettings
+{
+    std::string directory;
+    std::size_t segmentSize = DEFAULT_JOURNAL_SEGMENT_SIZE;
+    JournalFsync fsync = JournalFsync::BATCH;
+    bool invalid = true;
+};
+
+
+/** Journal record header followed by the length-prefixed OUCH frame. */
+struct JournalRecord
+{
+    std::uint64_t sequence;
+    std::uint64_t timestamp;
+    std::uint32_t size;
+    std::uint32_t reserved;
+};
+
+
+/**
+ * Append-only binary journal of inbound OUCH messages.
+ *
+ * Records are appended into memory-mapped segment files of the fixed size
+ * named journal-NNNNNNNN.dat. Each record has a sequence number, a wall clock
+ * timestamp in nanoseconds and the length-prefixed OUCH frame, so replay can
+ * pass frames straight into OUCHHandler::Process(). Records are 8 bytes aligned
+ * and the record size is written last, so a zero size marks the end of the
+ * segment data or a record torn by a crash.
+ *
+ * Durability is controlled with the fsync policy: NEVER leaves flushing to the
+ * OS, BATCH syncs all records appended since the previous commit() call (group
+ * commit), ALWAYS syncs every record in append().
+ *
+ * Opening the journal scans the last segment to continue the sequence after the
+ * last complete record. The last segment could be rolled just before a crash and
+ * have no records, then older segments are scanned back to the newest record.
+ * Not thread-safe: a single thread appends records.
+ */
+class Journal
+{
+public:
+    static const size_t FRAME_HEADER_SIZE = 2;
+    static const size_t RECORD_ALIGNMENT = 8;
+
+    using ReplayHandler = std::function<void(const JournalRecord &record, std::uint8_t *frame)>;
+
+    Journal(const JournalSettings &settings)
+        : _settings(settings)
+    {
+        _pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        _settings.segmentSize = (std::max(_settings.segmentSize, _pageSize) + _pageSize - 1) / _pageSize * _pageSize;
+
+        ::mkdir(_settings.directory.c_str(), 0755);
+        _segments = listSegments();
+
+        if (_segments.empty())
+        {
+            _failed = !openSegment(0);
+            return;
+        }
+
+        // Continue after the last complete record of the last segment
+        _failed = !openSegment(_segments.back());
+        if (_failed)
+            return;
+        while (true)
+        {
+            const JournalRecord *record = recordAt(_data, _position);
+            if (record == nullptr)
+                break;
+            _sequence = record->sequence;
+            _position += recordSize(record->size);
+        }
+        _synced = _position;
+
+        // Continue after the newest record of older segments if the last one is empty
+        for (auto it = _segments.rbegin() + 1; (_position == 0) && (it != _segments.rend()); ++it)
+        {
+            replaySegment(*it, [this](const JournalRecord &record, std::uint8_t *) { _sequence = record.sequence; });
+            if (_sequence > 0)
+                break;
+        }
+    }
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    ~Journal()
+    {
+        closeSegment();
+    }
+
+    bool isFailed() const { return _failed; }
+
+    /** Sequence number of the last appended record. */
+    std::uint64_t sequence() const { return _sequence; }
+
+    /**
+     * Appends the given OUCH message as a new record.
+     * Returns the record sequence number or 0 if the record was not written.
+     */
+    template <class TMessage>
+    std::uint64_t append(const TMessage &message)
+    {
+        const size_t frameSize = FRAME_HEADER_SIZE + TMessage::SIZE;
+        const size_t size = recordSize(frameSize);
+
+        if (_data == nullptr)
+            return 0;
+        if ((_position + size > _settings.segmentSize) && !rollSegment())
+            return 0;
+
+        auto record = reinterpret_cast<JournalRecord *>(_data + _position);
+        std::uint8_t *frame = _data + _position + sizeof(JournalRecord);
+        frame[0] = static_cast<std::uint8_t>(TMessage::SIZE >> 8);
+        frame[1] = static_cast<std::uint8_t>(TMessage::SIZE & 0xFF);
+        message.serialize(frame + FRAME_HEADER_SIZE, TMessage::SIZE);
+        record->sequence = ++_sequence;
+        record->timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        record->reserved = 0;
+
+        // Record size is written last and marks the record as complete
+        __atomic_store_n(&record->size, static_cast<std::uint32_t>(frameSize), __ATOMIC_RELEASE);
+        _position += size;
+
+        if (_settings.fsync == JournalFsync::ALWAYS)
+            sync();
+
+        return _sequence;
+    }
+
+    /** Group commit: syncs all records appended since the previous commit with the BATCH fsync policy. */
+    void commit()
+    {
+        if (_settings.fsync == JournalFsync::BATCH)
+            sync();
+    }
+
+    /**
+     * Replays all complete records of all segments in the sequence order.
+     * Each segment is mapped read-only and records are passed in place.
+     * Returns the count of replayed records.
+     */
+    std::uint64_t replay(const ReplayHandler &handler) const
+    {
+        std::uint64_t count = 0;
+        for (auto segment : _segments)
+            count += replaySegment(segment, handler);
+        return count;
+    }
+
+private:
+    std::uint64_t replaySegment(size_t segment, const ReplayHandler &handler) const
+    {
+        int file = ::open(segmentPath(segment).c_str(), O_RDONLY);
+        if (file < 0)
+            return 0;
+
+        struct stat info;
+        if ((::fstat(file, &info) != 0) || (info.st_size == 0))
+        {
+            ::close(file);
+            return 0;
+        }
+
+        const size_t size = static_cast<size_t>(info.st_size);
+        void *mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if (mapped == MAP_FAILED)
+        {
+            std::cerr << "[ERROR] Failed to map journal segment " << segmentPath(segment) << std::endl;
+            return 0;
+        }
+        ::madvise(mapped, size, MADV_SEQUENTIAL);
+
+        std::uint64_t count = 0;
+        auto data = static_cast<std::uint8_t *>(mapped);
+        size_t position = 0;
+        while (position + sizeof(JournalRecord) <= size)
+        {
+            const JournalRecord *record = recordAt(data, position, size);
+            if (record == nullptr)
+                break;
+            handler(*record, data + position + sizeof(JournalRecord));
+            position += recordSize(record->size);
+            ++count;
+        }
+
+        ::munmap(mapped, size);
+        return count;
+    }
+
+    static size_t recordSize(size_t frameSize)
+    {
+        return (sizeof(JournalRecord) + frameSize + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    }
+
+    const JournalRecord *recordAt(const std::uint8_t *data, size_t position) const
+    {
+        return recordAt(data, position, _settings.segmentSize);
+    }
+
+    static const JournalRecord *recordAt(const std::uint8_t *data, size_t position, size_t size)
+    {
+        if (position + sizeof(JournalRecord) > size)
+            return nullptr;
+        auto record = reinterpret_cast<const JournalRecord *>(data + position);
+        const std::uint32_t frameSize = __atomic_load_n(&record->size, __ATOMIC_ACQUIRE);
+        if ((frameSize <= FRAME_HEADER_SIZE) || (position + recordSize(frameSize) > size))
+            return nullptr;
+        return record;
+    }
+
+    std::string segmentPath(size_t segment) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "journal-%08zu.dat", segment);
+        return _settings.directory + "/" + name;
+    }
+
+    std::vector<size_t> listSegments() const
+    {
+        std::vector<size_t> segments;
+        DIR *dir = ::opendir(_settings.directory.c_str());
+        if (dir == nullptr)
+            return segments;
+        while (struct dirent *entry = ::readdir(dir))
+        {
+            // Match the whole name, so temporary and backup files are skipped
+            size_t segment;
+            int length = 0;
+            if ((std::sscanf(entry->d_name, "journal-%zu.dat%n", &segment, &length) == 1) && (length > 0) && (entry->d_name[length] == '\0'))
+                segments.push_back(segment);
+        }
+        ::closedir(dir);
+        std::sort(segments.begin(), segments.end());
+        return segments;
+    }
+
+    bool openSegment(size_t segment)
+    {
+        const std::string path = segmentPath(segment);
+        int file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (file < 0)
+        {
+            std::cerr << "[ERROR] Failed to open journal segment " << path << std::endl;
+            return false;
+        }
+
+        struct stat info;
+        if ((::fstat(file, &info) != 0) || ((static_cast<size_t>(info.st_size) < _settings.segmentSize) && (::ftruncate(file, static_cast<off_t>(_settings.segmentSize)) != 0)))
+        {
+            std::cerr << "[ERROR] Failed to allocate journal segment " << path << std::endl;
+            ::close(file);
+            return false;
+        }
+
+        void *mapped = ::mmap(nullptr, _settings.segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        ::close(file);
+        if (mapped == MAP_FAILED)
+        {
+            std::cerr << "[ERROR] Failed to map journal segment " << path << std::endl;
+            return false;
+        }
+
+        if (_segments.empty() || (_segments.back() != segment))
+            _segments.push_back(segment);
+        _data = static_cast<std::uint8_t *>(mapped);
+        _position = 0;
+        _synced = 0;
+        return true;
+    }
+
+    void closeSegment()
+    {
+        if (_data == nullptr)
+            return;
+        if (_settings.fsync != JournalFsync::NEVER)
+            sync();
+        ::munmap(_data, _settings.segmentSize);
+        _data = nullptr;
+    }
+
+    bool rollSegment()
+    {
+        closeSegment();
+        if (!openSegment(_segments.back() + 1))
+        {
+            _failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    void sync()
+    {
+        if (_synced == _position)
+            return;
+        const size_t from = _synced / _pageSize * _pageSize;
+        ::msync(_data + from, _position - from, MS_SYNC);
+        _synced = _position;
+    }
+
+private:
+    JournalSettings _settings;
+    size_t _pageSize;
+    std::vector<size_t> _segments;
+
+    std::uint8_t *_data = nullptr;
+    size_t _position = 0;
+    size_t _synced = 0;
+    std::uint64_t _sequence = 0;
+
+    bool _failed = false;
+};
+
+
+}}
+
+#endif // TRADING_PLATFORM_AERON_JOURNAL_H
@@ -0,0 +1,373 @@
+#ifndef TRADING_PLATFORM_AERON_LOGGER_H
+#define TRADING_PLATFORM_AERON_LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "configuration.h"
+#include "spsc_ring_buffer.h"
+#include "thread.h"
+
+namespace TradingPlatform {
+namespace Aeron {
+
+
+enum class LogLevel : std::uint8_t
+{
+    NONE,
+    ERROR,
+    INFO,
+    DEBUG,
+};
+
+
+struct LoggerSettings
+{
+    std::string file;                                   // Log to stdout if not specified
+    std::size_t fileSize = DEFAULT_LOG_FILE_SIZE;
+    std::size_t files = DEFAULT_LOG_FILES;
+    std::size_t ringSize = DEFAULT_LOG_RING_SIZE;
+    LogLevel level = LogLevel::INFO;
+    bool invalid = true;
+};
+
+
+/** Type of the stored log record argument: string literals are stored as pointers. */
+template <class T>
+struct LogType
+{
+    using type = typename std::conditional<std::is_array<T>::value, const typename std::remove_extent<T>::type *, typename std::decay<T>::type>::type;
+};
+
+
+/**
+ * Binary encoding of a log record argument.
+ *
+ * Trivially copyable values (orders, levels, symbols, numbers, string literal
+ * pointers) are copied as is. Messages with the wire SIZE are stored in their
+ * more compact wire format and deserialized back when the record is formatted.
+ */
+template <class T, class Enable = void>
+struct LogArgument
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Log argument must be trivially copyable or serializable!");
+
+    static constexpr std::size_t SIZE = sizeof(T);
+
+    static void write(std::uint8_t *buffer, const T &value) { std::memcpy(buffer, &value, SIZE); }
+
+    static void print(std::ostream &stream, const std::uint8_t *buffer)
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type value;
+        std::memcpy(&value, buffer, SIZE);
+        stream << *reinterpret_cast<const T *>(&value);
+    }
+};
+
+template <class T>
+struct LogArgument<T, typename std::enable_if<(T::SIZE > 0)>::type>
+{
+    static constexpr std::size_t SIZE = T::SIZE;
+
+    static void write(std::uint8_t *buffer, const T &value) { value.serialize(buffer, SIZE); }
+
+    static void print(std::ostream &stream, const std::uint8_t *buffer)
+    {
+        T value = {};
+        value.deserialize(const_cast<std::uint8_t *>(buffer), SIZE);
+        stream << value;
+    }
+};
+
+
+/**
+ * Asynchronous binary logger.
+ *
+ * Hot path threads do not format anything: log() checks the runtime log level
+ * with a single relaxed load, then copies the record arguments in the binary
+ * form into the lock-free ring of the calling thread together with the pointer
+ * to the formatting function instantiated for the argument types. When the ring
+ * is full the record is dropped and counted instead of blocking the caller.
+ *
+ * The background thread drains all thread rings, formats records with their
+ * operator<< and writes them into the log file, which is rotated by size into
+ * file.1 ... file.N. String arguments must be string literals, because only the
+ * pointer is stored.
+ *
+ * Records are not logged until the logger is started.
+ */
+class Logger
+{
+public:
+    using Formatter = void (*)(std::ostream &stream, const std::uint8_t *data);
+
+    static Logger &instance()
+    {
+        static Logger logger;
+        return logger;
+    }
+
+    static bool enabled(LogLevel level)
+    {
+        return static_cast<std::uint8_t>(level) <= instance()._level.load(std::memory_order_relaxed);
+    }
+
+    /** Changes the log level at runtime. */
+    static void setLevel(LogLevel level)
+    {
+        instance()._level.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    /** Writes the log record with the given arguments into the ring of the calling thread. */
+    template <class... Args>
+    static void log(LogLevel level, const Args &...args)
+    {
+        if (!enabled(level))
+            return;
+
+        Ring &ring = instance().ring();
+        const std::size_t size = align(sizeof(Record) + sum({ std::size_t(0), LogArgument<typename LogType<Args>::type>::SIZE... }));
+        std::uint8_t *region = ring.buffer.claim(size);
+        if (region == nullptr)
+        {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto record = reinterpret_cast<Record *>(region);
+        record->timestamp = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+        record->formatter = &format<typename LogType<Args>::type...>;
+        record->size = static_cast<std::uint32_t>(size);
+        record->level = level;
+        write(region + sizeof(Record), args...);
+        ring.buffer.commit(size);
+    }
+
+    /** Opens the log file and starts the background thread. */
+    bool start(const LoggerSettings &settings)
+    {
+        stop();
+
+        _settings = settings;
+        if (!open())
+            return false;
+
+        _running = true;
+        _thread = std::make_unique<Thread>(&Logger::loop, this);
+        _thread->setName("logger");
+        _level.store(static_cast<std::uint8_t>(settings.level), std::memory_order_relaxed);
+        return true;
+    }
+
+    /** Stops logging, drains all rings and closes the log file. */
+    void stop()
+    {
+        _level.store(static_cast<std::uint8_t>(LogLevel::NONE), std::memory_order_relaxed);
+        _running = false;
+        if (_thread && _thread->joinable())
+            _thread->join();
+        _thread.reset();
+        _file.close();
+    }
+
+private:
+    struct Record
+    {
+        std::uint64_t timestamp;
+        Formatter formatter;
+        std::uint32_t size;
+        LogLevel level;
+    };
+
+    struct Ring
+    {
+        explicit Ring(std::size_t size) : buffer(size) {}
+
+        SPSCRingBuffer buffer;
+        std::atomic<std::uint64_t> dropped{0};
+        std::uint64_t reported = 0;
+    };
+
+    Logger() = default;
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+    ~Logger()
+    {
+        stop();
+    }
+
+    static constexpr std::size_t align(std::size_t size) { return (size + 7) & ~static_cast<std::size_t>(7); }
+
+    static constexpr std::size_t sum(std::initializer_list<std::size_t> sizes)
+    {
+        std::size_t result = 0;
+        for (auto size : sizes)
+            result += size;
+        return result;
+    }
+
+    static void write(std::uint8_t *) {}
+
+    template <class T, class... Args>
+    static void write(std::uint8_t *buffer, const T &value, const Args &...args)
+    {
+        using Argument = LogArgument<typename LogType<T>::type>;
+        Argument::write(buffer, value);
+        write(buffer + Argument::SIZE, args...);
+    }
+
+    template <class... Args>
+    static void format(std::ostream &stream, const std::uint8_t *data)
+    {
+        (void)data;
+        (void)std::initializer_list<int>{ (LogArgument<Args>::print(stream, data), data += LogArgument<Args>::SIZE, 0)... };
+    }
+
+    // Ring of the calling thread, registered once per thread
+    Ring &ring()
+    {
+        static thread_local std::shared_ptr<Ring> ring;
+        if (!ring)
+        {
+            ring = std::make_shared<Ring>(_settings.ringSize);
+            std::lock_guard<std::mutex> lock(_mutex);
+            _rings.push_back(ring);
+        }
+        return *ring;
+    }
+
+    void loop()
+    {
+        while (true)
+        {
+            // Take the running flag before draining, so records logged before stop() are written
+            const bool running = _running;
+            if (!drain() && running)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (!running)
+                break;
+        }
+        output().flush();
+    }
+
+    // Format all records of all rings. Returns false if there was nothing to write.
+    bool drain()
+    {
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            rings = _rings;
+        }
+
+        bool written = false;
+        for (auto &ring : rings)
+        {
+            const std::uint8_t *data = nullptr;
+            std::size_t size;
+            while ((size = ring->buffer.read(data)) > 0)
+            {
+                std::size_t position = 0;
+                while (position < size)
+                {
+                    auto record = reinterpret_cast<const Record *>(data + position);
+                    print(*record, data + position + sizeof(Record));
+                    position += record->size;
+                }
+                ring->buffer.release(size);
+                written = true;
+            }
+
+            const std::uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+            if (dropped != ring->reported)
+            {
+                output() << "[LOG] Dropped " << (dropped - ring->reported) << " records because of the full ring" << std::endl;
+                ring->reported = dropped;
+            }
+        }
+
+        if (written)
+        {
+            output().flush();
+            rotate();
+        }
+        return written;
+    }
+
+    void print(const Record &record, const std::uint8_t *data)
+    {
+        static const char *levels[] = { "", "ERROR", "INFO", "DEBUG" };
+
+        time_t seconds = static_cast<time_t>(record.timestamp / 1000000000);
+        struct tm date;
+        ::localtime_r(&seconds, &date);
+        char time[40];
+        std::snprintf(time, sizeof(time), "%02d:%02d:%02d.%09llu %-5s ", date.tm_hour, date.tm_min, date.tm_sec, static_cast<unsigned long long>(record.timestamp % 1000000000), levels[static_cast<std::uint8_t>(record.level)]);
+
+        std::ostream &stream = output();
+        stream << time;
+        record.formatter(stream, data);
+        stream << '\n';
+    }
+
+    std::ostream &output()
+    {
+        return _file.is_open() ? static_cast<std::ostream &>(_file) : std::cout;
+    }
+
+    bool open()
+    {
+        if (_settings.file.empty())
+            return true;
+        _file.open(_settings.file, std::ios::out | std::ios::app);
+        if (!_file.is_open())
+        {
+            std::cerr << "[ERROR] Failed to open log file " << _settings.file << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void rotate()
+    {
+        if (!_file.is_open() || (static_cast<std::size_t>(_file.tellp()) < _settings.fileSize))
+            return;
+
+        _file.close();
+        for (std::size_t index = _settings.files; index > 1; --index)
+            std::rename((_settings.file + "." + std::to_string(index - 1)).c_str(), (_settings.file + "." + std::to_string(index)).c_str());
+        if (_settings.files > 0)
+            std::rename(_settings.file.c_str(), (_settings.file + ".1").c_str());
+        else
+            std::remove(_settings.file.c_str());
+        open();
+    }
+
+private:
+    LoggerSettings _settings;
+    std::atomic<std::uint8_t> _level{static_cast<std::uint8_t>(LogLevel::NONE)};
+
+    std::mutex _mutex;
+    std::vector<std::shared_ptr<Ring>> _rings;
+
+    std::ofstream _file;
+    std::unique_ptr<Thread> _thread;
+    std::atomic<bool> _running{false};
+};
+
+
+}}
+
+#endif // TRADING_PLATFORM_AERON_LOGGER_H
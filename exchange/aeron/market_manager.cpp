@@ -1,36 +1,40 @@
 #include <csignal>
 
 #include "command_option_parser.h"
-#include "publisher.h"
+#include "gateway.h"
+#include "logger.h"
+#include "market_shard.h"
 #include "subscriber.h"
 
-#include "trader/l2ex/itch_handler.h"
-#include "trader/l2ex/ouch_handler.h"
-#include "trader/l2ex/market_handler.h"
-
 using namespace TradingPlatform;
 using namespace TradingPlatform::Aeron;
 using namespace TradingPlatform::L2ex;
 
-static std::unique_ptr<Publisher> itchPublisher;
-static std::unique_ptr<Publisher> ouchPublisher;
+static std::unique_ptr<ShardedMarket> market;
+static std::unique_ptr<Journal> journal;
+static std::unique_ptr<Gateway> gateway;
 static std::unique_ptr<Subscriber> ouchSubscriber;
 
 void handleSigInt(int)
 {
-    if (itchPublisher)
-        itchPublisher->stop();
-    if (ouchPublisher)
-        ouchPublisher->stop();
+    if (market)
+        market->stop();
     if (ouchSubscriber)
         ouchSubscriber->stop();
 }
 
 // Forward declaration
-bool prepareMarketManager(Matching::MarketManager *market);
+bool prepareMarketManager(ShardedMarket *market);
+ShardSettings parseShardSettings(int argc, char **argv);
+JournalSettings parseJournalSettings(int argc, char **argv);
+GatewaySettings parseGatewaySettings(int argc, char **argv);
+LoggerSettings parseLoggerSettings(int argc, char **argv);
 PublisherSettings parsePublisherSettingsForITCH(int argc, char **argv);
 PublisherSettings parsePublisherSettingsForOUCH(int argc, char **argv);
+PublisherSettings parsePublisherSettingsForDepth(int argc, char **argv);
 SubscriberSettings parseSubscriberSettingsForOUCH(int argc, char **argv);
+void addThreadOptions(CommandOptionParser &parser, const std::string &prefix, const std::string &thread);
+void parseThreadOptions(CommandOptionParser &parser, const std::string &prefix, ThreadSettings &thread, IdleSettings &idle);
 
 int main(int argc, char **argv)
 {
@@ -38,42 +42,105 @@ int main(int argc, char **argv)
 
     // Parse settings
 
+    auto shardSettings = parseShardSettings(argc, argv);
+    auto journalSettings = parseJournalSettings(argc, argv);
+    auto gatewaySettings = parseGatewaySettings(argc, argv);
+    auto loggerSettings = parseLoggerSettings(argc, argv);
     auto itchPublisherSettings = parsePublisherSettingsForITCH(argc, argv);
     auto ouchPublisherSettings = parsePublisherSettingsForOUCH(argc, argv);
+    auto depthPublisherSettings = parsePublisherSettingsForDepth(argc, argv);
     auto ouchSubscriberSettings = parseSubscriberSettingsForOUCH(argc, argv);
-    if (itchPublisherSettings.invalid || ouchPublisherSettings.invalid || ouchSubscriberSettings.invalid)
+    if (shardSettings.invalid || journalSettings.invalid || gatewaySettings.invalid || loggerSettings.invalid || itchPublisherSettings.invalid || ouchPublisherSettings.invalid || depthPublisherSettings.invalid || ouchSubscriberSettings.invalid)
         return -1;
 
-    std::cout << "Publishing ITCH to channel " << itchPublisherSettings.channel << " on stream " << itchPublisherSettings.streamId << std::endl;
-    std::cout << "Publishing OUCH to channel " << ouchPublisherSettings.channel << " on stream " << ouchPublisherSettings.streamId << std::endl;
+    std::cout << "Matching with " << shardSettings.shards << " market shard(s)" << std::endl;
+    std::cout << "Publishing ITCH to channel " << itchPublisherSettings.channel << " on streams from " << itchPublisherSettings.streamId << std::endl;
+    if (gatewaySettings.channel.empty())
+        std::cout << "Publishing OUCH to channel " << ouchPublisherSettings.channel << " on streams from " << ouchPublisherSettings.streamId << std::endl;
+    else
+    {
+        // Market shards keep OUCH responses for the gateway, which routes them to client sessions
+        ouchPublisherSettings.local = true;
+        std::cout << "Publishing OUCH responses of each session to channel " << gatewaySettings.channel << " on stream " << gatewaySettings.streamId << std::endl;
+    }
+    if (shardSettings.depth.levels > 0)
+        std::cout << "Publishing " << shardSettings.depth.levels << " levels depth to channel " << depthPublisherSettings.channel << " on streams from " << depthPublisherSettings.streamId << std::endl;
+    if (!shardSettings.bbo.empty())
+        std::cout << "Publishing best bid and offer into shared memory table " << shardSettings.bbo << std::endl;
     std::cout << "Subscribing OUCH to channel " << ouchSubscriberSettings.channel << " on stream " << ouchSubscriberSettings.streamId << std::endl;
 
-    // Create and start ITCH publisher
+    // Start the asynchronous logger before matching threads
 
-    itchPublisher = std::make_unique<Publisher>(itchPublisherSettings);
-    if (!itchPublisher || itchPublisher->isFailed())
+    if (!Logger::instance().start(loggerSettings))
         return -1;
 
-    itchPublisher->start();
+    // Select the clock source of ITCH and OUCH timestamps before matching threads are started
 
-    // Create and start OUCH publisher
+    L2ex::Timestamp::setSource(shardSettings.clock);
 
-    ouchPublisher = std::make_unique<Publisher>(ouchPublisherSettings);
-    if (!ouchPublisher || ouchPublisher->isFailed())
+    // Create market shards with their own ITCH, OUCH and depth publishers
+
+    if (shardSettings.snapshotInterval > 0)
+    {
+        if (journalSettings.directory.empty())
+        {
+            std::cerr << "[ERROR] Market snapshots require the journal" << std::endl;
+            return -1;
+        }
+        shardSettings.snapshotDirectory = journalSettings.directory;
+    }
+
+    market = std::make_unique<ShardedMarket>(shardSettings, itchPublisherSettings, ouchPublisherSettings, depthPublisherSettings);
+    if (!market || market->isFailed())
         return -1;
 
-    ouchPublisher->start();
+    // Restore market shards from the latest snapshots taken after the journal sequence
 
-    // Create handlers and market manager
+    auto restored = market->restore();
+    if (market->isFailed())
+        return -1;
+    if (restored > 0)
+        std::cout << "Restored market shards from snapshots at journal sequence " << restored << std::endl;
 
-    auto marketHandler = std::make_shared<MarketHandler>(nullptr, &(*ouchPublisher));
-    auto market = std::make_shared<Matching::MarketManager>(*marketHandler);
-    auto itchHandler = std::make_shared<ITCHHandler>(*market, &(*itchPublisher));
-    auto ouchHandler = std::make_shared<OUCHHandler>(*market, &(*ouchPublisher));
     auto marketPrepared = prepareMarketManager(&(*market));
     if (!marketPrepared)
         return -1;
-    market->EnableMatching();
+    market->enableMatching();
+
+    // Open the journal, replay it to rebuild order books and record all new messages
+
+    if (!journalSettings.directory.empty())
+    {
+        journal = std::make_unique<Journal>(journalSettings);
+        if (!journal || journal->isFailed())
+            return -1;
+
+        auto start = std::chrono::steady_clock::now();
+        auto replayed = market->replay(*journal, restored);
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "Replayed " << replayed << " journal records up to sequence " << journal->sequence() << " in " << duration.count() << " ms" << std::endl;
+
+        market->setJournal(&(*journal));
+    }
+
+    // Create the order entry gateway of client sessions, it adopts restored orders before shards are started
+
+    if (!gatewaySettings.channel.empty())
+    {
+        gateway = std::make_unique<Gateway>(gatewaySettings, *market);
+        if (!gateway || gateway->isFailed())
+            return -1;
+        if (journal)
+            gateway->setJournal(&(*journal));
+
+        auto restoredOrders = gateway->restore();
+        if (restoredOrders > 0)
+            std::cout << "Gateway keeps " << restoredOrders << " restored orders without owner sessions" << std::endl;
+    }
+
+    // Start market shards matching threads
+
+    market->start();
 
     // Create and start OUCH subscriber
     
@@ -81,20 +148,32 @@ int main(int argc, char **argv)
     if (!ouchSubscriber || ouchSubscriber->isFailed())
         return -1;
     
-    ouchSubscriber->setDataHandler([ouchHandler](const aeron::AtomicBuffer &buffer, aeron::index_t offset, aeron::index_t length, const aeron::Header &header)
+    ouchSubscriber->setDataHandler([](const aeron::AtomicBuffer &buffer, aeron::index_t offset, aeron::index_t length, const aeron::Header &header)
     {
         if (length == 0)
             return;
 
-        // Process the buffer
-        bool processed = ouchHandler->Process(buffer.buffer() + offset, length);
+        bool processed;
+        if (gateway)
+        {
+            // Queue commands in the client session, the gateway merges them after the poll
+            processed = gateway->onFragment(buffer.buffer() + offset, length, header.sessionId());
+        }
+        else
+        {
+            // Route the buffer to market shards
+            processed = market->Process(buffer.buffer() + offset, length);
+
+            // Group commit of all journal records of the buffer
+            if (journal)
+                journal->commit();
+        }
 
         // Print some logs
-        std::cout << "Handled message on stream " << header.streamId()
-            << " in session " << header.sessionId()
-            << " [" << offset << ":" << offset + length << "]"
-            << (processed ? " and processed successfully" : " and is not processed")
-            << std::endl;
+        Logger::log(LogLevel::DEBUG, "Handled message on stream ", header.streamId(),
+            " in session ", header.sessionId(),
+            " [", offset, ":", offset + length, "]",
+            (processed ? " and routed successfully" : " and is not routed"));
     });
 
     ouchSubscriber->setEndOfStreamHandler([](aeron::Image &image)
@@ -103,35 +182,35 @@ int main(int argc, char **argv)
             << " with correlation " << image.correlationId()
             << " from " << image.sourceIdentity()
             << std::endl;
+
+        if (gateway)
+            gateway->onEndOfStream(image.sessionId());
     });
 
+    if (gateway)
+        ouchSubscriber->setDutyHandler([]() { return gateway->poll(); });
+
     ouchSubscriber->start();
 
-    // Block main thread until all publishers and subscribers are stopped
+    // Block main thread until all market shards and subscribers are stopped
 
-    itchPublisher->wait();
-    ouchPublisher->wait();
+    market->wait();
     ouchSubscriber->wait();
+    if (gateway)
+        std::cout << "Gateway sessions: " << gateway->sessions() << ", unrouted responses: " << gateway->unrouted() << ", dropped responses: " << gateway->dropped() << std::endl;
+    Logger::instance().stop();
 
     return 0;
 }
 
-bool prepareMarketManager(Matching::MarketManager *market)
+bool prepareMarketManager(ShardedMarket *market)
 {
     auto reg = [&](uint32_t id, const char name[8])
     {
-        Matching::ErrorCode error;
         auto symbol = Matching::Symbol(id, name);
 
-        error = market->AddSymbol(symbol);
-        if (error != Matching::ErrorCode::OK)
-            return false;
-        
-        error = market->AddOrderBook(symbol);
-        if (error != Matching::ErrorCode::OK)
-            return false;
-
-        return true;
+        // All listed pairs trade within a narrow band of ticks, so use price ladders for them
+        return market->addSymbol(symbol, DEFAULT_MARKET_PRICE_LADDER);
     };
 
     bool result = true;
@@ -157,6 +236,181 @@ bool prepareMarketManager(Matching::MarketManager *market)
     return result;
 }
 
+ShardSettings parseShardSettings(int argc, char **argv)
+{
+    ShardSettings settings;
+
+    try
+    {
+        CommandOptionParser parser;
+
+        // Prepare command options parser
+        parser.addOption(CommandOption("market.shards", 1, 1, "Count of market shards with their own matching threads."));
+        parser.addOption(CommandOption("market.queue",  1, 1, "Size of inbound queue of each market shard (in bytes)."));
+        parser.addOption(CommandOption("market.cpu",    1, 1, "First CPU core to pin market shards matching threads to (-1 to disable pinning)."));
+        parser.addOption(CommandOption("market.priority", 1, 1, "SCHED_FIFO priority of market shards matching threads (1-99, 0 to keep the default scheduling)."));
+        parser.addOption(CommandOption("market.idle",   1, 1, "Idle strategy of market shards matching threads: spin, yield, backoff or sleep."));
+        parser.addOption(CommandOption("market.park",   1, 1, "Maximal sleep period of backoff and sleep idle strategies of matching threads (in microseconds)."));
+        parser.addOption(CommandOption("market.clock",  1, 1, "Clock source of ITCH and OUCH timestamps: realtime, coarse or tsc."));
+        parser.addOption(CommandOption("market.snapshot", 1, 1, "Count of journal records between market shards snapshots saved into the journal directory (0 to disable)."));
+        parser.addOption(CommandOption("market.bbo",    1, 1, "Name of the shared memory segment with the best bid and offer table of all symbols (empty to disable)."));
+        parser.addOption(CommandOption("market.routes", 1, 1, "Count of recent order tokens with known shards, replace and cancel of other tokens are routed to all shards (0 to disable)."));
+        parser.addOption(CommandOption("depth.levels",  1, 1, "Count of top price levels of each side published by the depth feed (0 to disable)."));
+        parser.addOption(CommandOption("depth.window",  1, 1, "Depth updates conflation window (in microseconds, 0 to publish after each message)."));
+        parser.addOption(CommandOption("depth.refresh", 1, 1, "Interval between depth full refresh snapshots (in milliseconds, 0 to publish them only on start)."));
+
+        // Parse command arguments
+        parser.parse(argc, argv);
+
+        // Use specified options
+        settings.shards = static_cast<size_t>(parser.getOption("market.shards").getParamAsInt(0, 1, 256, static_cast<int>(settings.shards)));
+        settings.queueSize = static_cast<size_t>(parser.getOption("market.queue").getParamAsInt(0, 1024, INT32_MAX, static_cast<int>(settings.queueSize)));
+        ThreadSettings thread;
+        thread.cpu = settings.cpu;
+        parseThreadOptions(parser, "market", thread, settings.idle);
+        settings.cpu = thread.cpu;
+        settings.priority = thread.priority;
+        std::string clock = parser.getOption("market.clock").getParam(0, "realtime");
+        if (clock == "realtime")
+            settings.clock = L2ex::TimestampSource::REALTIME;
+        else if (clock == "coarse")
+            settings.clock = L2ex::TimestampSource::REALTIME_COARSE;
+        else if (clock == "tsc")
+            settings.clock = L2ex::TimestampSource::TSC;
+        else
+            throw aeron::util::SourcedException("invalid market clock source: " + clock, SOURCEINFO);
+        settings.snapshotInterval = static_cast<std::uint64_t>(parser.getOption("market.snapshot").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.snapshotInterval)));
+        settings.bbo = parser.getOption("market.bbo").getParam(0, "");
+        settings.tokenRoutes = static_cast<size_t>(parser.getOption("market.routes").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.tokenRoutes)));
+        settings.depth.levels = static_cast<size_t>(parser.getOption("depth.levels").getParamAsInt(0, 0, UINT16_MAX, static_cast<int>(settings.depth.levels)));
+        settings.depth.window = std::chrono::microseconds(parser.getOption("depth.window").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.depth.window.count())));
+        settings.depth.refresh = std::chrono::milliseconds(parser.getOption("depth.refresh").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.depth.refresh.count())));
+        settings.invalid = false;
+    }
+    catch (const aeron::util::SourcedException &e)
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl << std::endl;
+    }
+
+    return settings;
+}
+
+JournalSettings parseJournalSettings(int argc, char **argv)
+{
+    JournalSettings settings;
+
+    try
+    {
+        CommandOptionParser parser;
+
+        // Prepare command options parser
+        parser.addOption(CommandOption("journal.dir",     1, 1, "Directory of the journal of inbound OUCH messages (journal is disabled if not specified)."));
+        parser.addOption(CommandOption("journal.segment", 1, 1, "Size of each journal segment file (in bytes)."));
+        parser.addOption(CommandOption("journal.fsync",   1, 1, "Journal fsync policy: never, batch or always."));
+
+        // Parse command arguments
+        parser.parse(argc, argv);
+
+        // Use specified options
+        settings.directory = parser.getOption("journal.dir").getParam(0, settings.directory);
+        settings.segmentSize = static_cast<size_t>(parser.getOption("journal.segment").getParamAsInt(0, 65536, INT32_MAX, static_cast<int>(settings.segmentSize)));
+        std::string fsync = parser.getOption("journal.fsync").getParam(0, "batch");
+        if (fsync == "never")
+            settings.fsync = JournalFsync::NEVER;
+        else if (fsync == "batch")
+            settings.fsync = JournalFsync::BATCH;
+        else if (fsync == "always")
+            settings.fsync = JournalFsync::ALWAYS;
+        else
+            throw aeron::util::SourcedException("invalid journal fsync policy: " + fsync, SOURCEINFO);
+        settings.invalid = false;
+    }
+    catch (const aeron::util::SourcedException &e)
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl << std::endl;
+    }
+
+    return settings;
+}
+
+GatewaySettings parseGatewaySettings(int argc, char **argv)
+{
+    GatewaySettings settings;
+
+    try
+    {
+        CommandOptionParser parser;
+
+        // Prepare command options parser
+        parser.addOption(CommandOption("gateway.dir",     1, 1, "Directory used by Aeron driver."));
+        parser.addOption(CommandOption("gateway.channel", 1, 1, "Channel of OUCH responses, tagged with the session ID of each client (responses are published by shards if not specified)."));
+        parser.addOption(CommandOption("gateway.stream",  1, 1, "Stream ID of OUCH responses as number."));
+        parser.addOption(CommandOption("gateway.quantum", 1, 1, "Count of commands of one session merged in a row before the next session."));
+        parser.addOption(CommandOption("gateway.buffer",  1, 1, "Size of buffer of OUCH responses not sent to one session yet (in bytes)."));
+
+        // Parse command arguments
+        parser.parse(argc, argv);
+
+        // Use specified options
+        settings.directory = parser.getOption("gateway.dir").getParam(0, settings.directory);
+        settings.channel = parser.getOption("gateway.channel").getParam(0, settings.channel);
+        settings.streamId = parser.getOption("gateway.stream").getParamAsInt(0, 1, INT32_MAX, settings.streamId);
+        settings.quantum = static_cast<size_t>(parser.getOption("gateway.quantum").getParamAsInt(0, 1, INT32_MAX, static_cast<int>(settings.quantum)));
+        settings.bufferSize = static_cast<size_t>(parser.getOption("gateway.buffer").getParamAsInt(0, 1024, INT32_MAX, static_cast<int>(settings.bufferSize)));
+        settings.invalid = false;
+    }
+    catch (const aeron::util::SourcedException &e)
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl << std::endl;
+    }
+
+    return settings;
+}
+
+LoggerSettings parseLoggerSettings(int argc, char **argv)
+{
+    LoggerSettings settings;
+
+    try
+    {
+        CommandOptionParser parser;
+
+        // Prepare command options parser
+        parser.addOption(CommandOption("log.file",  1, 1, "Log file (logs are written to stdout if not specified)."));
+        parser.addOption(CommandOption("log.level", 1, 1, "Log level: none, error, info or debug."));
+        parser.addOption(CommandOption("log.size",  1, 1, "Size of the log file to rotate it (in bytes)."));
+        parser.addOption(CommandOption("log.files", 1, 1, "Count of rotated log files to keep."));
+        parser.addOption(CommandOption("log.ring",  1, 1, "Size of the log ring of each logging thread (in bytes)."));
+
+        // Parse command arguments
+        parser.parse(argc, argv);
+
+        // Use specified options
+        settings.file = parser.getOption("log.file").getParam(0, settings.file);
+        std::string level = parser.getOption("log.level").getParam(0, "info");
+        if (level == "none")
+            settings.level = LogLevel::NONE;
+        else if (level == "error")
+            settings.level = LogLevel::ERROR;
+        else if (level == "info")
+            settings.level = LogLevel::INFO;
+        else if (level == "debug")
+            settings.level = LogLevel::DEBUG;
+        else
+            throw aeron::util::SourcedException("invalid log level: " + level, SOURCEINFO);
+        settings.fileSize = static_cast<size_t>(parser.getOption("log.size").getParamAsInt(0, 65536, INT32_MAX, static_cast<int>(settings.fileSize)));
+        settings.files = static_cast<size_t>(parser.getOption("log.files").getParamAsInt(0, 0, 1000, static_cast<int>(settings.files)));
+        settings.ringSize = static_cast<size_t>(parser.getOption("log.ring").getParamAsInt(0, 65536, INT32_MAX, static_cast<int>(settings.ringSize)));
+        settings.invalid = false;
+    }
+    catch (const aeron::util::SourcedException &e)
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl << std::endl;
+    }
+
+    return settings;
+}
+
 PublisherSettings parsePublisherSettingsForITCH(int argc, char **argv)
 {
     PublisherSettings settings;
@@ -171,6 +425,10 @@ PublisherSettings parsePublisherSettingsForITCH(int argc, char **argv)
         parser.addOption(CommandOption("itch.publisher.stream",  1, 1, "Stream ID as number."));
         parser.addOption(CommandOption("itch.publisher.buffer",  1, 1, "Size of buffer used to store cached data before sending to Aeron driver (in bytes)."));
         parser.addOption(CommandOption("itch.publisher.message", 1, 1, "Maximal size of message allowed to send to Aeron driver (in bytes)."));
+        parser.addOption(CommandOption("itch.publisher.batching", 1, 1, "Pack whole length-prefixed frames into batches (0 or 1)."));
+        parser.addOption(CommandOption("itch.publisher.deadline", 1, 1, "Maximal time to wait for more frames before sending not full batch (in microseconds)."));
+        parser.addOption(CommandOption("itch.publisher.claiming", 1, 1, "Serialize messages directly into Aeron log buffer when possible (0 or 1)."));
+        addThreadOptions(parser, "itch.publisher", "publisher threads");
 
         // Parse command arguments
         parser.parse(argc, argv);
@@ -181,6 +439,10 @@ PublisherSettings parsePublisherSettingsForITCH(int argc, char **argv)
         settings.streamId = parser.getOption("itch.publisher.stream").getParamAsInt(0, 1, INT32_MAX, settings.streamId);
         settings.bufferSize = static_cast<size_t>(parser.getOption("itch.publisher.buffer").getParamAsInt(0, 1024, INT32_MAX, static_cast<int>(settings.bufferSize)));
         settings.messageSize = static_cast<size_t>(parser.getOption("itch.publisher.message").getParamAsInt(0, 128, INT32_MAX, static_cast<int>(settings.messageSize)));
+        settings.batching = parser.getOption("itch.publisher.batching").getParamAsInt(0, 0, 1, settings.batching ? 1 : 0) != 0;
+        settings.batchDeadline = std::chrono::microseconds(parser.getOption("itch.publisher.deadline").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.batchDeadline.count())));
+        settings.claiming = parser.getOption("itch.publisher.claiming").getParamAsInt(0, 0, 1, settings.claiming ? 1 : 0) != 0;
+        parseThreadOptions(parser, "itch.publisher", settings.thread, settings.idle);
         settings.invalid = false;
     }
     catch (const aeron::util::SourcedException &e)
@@ -205,6 +467,10 @@ PublisherSettings parsePublisherSettingsForOUCH(int argc, char **argv)
         parser.addOption(CommandOption("ouch.publisher.stream",  1, 1, "Stream ID as number."));
         parser.addOption(CommandOption("ouch.publisher.buffer",  1, 1, "Size of buffer used to store cached data before sending to Aeron driver (in bytes)."));
         parser.addOption(CommandOption("ouch.publisher.message", 1, 1, "Maximal size of message allowed to send to Aeron driver (in bytes)."));
+        parser.addOption(CommandOption("ouch.publisher.batching", 1, 1, "Pack whole length-prefixed frames into batches (0 or 1)."));
+        parser.addOption(CommandOption("ouch.publisher.deadline", 1, 1, "Maximal time to wait for more frames before sending not full batch (in microseconds)."));
+        parser.addOption(CommandOption("ouch.publisher.claiming", 1, 1, "Serialize messages directly into Aeron log buffer when possible (0 or 1)."));
+        addThreadOptions(parser, "ouch.publisher", "publisher threads");
 
         // Parse command arguments
         parser.parse(argc, argv);
@@ -215,6 +481,52 @@ PublisherSettings parsePublisherSettingsForOUCH(int argc, char **argv)
         settings.streamId = parser.getOption("ouch.publisher.stream").getParamAsInt(0, 1, INT32_MAX, settings.streamId);
         settings.bufferSize = static_cast<size_t>(parser.getOption("ouch.publisher.buffer").getParamAsInt(0, 1024, INT32_MAX, static_cast<int>(settings.bufferSize)));
         settings.messageSize = static_cast<size_t>(parser.getOption("ouch.publisher.message").getParamAsInt(0, 128, INT32_MAX, static_cast<int>(settings.messageSize)));
+        settings.batching = parser.getOption("ouch.publisher.batching").getParamAsInt(0, 0, 1, settings.batching ? 1 : 0) != 0;
+        settings.batchDeadline = std::chrono::microseconds(parser.getOption("ouch.publisher.deadline").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.batchDeadline.count())));
+        settings.claiming = parser.getOption("ouch.publisher.claiming").getParamAsInt(0, 0, 1, settings.claiming ? 1 : 0) != 0;
+        parseThreadOptions(parser, "ouch.publisher", settings.thread, settings.idle);
+        settings.invalid = false;
+    }
+    catch (const aeron::util::SourcedException &e)
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl << std::endl;
+    }
+
+    return settings;
+}
+
+PublisherSettings parsePublisherSettingsForDepth(int argc, char **argv)
+{
+    PublisherSettings settings;
+
+    try
+    {
+        CommandOptionParser parser;
+
+        // Prepare command options parser
+        parser.addOption(CommandOption("depth.publisher.dir",     1, 1, "Directory used by Aeron driver."));
+        parser.addOption(CommandOption("depth.publisher.channel", 1, 1, "Channel endpoint to connect to."));
+        parser.addOption(CommandOption("depth.publisher.stream",  1, 1, "Stream ID as number."));
+        parser.addOption(CommandOption("depth.publisher.buffer",  1, 1, "Size of buffer used to store cached data before sending to Aeron driver (in bytes)."));
+        parser.addOption(CommandOption("depth.publisher.message", 1, 1, "Maximal size of message allowed to send to Aeron driver (in bytes)."));
+        parser.addOption(CommandOption("depth.publisher.batching", 1, 1, "Pack whole length-prefixed frames into batches (0 or 1)."));
+        parser.addOption(CommandOption("depth.publisher.deadline", 1, 1, "Maximal time to wait for more frames before sending not full batch (in microseconds)."));
+        parser.addOption(CommandOption("depth.publisher.claiming", 1, 1, "Serialize messages directly into Aeron log buffer when possible (0 or 1)."));
+        addThreadOptions(parser, "depth.publisher", "publisher threads");
+
+        // Parse command arguments
+        parser.parse(argc, argv);
+
+        // Use specified options
+        settings.directory = parser.getOption("depth.publisher.dir").getParam(0, settings.directory);
+        settings.channel = parser.getOption("depth.publisher.channel").getParam(0, settings.channel);
+        settings.streamId = parser.getOption("depth.publisher.stream").getParamAsInt(0, 1, INT32_MAX, settings.streamId);
+        settings.bufferSize = static_cast<size_t>(parser.getOption("depth.publisher.buffer").getParamAsInt(0, 1024, INT32_MAX, static_cast<int>(settings.bufferSize)));
+        settings.messageSize = static_cast<size_t>(parser.getOption("depth.publisher.message").getParamAsInt(0, 128, INT32_MAX, static_cast<int>(settings.messageSize)));
+        settings.batching = parser.getOption("depth.publisher.batching").getParamAsInt(0, 0, 1, settings.batching ? 1 : 0) != 0;
+        settings.batchDeadline = std::chrono::microseconds(parser.getOption("depth.publisher.deadline").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.batchDeadline.count())));
+        settings.claiming = parser.getOption("depth.publisher.claiming").getParamAsInt(0, 0, 1, settings.claiming ? 1 : 0) != 0;
+        parseThreadOptions(parser, "depth.publisher", settings.thread, settings.idle);
         settings.invalid = false;
     }
     catch (const aeron::util::SourcedException &e)
@@ -238,6 +550,7 @@ SubscriberSettings parseSubscriberSettingsForOUCH(int argc, char **argv)
         parser.addOption(CommandOption("ouch.subscriber.channel",   1, 1, "Channel endpoint to connect to."));
         parser.addOption(CommandOption("ouch.subscriber.stream",    1, 1, "Stream ID as number."));
         parser.addOption(CommandOption("ouch.subscriber.fragments", 1, 1, "Fragment count limit."));
+        addThreadOptions(parser, "ouch.subscriber", "subscriber thread");
 
         // Parse command arguments
         parser.parse(argc, argv);
@@ -247,6 +560,7 @@ SubscriberSettings parseSubscriberSettingsForOUCH(int argc, char **argv)
         settings.channel = parser.getOption("ouch.subscriber.channel").getParam(0, settings.channel);
         settings.streamId = parser.getOption("ouch.subscriber.stream").getParamAsInt(0, 1, INT32_MAX, settings.streamId);
         settings.fragments = static_cast<size_t>(parser.getOption("ouch.subscriber.fragments").getParamAsInt(0, 1, INT32_MAX, settings.fragments));
+        parseThreadOptions(parser, "ouch.subscriber", settings.thread, settings.idle);
         settings.invalid = false;
     }
     catch (const aeron::util::SourcedException &e)
@@ -256,3 +570,21 @@ SubscriberSettings parseSubscriberSettingsForOUCH(int argc, char **argv)
 
     return settings;
 }
+
+void addThreadOptions(CommandOptionParser &parser, const std::string &prefix, const std::string &thread)
+{
+    parser.addOption(CommandOption(prefix + ".cpu",      1, 1, "CPU core to pin " + thread + " to (-1 to disable pinning)."));
+    parser.addOption(CommandOption(prefix + ".priority", 1, 1, "SCHED_FIFO priority of " + thread + " (1-99, 0 to keep the default scheduling)."));
+    parser.addOption(CommandOption(prefix + ".idle",     1, 1, "Idle strategy of " + thread + ": spin, yield, backoff or sleep."));
+    parser.addOption(CommandOption(prefix + ".park",     1, 1, "Maximal sleep period of backoff and sleep idle strategies of " + thread + " (in microseconds)."));
+}
+
+void parseThreadOptions(CommandOptionParser &parser, const std::string &prefix, ThreadSettings &thread, IdleSettings &idle)
+{
+    thread.cpu = parser.getOption(prefix + ".cpu").getParamAsInt(0, -1, 1023, thread.cpu);
+    thread.priority = parser.getOption(prefix + ".priority").getParamAsInt(0, 0, 99, thread.priority);
+    std::string strategy = parser.getOption(prefix + ".idle").getParam(0, "");
+    if (!strategy.empty() && !parseIdleStrategyType(strategy, idle.type))
+        throw aeron::util::SourcedException("invalid " + prefix + " idle strategy: " + strategy, SOURCEINFO);
+    idle.park = std::chrono::microseconds(parser.getOption(prefix + ".park").getParamAsInt(0, 1, INT32_MAX, static_cast<int>(idle.park.count())));
+}
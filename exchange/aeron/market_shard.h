@@ -0,0 +1,737 @@
+#ifndef TRADING_PLATFORM_AERON_MARKET_SHARD_H
+#define TRADING_PLATFORM_AERON_MARKET_SHARD_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "configuration.h"
+#include "idle_strategy.h"
+#include "journal.h"
+#include "publisher.h"
+#include "spsc_ring_buffer.h"
+#include "thread.h"
+
+#include "trader/l2ex/depth_feed.h"
+#include "trader/l2ex/itch_handler.h"
+#include "trader/l2ex/market_handler.h"
+#include "trader/l2ex/ouch_handler.h"
+#include "trader/l2ex/timestamp.h"
+#include "trader/matching/bbo_table.h"
+#include "trader/matching/fast_hash.h"
+#include "trader/matching/flat_hash_map.h"
+#include "trader/matching/market_snapshot.h"
+
+namespace TradingPlatform {
+namespace Aeron {
+
+
+struct ShardSettings
+{
+    std::size_t shards = DEFAULT_MARKET_SHARDS;
+    std::size_t queueSize = DEFAULT_MARKET_SHARD_QUEUE_SIZE;
+    int cpu = -1;
+    int priority = 0;
+    IdleSettings idle;
+    L2ex::TimestampSource clock = L2ex::TimestampSource::REALTIME;
+    std::string snapshotDirectory;
+    std::uint64_t snapshotInterval = DEFAULT_MARKET_SNAPSHOT_INTERVAL;
+    std::string bbo;
+    std::size_t bboCapacity = DEFAULT_MARKET_BBO_CAPACITY;
+    std::size_t tokenRoutes = DEFAULT_MARKET_TOKEN_ROUTES;
+    L2ex::DepthSettings depth;
+    bool invalid = true;
+};
+
+
+/** Path of the snapshot file of the given shard taken after the given journal sequence. */
+inline std::string snapshotPath(const std::string &directory, std::uint64_t sequence, std::size_t shards, std::size_t index)
+{
+    char name[64];
+    std::snprintf(name, sizeof(name), "snapshot-%020llu-%zu-%zu.dat", static_cast<unsigned long long>(sequence), shards, index);
+    return directory + "/" + name;
+}
+
+
+/**
+ * Market shard owns a market manager with a subset of order books and runs it
+ * on its own matching thread.
+ *
+ * OUCH messages routed to the shard are passed as length-prefixed frames through
+ * the lock-free SPSC inbound queue, so the matching thread processes them in the
+ * order they were routed. Each shard publishes ITCH and OUCH output through its
+ * own publishers on a separate stream (base stream ID + shard index), so every
+ * shard has its own ordered output stream with independent sequence positions.
+ * The depth feed of the shard order books is published the same way, and the
+ * matching thread polls its conflation and refresh timers after every processed
+ * batch and when the queue is idle, so depth is kept fresh under sustained load.
+ *
+ * Snapshot marker frames are routed to all shards at the same journal sequence.
+ * On the marker the matching thread forks, and the child process saves the
+ * copy-on-write view of the shard market manager into the snapshot file, so the
+ * matching thread pauses only for the fork() call.
+ */
+class MarketShard
+{
+public:
+    static const size_t FRAME_HEADER_SIZE = 2;
+    static const std::uint8_t SNAPSHOT_MARKER = '#';
+    static const size_t SNAPSHOT_MARKER_SIZE = 1 + sizeof(std::uint64_t);
+    static constexpr std::chrono::milliseconds SNAPSHOT_REAP_INTERVAL{10};
+
+    MarketShard(std::size_t index, const ShardSettings &settings, PublisherSettings itchSettings, PublisherSettings ouchSettings, PublisherSettings depthSettings)
+        : _index(index)
+        , _shards(settings.shards)
+        , _cpu(settings.cpu)
+        , _priority(settings.priority)
+        , _idleStrategy(settings.idle)
+        , _snapshotDirectory(settings.snapshotDirectory)
+        , _depth(settings.depth)
+        , _queue(settings.queueSize)
+    {
+        itchSettings.streamId += static_cast<std::int32_t>(index);
+        ouchSettings.streamId += static_cast<std::int32_t>(index);
+        depthSettings.streamId += static_cast<std::int32_t>(index);
+
+        _itchPublisher = std::make_unique<Publisher>(itchSettings);
+        _ouchPublisher = std::make_unique<Publisher>(ouchSettings);
+        if (_itchPublisher->isFailed() || _ouchPublisher->isFailed())
+        {
+            _failed = true;
+            return;
+        }
+        if (settings.depth.levels > 0)
+        {
+            _depthPublisher = std::make_unique<Publisher>(depthSettings);
+            if (_depthPublisher->isFailed())
+            {
+                _failed = true;
+                return;
+            }
+        }
+
+        createMarket();
+    }
+
+    MarketShard(const MarketShard &) = delete;
+    MarketShard &operator=(const MarketShard &) = delete;
+
+    bool isFailed() const { return _failed; }
+
+    std::size_t index() const { return _index; }
+
+    /** Market manager of the shard. Must not be accessed from other threads after the shard is started. */
+    Matching::MarketManager &market() { return *_market; }
+
+    /** OUCH responses publisher of the shard. Local publisher is drained by the gateway instead of Aeron. */
+    Publisher &responses() { return *_ouchPublisher; }
+
+    /** Recreates the empty market manager of the shard after a failed restore. Must be called before the shard is started. */
+    void reset() { createMarket(); }
+
+    /**
+     * Routes the given OUCH message to the shard matching thread (router thread only).
+     * Before the shard is started messages are processed on the caller thread (journal replay).
+     */
+    template <class TMessage>
+    void route(const TMessage &message)
+    {
+        const size_t size = FRAME_HEADER_SIZE + TMessage::SIZE;
+
+        if (!_thread)
+        {
+            std::uint8_t frame[size];
+            frame[0] = static_cast<std::uint8_t>(TMessage::SIZE >> 8);
+            frame[1] = static_cast<std::uint8_t>(TMessage::SIZE & 0xFF);
+            message.serialize(frame + FRAME_HEADER_SIZE, TMessage::SIZE);
+            _ouchHandler->Process(frame, size);
+            return;
+        }
+
+        std::uint8_t *region;
+        while ((region = _queue.claim(size)) == nullptr)
+        {
+            if (!_running)
+                return;
+            std::this_thread::yield();
+        }
+
+        region[0] = static_cast<std::uint8_t>(TMessage::SIZE >> 8);
+        region[1] = static_cast<std::uint8_t>(TMessage::SIZE & 0xFF);
+        message.serialize(region + FRAME_HEADER_SIZE, TMessage::SIZE);
+        _queue.commit(size);
+    }
+
+    /** Routes the snapshot marker with the given journal sequence to the shard matching thread (router thread only). */
+    void routeSnapshot(std::uint64_t sequence)
+    {
+        const size_t size = FRAME_HEADER_SIZE + SNAPSHOT_MARKER_SIZE;
+
+        if (!_thread)
+            return;
+
+        std::uint8_t *region;
+        while ((region = _queue.claim(size)) == nullptr)
+        {
+            if (!_running)
+                return;
+            std::this_thread::yield();
+        }
+
+        region[0] = 0;
+        region[1] = static_cast<std::uint8_t>(SNAPSHOT_MARKER_SIZE);
+        region[2] = SNAPSHOT_MARKER;
+        std::memcpy(region + 3, &sequence, sizeof(sequence));
+        _queue.commit(size);
+    }
+
+    void start()
+    {
+        stop();
+        wait();
+        _itchPublisher->start();
+        _ouchPublisher->start();
+        if (_depthPublisher)
+            _depthPublisher->start();
+        _running = true;
+        _thread = std::make_unique<Thread>(&MarketShard::loop, this);
+        _thread->setName("market-shard-" + std::to_string(_index));
+        ThreadSettings thread;
+        thread.cpu = (_cpu >= 0) ? (_cpu + static_cast<int>(_index)) : -1;
+        thread.priority = _priority;
+        if (!_thread->configure(thread))
+            std::cerr << "Failed to pin market shard " << _index << " to CPU " << thread.cpu << " with priority " << thread.priority << std::endl;
+    }
+
+    /** Suppresses publishing of all shard publishers (journal replay). Must be called before the shard is started. */
+    void suppress(bool suppressed)
+    {
+        _itchPublisher->suppress(suppressed);
+        _ouchPublisher->suppress(suppressed);
+        if (_depthPublisher)
+            _depthPublisher->suppress(suppressed);
+    }
+
+    void stop()
+    {
+        _running = false;
+        if (_itchPublisher)
+            _itchPublisher->stop();
+        if (_ouchPublisher)
+            _ouchPublisher->stop();
+        if (_depthPublisher)
+            _depthPublisher->stop();
+    }
+
+    void wait()
+    {
+        if (_thread && _thread->joinable())
+            _thread->join();
+        if (_itchPublisher)
+            _itchPublisher->wait();
+        if (_ouchPublisher)
+            _ouchPublisher->wait();
+        if (_depthPublisher)
+            _depthPublisher->wait();
+    }
+
+private:
+    void createMarket()
+    {
+        // Handlers and the depth feed refer to the market manager, so they are recreated with it
+        _depthFeed.reset();
+        _ouchHandler.reset();
+        _itchHandler.reset();
+        _market.reset();
+
+        _marketHandler = std::make_unique<L2ex::MarketHandler>(nullptr, &(*_ouchPublisher));
+        _market = std::make_unique<Matching::MarketManager>(*_marketHandler);
+        _itchHandler = std::make_unique<L2ex::ITCHHandler>(*_market, &(*_itchPublisher));
+        _ouchHandler = std::make_unique<L2ex::OUCHHandler>(*_market, &(*_ouchPublisher));
+        if (_depthPublisher)
+        {
+            _depthFeed = std::make_unique<L2ex::DepthFeed>(*_market, &(*_depthPublisher), _depth);
+            _marketHandler->setDepthFeed(&(*_depthFeed));
+        }
+    }
+
+    void loop()
+    {
+        while (_running)
+        {
+            try
+            {
+                // Routed frames never straddle the end of the queue, so every region holds whole frames
+                const std::uint8_t *data = nullptr;
+                const std::size_t size = _queue.read(data);
+                if (size == 0)
+                {
+                    if (_depthFeed)
+                        _depthFeed->poll();
+                    if (_snapshotChild > 0)
+                        reap(false);
+                    _idleStrategy.idle();
+                    continue;
+                }
+
+                process(const_cast<std::uint8_t *>(data), size);
+                _queue.release(size);
+                if (_depthFeed)
+                    _depthFeed->poll();
+                _idleStrategy.reset();
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "FAILED: " << e.what() << " : " << std::endl;
+            }
+        }
+    }
+
+    // Process whole frames and take snapshots on markers between them
+    void process(std::uint8_t *data, std::size_t size)
+    {
+        std::size_t start = 0;
+        std::size_t position = 0;
+        while (position + FRAME_HEADER_SIZE < size)
+        {
+            const std::size_t frame = (static_cast<std::size_t>(data[position]) << 8) | data[position + 1];
+            if ((frame == SNAPSHOT_MARKER_SIZE) && (data[position + FRAME_HEADER_SIZE] == SNAPSHOT_MARKER))
+            {
+                if (position > start)
+                    _ouchHandler->Process(data + start, position - start);
+
+                std::uint64_t sequence;
+                std::memcpy(&sequence, data + position + FRAME_HEADER_SIZE + 1, sizeof(sequence));
+                snapshot(sequence);
+
+                start = position + FRAME_HEADER_SIZE + frame;
+            }
+            position += FRAME_HEADER_SIZE + frame;
+        }
+        if (size > start)
+            _ouchHandler->Process(data + start, size - start);
+    }
+
+    // Save the copy-on-write view of the market manager in the forked child process
+    void snapshot(std::uint64_t sequence)
+    {
+        if ((_snapshotChild > 0) && !reap(true))
+        {
+            std::cerr << "Market shard " << _index << " snapshot " << sequence << " is skipped, previous one is still saving" << std::endl;
+            return;
+        }
+
+        pid_t child = ::fork();
+        if (child == 0)
+        {
+            // Save into the temporary file and rename it, so only complete snapshots are visible
+            std::string path = snapshotPath(_snapshotDirectory, sequence, _shards, _index);
+            std::string temporary = path + ".tmp";
+            bool saved = Matching::MarketSnapshot::Save(*_market, temporary, sequence) && (std::rename(temporary.c_str(), path.c_str()) == 0);
+            ::_exit(saved ? 0 : 1);
+        }
+        else if (child < 0)
+            std::cerr << "Market shard " << _index << " failed to fork for snapshot " << sequence << std::endl;
+        else
+        {
+            _snapshotChild = child;
+            _snapshotSequence = sequence;
+        }
+    }
+
+    // Reap the snapshot child once it finishes, so it does not stay a zombie until the next snapshot.
+    // Without the force flag the child is checked at most once per reap interval.
+    bool reap(bool force)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (!force && (now < _snapshotReap))
+            return false;
+        _snapshotReap = now + SNAPSHOT_REAP_INTERVAL;
+
+        int status = 0;
+        pid_t result = ::waitpid(_snapshotChild, &status, WNOHANG);
+        if (result == 0)
+            return false;
+        if ((result < 0) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+            std::cerr << "Market shard " << _index << " failed to save snapshot " << _snapshotSequence << std::endl;
+        _snapshotChild = 0;
+        return true;
+    }
+
+private:
+    std::size_t _index;
+    std::size_t _shards;
+    int _cpu;
+    int _priority;
+    IdleStrategy _idleStrategy;
+    std::string _snapshotDirectory;
+    pid_t _snapshotChild = 0;
+    std::uint64_t _snapshotSequence = 0;
+    std::chrono::steady_clock::time_point _snapshotReap;
+    L2ex::DepthSettings _depth;
+
+    SPSCRingBuffer _queue;
+
+    std::unique_ptr<Publisher> _itchPublisher;
+    std::unique_ptr<Publisher> _ouchPublisher;
+    std::unique_ptr<Publisher> _depthPublisher;
+    std::unique_ptr<L2ex::MarketHandler> _marketHandler;
+    std::unique_ptr<Matching::MarketManager> _market;
+    std::unique_ptr<L2ex::ITCHHandler> _itchHandler;
+    std::unique_ptr<L2ex::OUCHHandler> _ouchHandler;
+    std::unique_ptr<L2ex::DepthFeed> _depthFeed;
+
+    std::unique_ptr<Thread> _thread;
+    std::atomic<bool> _running{false};
+
+    bool _failed = false;
+};
+
+
+/**
+ * Sharded market partitions order books by symbol across market shards and
+ * routes incoming OUCH messages to them (OUCH subscriber thread only).
+ *
+ * Symbols are assigned to shards in round-robin order of registration. Enter
+ * order messages are routed by order book ID. Replace and cancel messages do not
+ * carry it, so the router keeps the shard of recently entered order tokens in a
+ * bounded table: the oldest routes are evicted first, and routes are forgotten
+ * on cancel and when the gateway sees the order done. Messages with tokens
+ * without a route are routed to all shards, and shards check that they hold the
+ * order before processing them. All messages of one symbol go through the same
+ * shard queue, which preserves per-symbol event order.
+ *
+ * When the journal is attached every routed message is appended to it before
+ * it is passed to the shard. Replaying the journal before the shards are started
+ * rebuilds order books on the caller thread. Publishers of all shards are
+ * suppressed for the duration of the replay, so replayed events are never
+ * published to clients again.
+ *
+ * With the snapshot interval the router sends snapshot markers to all shards
+ * after every given count of journal records. On startup market shards are
+ * restored from the latest complete set of shard snapshots and only the journal
+ * records after its sequence are replayed. Old snapshots are kept on disk.
+ *
+ * With the BBO segment name all shards write the top of the book of their order
+ * books into the same shared memory BBO table. Every symbol belongs to exactly
+ * one shard, so each table record still has a single writer.
+ *
+ * Every routed message gets the next global sequence number, which is its
+ * journal sequence when the journal is attached.
+ */
+class ShardedMarket : public OUCH::OUCHHandler
+{
+public:
+    ShardedMarket(const ShardSettings &settings, const PublisherSettings &itchSettings, const PublisherSettings &ouchSettings, const PublisherSettings &depthSettings)
+        : _snapshotDirectory(settings.snapshotDirectory)
+        , _snapshotInterval(settings.snapshotDirectory.empty() ? 0 : settings.snapshotInterval)
+        , _symbols(1024, 0)
+        , _tokens(settings.tokenRoutes, 0)
+        , _tokenSlots(settings.tokenRoutes, 0)
+    {
+        for (std::size_t index = 0; index < settings.shards; ++index)
+        {
+            _shards.emplace_back(std::make_unique<MarketShard>(index, settings, itchSettings, ouchSettings, depthSettings));
+            if (_shards.back()->isFailed())
+                _failed = true;
+        }
+        if (!settings.bbo.empty())
+        {
+            _bbo = std::make_unique<Matching::BBOTable>(settings.bbo, settings.bboCapacity);
+            if (!_bbo->valid())
+            {
+                std::cerr << "[ERROR] BBO table " << settings.bbo << " was created with a different layout" << std::endl;
+                _failed = true;
+            }
+        }
+    }
+
+    bool isFailed() const { return _failed; }
+
+    std::size_t shards() const { return _shards.size(); }
+    MarketShard &shard(std::size_t index) { return *_shards[index]; }
+
+    /**
+     * Adds the symbol and its order book to the next shard. Symbols restored from
+     * snapshots stay in their shards. Must be called before the shards are started.
+     */
+    bool addSymbol(const Matching::Symbol &symbol, size_t ladder = 0, uint64_t tick = 1)
+    {
+        if (_symbols.count(symbol.Id) > 0)
+            return false;
+
+        for (auto &restored : _shards)
+        {
+            if (restored->market().GetOrderBook(symbol.Id) != nullptr)
+            {
+                _symbols.emplace(symbol.Id, restored->index());
+                return true;
+            }
+        }
+
+        MarketShard &shard = *_shards[_symbols.size() % _shards.size()];
+        if (shard.market().AddSymbol(symbol) != Matching::ErrorCode::OK)
+            return false;
+        if (shard.market().AddOrderBook(symbol, ladder, tick) != Matching::ErrorCode::OK)
+            return false;
+
+        _symbols.emplace(symbol.Id, shard.index());
+        return true;
+    }
+
+    /** Attaches the journal of routed messages (router thread only). */
+    void setJournal(Journal *journal)
+    {
+        _journal = journal;
+        if (_journal)
+            _sequence = _journal->sequence();
+    }
+
+    /** Global sequence number of the last routed message. */
+    std::uint64_t sequence() const { return _sequence; }
+
+    /** Routes the OUCH message to its shard (router thread only). */
+    template <class TMessage>
+    bool route(const TMessage &message) { return onMessage(message); }
+
+    /** Forgets the shard of the done order token (router thread only). */
+    void forget(std::uint64_t token) { _tokens.erase(token); }
+
+    /**
+     * Restores market shards from the latest complete set of snapshots. If the
+     * set fails to load, shards are cleared and the previous complete set is
+     * tried. Must be called before any symbol is added. Returns the journal
+     * sequence of the restored snapshots or 0 if there is nothing to restore.
+     */
+    std::uint64_t restore()
+    {
+        if (_snapshotDirectory.empty())
+            return 0;
+
+        // Count snapshots of each sequence, temporary files of unfinished snapshots are skipped
+        std::map<std::uint64_t, std::size_t> sequences;
+        if (DIR *dir = ::opendir(_snapshotDirectory.c_str()))
+        {
+            while (struct dirent *entry = ::readdir(dir))
+            {
+                unsigned long long sequence;
+                size_t shards, index;
+                int length = 0;
+                if ((std::sscanf(entry->d_name, "snapshot-%llu-%zu-%zu.dat%n", &sequence, &shards, &index, &length) == 3) && (length > 0) && (entry->d_name[length] == '\0') && (shards == _shards.size()) && (index < shards))
+                    ++sequences[sequence];
+            }
+            ::closedir(dir);
+        }
+
+        // Restore the latest sequence with snapshots of all shards, fall back to older ones on failure
+        for (auto it = sequences.rbegin(); it != sequences.rend(); ++it)
+        {
+            if (it->second != _shards.size())
+                continue;
+
+            bool restored = true;
+            for (auto &shard : _shards)
+            {
+                std::uint64_t sequence = 0;
+                if (!Matching::MarketSnapshot::Load(shard->market(), snapshotPath(_snapshotDirectory, it->first, _shards.size(), shard->index()), sequence))
+                {
+                    std::cerr << "[ERROR] Failed to restore market shard " << shard->index() << " from snapshot " << it->first << std::endl;
+                    restored = false;
+                    break;
+                }
+            }
+            if (restored)
+            {
+                // Rebuild order tokens routes of the restored orders
+                for (auto &shard : _shards)
+                    for (auto &order : shard->market().orders())
+                        remember(order.first, shard->index());
+                return it->first;
+            }
+
+            for (auto &shard : _shards)
+                shard->reset();
+        }
+        return 0;
+    }
+
+    /** Replays journal records after the given sequence into market shards. Must be called before the shards are started. */
+    std::uint64_t replay(const Journal &journal, std::uint64_t sequence = 0)
+    {
+        Journal *attached = _journal;
+        _journal = nullptr;
+        for (auto &shard : _shards)
+            shard->suppress(true);
+        std::uint64_t count = 0;
+        journal.replay([this, sequence, &count](const JournalRecord &record, std::uint8_t *frame)
+        {
+            if (record.sequence <= sequence)
+                return;
+            Process(frame, record.size);
+            ++count;
+        });
+        for (auto &shard : _shards)
+            shard->suppress(false);
+        _journal = attached;
+        return count;
+    }
+
+    /** Enables matching and attaches the BBO table, so it starts from the restored and replayed order books. */
+    void enableMatching()
+    {
+        for (auto &shard : _shards)
+        {
+            shard->market().EnableMatching();
+            if (_bbo)
+                shard->market().AttachBBOTable(&(*_bbo));
+        }
+    }
+
+    void start()
+    {
+        for (auto &shard : _shards)
+            shard->start();
+    }
+
+    void stop()
+    {
+        for (auto &shard : _shards)
+            shard->stop();
+    }
+
+    void wait()
+    {
+        for (auto &shard : _shards)
+            shard->wait();
+    }
+
+protected:
+    bool onMessage(const OUCH::EnterOrderMessage &message) override
+    {
+        // Orders of unknown symbols are routed to the first shard to be rejected there
+        auto it = _symbols.find(message.OrderbookId);
+        std::size_t index = (it != _symbols.end()) ? it->second : 0;
+        remember(message.OrderToken, index);
+        dispatch(index, message);
+        return true;
+    }
+
+    bool onMessage(const OUCH::ReplaceOrderMessage &message) override
+    {
+        std::size_t index = lookup(message.ExistingOrderToken);
+        forget(message.ExistingOrderToken);
+        if (index != ALL_SHARDS)
+            remember(message.ReplacementOrderToken, index);
+        dispatch(index, message);
+        return true;
+    }
+
+    bool onMessage(const OUCH::CancelOrderMessage &message) override
+    {
+        std::size_t index = lookup(message.OrderToken);
+        forget(message.OrderToken);
+        dispatch(index, message);
+        return true;
+    }
+
+    bool onMessage(const OUCH::UnknownMessage &message) override
+    {
+        std::cerr << "[ROUTE] Unknown message received: " << message << std::endl;
+        return true;
+    }
+
+private:
+    // Shard index of messages routed to all shards
+    static const std::size_t ALL_SHARDS = static_cast<std::size_t>(-1);
+
+    template <class TMessage>
+    void dispatch(std::size_t index, const TMessage &message)
+    {
+        if (_journal)
+        {
+            std::uint64_t sequence = _journal->append(message);
+            route(index, message);
+            if (sequence > 0)
+                _sequence = sequence;
+
+            // Take snapshots of all shards at the same journal sequence
+            if ((_snapshotInterval > 0) && (sequence > 0) && ((sequence % _snapshotInterval) == 0))
+                for (auto &shard : _shards)
+                    shard->routeSnapshot(sequence);
+            return;
+        }
+        ++_sequence;
+        route(index, message);
+    }
+
+    // Shard of the order token or all shards if the token has no route
+    std::size_t lookup(std::uint64_t token) const
+    {
+        auto it = _tokens.find(token);
+        return (it != _tokens.end()) ? it->second.shard : ALL_SHARDS;
+    }
+
+    // Keep the route of the order token in the next slot instead of the oldest one
+    void remember(std::uint64_t token, std::size_t index)
+    {
+        if (_tokenSlots.empty())
+            return;
+
+        const std::size_t slot = _tokenNext;
+        _tokenNext = (_tokenNext + 1) % _tokenSlots.size();
+        auto oldest = _tokens.find(_tokenSlots[slot]);
+        if ((oldest != _tokens.end()) && (oldest->second.slot == slot))
+            _tokens.erase(oldest);
+        _tokenSlots[slot] = token;
+
+        // Token already in use could belong to an order of another shard
+        auto result = _tokens.emplace(token, TokenRoute{ index, slot });
+        if (!result.second)
+            result.first->second = TokenRoute{ (result.first->second.shard == index) ? index : ALL_SHARDS, slot };
+    }
+
+    template <class TMessage>
+    void route(std::size_t index, const TMessage &message)
+    {
+        if (index != ALL_SHARDS)
+            _shards[index]->route(message);
+        else
+            for (auto &shard : _shards)
+                shard->route(message);
+    }
+
+    struct TokenRoute
+    {
+        std::size_t shard;
+        std::size_t slot;
+    };
+
+    typedef Matching::FlatHashMap<uint64_t, std::size_t, Matching::FastHash> Routes;
+    typedef Matching::FlatHashMap<uint64_t, TokenRoute, Matching::FastHash> TokenRoutes;
+
+    std::vector<std::unique_ptr<MarketShard>> _shards;
+    std::string _snapshotDirectory;
+    std::uint64_t _snapshotInterval;
+    Routes _symbols;
+    TokenRoutes _tokens;
+    std::vector<std::uint64_t> _tokenSlots;
+    std::size_t _tokenNext = 0;
+    Journal *_journal = nullptr;
+    std::uint64_t _sequence = 0;
+    std::unique_ptr<Matching::BBOTable> _bbo;
+
+    bool _failed = false;
+};
+
+
+}}
+
+#endif // TRADING_PLATFORM_AERON_MARKET_SHARD_H
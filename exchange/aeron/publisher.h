@@ -1,16 +1,19 @@
 #ifndef TRADING_PLATFORM_AERON_ITCH_PUBLISHER_H
 #define TRADING_PLATFORM_AERON_ITCH_PUBLISHER_H
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <vector>
 
 #include "system/stream.h"
 
 #include "Aeron.h"
-#include "concurrent/NoOpIdleStrategy.h"
 #include "util/Exceptions.h"
 
-#include "circular_buffer.h"
 #include "configuration.h"
+#include "idle_strategy.h"
+#include "spsc_ring_buffer.h"
 #include "thread.h"
 
 namespace TradingPlatform {
@@ -24,18 +27,92 @@ struct PublisherSettings
     std::int32_t streamId = DEFAULT_STREAM_ID;
     std::size_t bufferSize = DEFAULT_PUBLISHER_BUFFER_SIZE;
     std::size_t messageSize = DEFAULT_PUBLISHER_MESSAGE_SIZE;
+    bool batching = DEFAULT_PUBLISHER_BATCHING;
+    bool claiming = DEFAULT_PUBLISHER_CLAIMING;
+    bool local = false;
+    std::chrono::microseconds batchDeadline = DEFAULT_PUBLISHER_BATCH_DEADLINE;
+    ThreadSettings thread;
+    IdleSettings idle;
     bool invalid = true;
 };
 
 
+/**
+ * Publisher statistics: histogram of batches sent in batching mode and
+ * count of messages published with direct claims vs. buffered fallbacks.
+ * Bucket N counts batches of [2^(N-1) + 1, 2^N] frames.
+ */
+class PublisherStatistics
+{
+public:
+    static const size_t BUCKETS = 12;
+
+    void update(size_t frames, size_t bytes)
+    {
+        size_t bucket = 0;
+        while ((bucket < BUCKETS - 1) && ((size_t(1) << bucket) < frames))
+            ++bucket;
+        _histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+        _batches.fetch_add(1, std::memory_order_relaxed);
+        _frames.fetch_add(frames, std::memory_order_relaxed);
+        _bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void claimed() { _claims.fetch_add(1, std::memory_order_relaxed); }
+    void fallback() { _fallbacks.fetch_add(1, std::memory_order_relaxed); }
+
+    std::uint64_t claims() const { return _claims.load(std::memory_order_relaxed); }
+    std::uint64_t fallbacks() const { return _fallbacks.load(std::memory_order_relaxed); }
+    std::uint64_t batches() const { return _batches.load(std::memory_order_relaxed); }
+    std::uint64_t frames() const { return _frames.load(std::memory_order_relaxed); }
+    std::uint64_t bytes() const { return _bytes.load(std::memory_order_relaxed); }
+    std::uint64_t histogram(size_t bucket) const { return _histogram[bucket].load(std::memory_order_relaxed); }
+
+    void print(std::ostream &stream) const
+    {
+        stream << "Publisher claims: " << claims() << ", fallbacks: " << fallbacks() << std::endl;
+        stream << "Publisher batches: " << batches() << ", frames: " << frames() << ", bytes: " << bytes() << std::endl;
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket)
+        {
+            size_t from = (bucket == 0) ? 1 : ((size_t(1) << (bucket - 1)) + 1);
+            size_t to = size_t(1) << bucket;
+            stream << "  " << from;
+            if (bucket == BUCKETS - 1)
+                stream << "+";
+            else if (to > from)
+                stream << "-" << to;
+            stream << " frames: " << histogram(bucket) << std::endl;
+        }
+    }
+
+private:
+    std::atomic<std::uint64_t> _claims{0};
+    std::atomic<std::uint64_t> _fallbacks{0};
+    std::atomic<std::uint64_t> _histogram[BUCKETS] = {};
+    std::atomic<std::uint64_t> _batches{0};
+    std::atomic<std::uint64_t> _frames{0};
+    std::atomic<std::uint64_t> _bytes{0};
+};
+
+
 class Publisher
 {
 public:
+    // Size of big-endian length prefix of ITCH/OUCH frames
+    static const size_t FRAME_HEADER_SIZE = 2;
+
     Publisher(const PublisherSettings &settings)
         : _settings(settings)
     {
         try
         {
+            // Local publisher only buffers frames for the in-process consumer
+            if (_settings.local)
+            {
+                _bufferRing = std::make_unique<SPSCRingBuffer>(_settings.bufferSize);
+                return;
+            }
+
             if (!_settings.directory.empty())
                 _context.aeronDir(_settings.directory);
                 
@@ -64,10 +141,11 @@ public:
                       << ((channelStatus == aeron::ChannelEndpointStatus::CHANNEL_ENDPOINT_ACTIVE) ? "ACTIVE" : std::to_string(channelStatus))
                       << std::endl;
 
-            _bufferMessage.resize(_settings.messageSize);
-            _bufferMessageAtomic.reset(new aeron::AtomicBuffer(&_bufferMessage[0], _bufferMessage.size()));
-            _bufferCircular = CircularBufferCreate(_settings.bufferSize);
+            _bufferRing = std::make_unique<SPSCRingBuffer>(_settings.bufferSize);
+            _bufferRingAtomic.reset(new aeron::AtomicBuffer(_bufferRing->buffer(), _bufferRing->capacity()));
 
+            // Batches should fit into a single network packet unless the message size is smaller
+            _batchLimit = std::min(_settings.messageSize, static_cast<size_t>(_publication->maxPayloadLength()));
         }
         catch (const aeron::SourcedException &e)
         {
@@ -81,11 +159,7 @@ public:
         }
     }
 
-    virtual ~Publisher()
-    {
-        if (_bufferCircular)
-            CircularBufferFree(_bufferCircular);
-    }
+    virtual ~Publisher() = default;
 
     bool isFailed() { return _failed; }
 
@@ -94,7 +168,11 @@ public:
         stop();
         wait();
         _running = true;
+        if (_settings.local)
+            return;
         _thread = std::make_unique<Thread>(&Publisher::loop, this);
+        if (!_thread->configure(_settings.thread))
+            std::cerr << "Failed to pin publisher of stream " << _settings.streamId << " to CPU " << _settings.thread.cpu << " with priority " << _settings.thread.priority << std::endl;
     }
 
     void stop()
@@ -108,24 +186,131 @@ public:
             _thread->join();
     }
 
+    /**
+     * Suppresses publishing: all published messages are dropped until publishing is enabled again.
+     * Used while the journal is replayed, so rebuilt events are not sent to clients again.
+     * Must be called from the producer thread.
+     */
+    void suppress(bool suppressed) { _suppressed = suppressed; }
+    bool isSuppressed() const { return _suppressed; }
+
+    /** Copies data into the publisher buffer. Must be called from a single producer thread. */
     void publish(void *data, size_t size)
     {
+        std::uint8_t *region = claim(size);
+        if (region)
+        {
+            std::memcpy(region, data, size);
+            commit(size);
+        }
+    }
+
+    /**
+     * Reserves a contiguous region of the publisher buffer to serialize data in place.
+     * Waits for free space while the publisher is running, returns nullptr after it was stopped
+     * or while it is suppressed.
+     * Must be called from a single producer thread and followed by commit().
+     */
+    std::uint8_t *claim(size_t size)
+    {
+        if (_suppressed)
+            return nullptr;
+
+        // Producer thread waits with its own idle strategy state
+        IdleStrategy idleStrategy(_settings.idle);
         while (_running)
         {
-            try
+            std::uint8_t *region = _bufferRing->claim(size);
+            if (region)
+                return region;
+            idleStrategy.idle();
+        }
+        return nullptr;
+    }
+
+    /** Makes the claimed region available for sending to Aeron driver. */
+    void commit(size_t size)
+    {
+        _bufferRing->commit(size);
+    }
+
+    /**
+     * Publishes the message as a length-prefixed frame. Must be called from a single producer thread.
+     *
+     * In claiming mode the message is serialized straight into Aeron log buffer with tryClaim()
+     * if nothing is buffered (so the order of messages is kept). Otherwise or when back-pressured
+     * it falls back to the buffered path and the message is serialized in place into the ring.
+     */
+    template <class TMessage>
+    void publishMessage(const TMessage &message)
+    {
+        const size_t size = FRAME_HEADER_SIZE + TMessage::SIZE;
+
+        if (_suppressed)
+            return;
+
+        if (_settings.claiming && _publication)
+        {
+            if (_bufferRing->empty())
             {
+                auto result = _publication->tryClaim(static_cast<aeron::index_t>(size), _bufferClaim);
+                if (result > 0)
                 {
-                    std::lock_guard<std::mutex> locker(_mutex);
-                    auto bufferCapacity = CircularBufferGetCapacity(_bufferCircular);
-                    auto bufferUsedBytes = CircularBufferGetDataSize(_bufferCircular);
-                    auto bufferFreeBytes = bufferCapacity - bufferUsedBytes;
-                    if (bufferFreeBytes >= size)
-                    {
-                        CircularBufferPush(_bufferCircular, reinterpret_cast<std::uint8_t *>(data), size);
-                        break;
-                    }
+                    serializeFrame(_bufferClaim.buffer().buffer() + _bufferClaim.offset(), message);
+                    _bufferClaim.commit();
+                    _statistics.claimed();
+                    return;
                 }
-                _idleStrategy.idle(0);
+            }
+            _statistics.fallback();
+        }
+
+        std::uint8_t *region = claim(size);
+        if (region)
+        {
+            serializeFrame(region, message);
+            commit(size);
+        }
+    }
+
+    /**
+     * Returns the next contiguous region of frames committed into the local publisher.
+     * Producers commit whole frames, so the region never splits a frame. In-process consumer only.
+     */
+    size_t read(const std::uint8_t *&data)
+    {
+        return _bufferRing->read(data);
+    }
+
+    /** Returns the given count of bytes obtained with read() back to the producer. In-process consumer only. */
+    void release(size_t size)
+    {
+        _bufferRing->release(size);
+    }
+
+    const PublisherStatistics &statistics() const { return _statistics; }
+
+    /** Maximal size of one message sent to Aeron driver. */
+    size_t messageSize() const { return _settings.messageSize; }
+
+    /** Serializes the message as a length-prefixed frame into the given buffer. */
+    template <class TMessage>
+    static void serializeFrame(std::uint8_t *buffer, const TMessage &message)
+    {
+        buffer[0] = static_cast<std::uint8_t>(TMessage::SIZE >> 8);
+        buffer[1] = static_cast<std::uint8_t>(TMessage::SIZE & 0xFF);
+        message.serialize(buffer + FRAME_HEADER_SIZE, TMessage::SIZE);
+    }
+
+private:
+    void loop()
+    {
+        while (_running)
+        {
+            try
+            {
+                bool processed = _settings.batching ? processFrames() : processBytes();
+                _idleStrategy.idle(processed ? 1 : 0);
             }
             catch (const aeron::SourcedException &e)
             {
@@ -136,110 +321,181 @@ public:
                 std::cerr << "FAILED: " << e.what() << " : " << std::endl;
             }
         }
+
+        if (_settings.batching || _settings.claiming)
+            _statistics.print(std::cout);
     }
 
-private:
-    void loop()
+    // Offer buffered data sliced by message size regardless of frame boundaries
+    bool processBytes()
+    {
+        const std::uint8_t *data = nullptr;
+        size_t readBytes = _bufferRing->read(data, _settings.messageSize);
+        if (readBytes == 0)
+            return false;
+
+        if (!offer(*_bufferRingAtomic, offset(data), readBytes))
+            return false;
+
+        _bufferRing->release(readBytes);
+        return true;
+    }
+
+    // Offer whole length-prefixed frames packed up to the batch limit, flush on size or deadline
+    bool processFrames()
     {
+        const std::uint8_t *data = nullptr;
+        size_t readBytes = _bufferRing->read(data);
+        if (readBytes == 0)
+            return false;
+
+        // Scan frames which were committed since the previous call
+        size_t batchFrames = _batchFrames;
+        bool full = false;
+        while (_batchBytes + FRAME_HEADER_SIZE <= readBytes)
+        {
+            size_t frameSize = FRAME_HEADER_SIZE + ((static_cast<size_t>(data[_batchBytes]) << 8) | data[_batchBytes + 1]);
+            if ((_batchFrames > 0) && (_batchBytes + frameSize > _batchLimit))
+            {
+                full = true;
+                break;
+            }
+            if (_batchBytes + frameSize > readBytes)
+                break;
+            _batchBytes += frameSize;
+            ++_batchFrames;
+            if (_batchBytes >= _batchLimit)
+            {
+                full = true;
+                break;
+            }
+        }
+
+        // The data region ends at the end of the buffer lap and cannot grow anymore
+        bool boundary = (_batchBytes == readBytes) ? _bufferRing->boundary(readBytes) : false;
+
+        if (_batchFrames == 0)
+        {
+            // Frame is split by the end of the buffer lap, so it should be joined before sending
+            if (_bufferRing->boundary(readBytes))
+                return stitchFrame(data, readBytes);
+            return true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (batchFrames == 0)
+            _batchStart = now;
+
+        // Wait for more frames until the batch is full or its deadline is expired
+        if (!full && !boundary && (now - _batchStart < _settings.batchDeadline))
+            return true;
+
+        if (!offer(*_bufferRingAtomic, offset(data), _batchBytes))
+            return false;
+
+        _bufferRing->release(_batchBytes);
+        _statistics.update(_batchFrames, _batchBytes);
+        _batchBytes = 0;
+        _batchFrames = 0;
+        return true;
+    }
+
+    // Join the frame split by the end of the buffer lap and offer it alone. Its bytes are released
+    // only after the offer, so messages claimed directly in the meantime cannot overtake it.
+    bool stitchFrame(const std::uint8_t *data, size_t size)
+    {
+        _bufferFrame.assign(data, data + size);
+        const size_t skipped = _bufferRing->lap();
+
+        size_t frameSize = 0;
+        size_t joined = 0;
+        _idleStrategy.reset();
         while (_running)
         {
-            try
+            if ((frameSize == 0) && (_bufferFrame.size() >= FRAME_HEADER_SIZE))
+                frameSize = FRAME_HEADER_SIZE + ((static_cast<size_t>(_bufferFrame[0]) << 8) | _bufferFrame[1]);
+            if ((frameSize > 0) && (_bufferFrame.size() >= frameSize))
+                break;
+
+            size_t requiredBytes = (frameSize > 0) ? (frameSize - _bufferFrame.size()) : (FRAME_HEADER_SIZE - _bufferFrame.size());
+            size_t readBytes = _bufferRing->read(data, requiredBytes, skipped + joined);
+            if (readBytes == 0)
             {
-                size_t readingBytes = 0;
-                size_t readBytes = 0;
-                size_t removedBytes = 0;
-                {
-                    std::lock_guard<std::mutex> locker(_mutex);
-                    readingBytes = CircularBufferGetDataSize(_bufferCircular);
-                    if (readingBytes > 0)
-                    {
-                        readingBytes = std::min(readingBytes, _settings.messageSize);
-                        readBytes = CircularBufferRead(_bufferCircular, readingBytes, _bufferMessageAtomic->buffer());
-                    }
-                }
-                if (readingBytes > 0)
-                {
-                    if (readingBytes != readBytes)
-                    {
-                        std::cout << "Circular buffer failed during reading " << readingBytes << " bytes" << std::endl;
-                        std::this_thread::yield();
-                    }
-                    else
-                    {
-                        auto result = _publication->offer(*_bufferMessageAtomic, 0, readingBytes);
-                        if (result < 0)
-                        {
-                            if (result == aeron::BACK_PRESSURED)
-                            {
-                                //std::cout << "Offer failed due to back pressure" << std::endl;
-                            }
-                            else if (result == aeron::NOT_CONNECTED)
-                            {
-                                std::cout << "Offer failed because publisher is not connected to subscriber" << std::endl;
-                            }
-                            else if (result == aeron::ADMIN_ACTION)
-                            {
-                                std::cout << "Offer failed because of an administration action in the system" << std::endl;
-                            }
-                            else if (result == aeron::PUBLICATION_CLOSED)
-                            {
-                                std::cout << "Offer failed publication is closed" << std::endl;
-                            }
-                            else
-                            {
-                                std::cout << "Offer failed due to unknown reason" << result << std::endl;
-                            }
-                            std::this_thread::yield();
-                        }
-                        else
-                        {
-                            std::lock_guard<std::mutex> locker(_mutex);
-                            removedBytes = CircularBufferPop(_bufferCircular, readBytes, nullptr);
-                            if (removedBytes != readBytes)
-                            {
-                                std::cout << "Circular buffer failed during popping out " << readBytes << " bytes" << std::endl;
-                                std::this_thread::yield();
-                            }
-                        }
-                        if (!_publication->isConnected())
-                        {
-                            std::cout << "No active subscribers detected" << std::endl;
-                            std::this_thread::yield();
-                        }
-                    }
-                }
-                else
-                {
-                    std::this_thread::yield();
-                }
-                
+                _idleStrategy.idle();
+                continue;
             }
-            catch (const aeron::SourcedException &e)
+            _bufferFrame.insert(_bufferFrame.end(), data, data + readBytes);
+            joined += readBytes;
+        }
+
+        aeron::AtomicBuffer buffer(_bufferFrame.data(), _bufferFrame.size());
+        _idleStrategy.reset();
+        while (_running && !offer(buffer, 0, _bufferFrame.size()))
+            _idleStrategy.idle();
+
+        _bufferRing->release(skipped + joined);
+        _statistics.update(1, _bufferFrame.size());
+        return true;
+    }
+
+    aeron::index_t offset(const std::uint8_t *data) const
+    {
+        return static_cast<aeron::index_t>(data - _bufferRing->buffer());
+    }
+
+    bool offer(aeron::AtomicBuffer &buffer, aeron::index_t offset, size_t length)
+    {
+        auto result = _publication->offer(buffer, offset, static_cast<aeron::index_t>(length));
+        if (result < 0)
+        {
+            if (result == aeron::BACK_PRESSURED)
             {
-                std::cerr << "FAILED: " << e.what() << " : " << e.where() << std::endl;
+                //std::cout << "Offer failed due to back pressure" << std::endl;
             }
-            catch (const std::exception &e)
+            else if (result == aeron::NOT_CONNECTED)
             {
-                std::cerr << "FAILED: " << e.what() << " : " << std::endl;
+                std::cout << "Offer failed because publisher is not connected to subscriber" << std::endl;
+            }
+            else if (result == aeron::ADMIN_ACTION)
+            {
+                std::cout << "Offer failed because of an administration action in the system" << std::endl;
+            }
+            else if (result == aeron::PUBLICATION_CLOSED)
+            {
+                std::cout << "Offer failed publication is closed" << std::endl;
+            }
+            else
+            {
+                std::cout << "Offer failed due to unknown reason" << result << std::endl;
             }
         }
+        if (!_publication->isConnected())
+            std::cout << "No active subscribers detected" << std::endl;
+        return result >= 0;
     }
 
 private:
     PublisherSettings _settings;
     aeron::Context _context;
-    aeron::NoOpIdleStrategy _idleStrategy;
+    IdleStrategy _idleStrategy;
 
     std::shared_ptr<aeron::Aeron> _aeron;
     std::shared_ptr<aeron::Publication> _publication;
 
-    CircularBuffer _bufferCircular = nullptr;
-    std::vector<std::uint8_t> _bufferMessage;
-    std::unique_ptr<aeron::AtomicBuffer> _bufferMessageAtomic;
+    std::unique_ptr<SPSCRingBuffer> _bufferRing;
+    std::unique_ptr<aeron::AtomicBuffer> _bufferRingAtomic;
+    std::vector<std::uint8_t> _bufferFrame;
+    aeron::BufferClaim _bufferClaim;
+
+    size_t _batchLimit = 0;
+    size_t _batchBytes = 0;
+    size_t _batchFrames = 0;
+    std::chrono::steady_clock::time_point _batchStart;
+    PublisherStatistics _statistics;
 
     std::unique_ptr<Thread> _thread;
-    std::mutex _mutex;
-    std::atomic<bool> _running;
+    std::atomic<bool> _running{false};
+    bool _suppressed = false;
 
     bool _failed = false;
 };
@@ -0,0 +1,216 @@
+#ifndef TRADING_PLATFORM_AERON_SPSC_RING_BUFFER_H
+#define TRADING_PLATFORM_AERON_SPSC_RING_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace TradingPlatform {
+namespace Aeron {
+
+
+const static std::size_t CACHE_LINE_SIZE = 64;
+
+
+/**
+ * Lock-free single producer / single consumer byte ring buffer.
+ *
+ * Producer reserves a contiguous region with claim(), writes into it in place
+ * and makes it visible to the consumer with commit(). Consumer takes the next
+ * contiguous committed region with read() and returns it with release().
+ *
+ * Claimed regions never straddle the end of the buffer: when a claim does not
+ * fit into the rest of the buffer the producer skips the tail and remembers the
+ * skip position, so the consumer always sees every claimed region as one block.
+ *
+ * Head and tail positions are monotonic byte counters placed on separate cache
+ * lines together with the local copy of the opposite counter, so producer and
+ * consumer do not share cache lines on the fast path.
+ */
+class SPSCRingBuffer
+{
+public:
+    explicit SPSCRingBuffer(std::size_t capacity)
+    {
+        _capacity = 1;
+        while (_capacity < capacity)
+            _capacity <<= 1;
+        _mask = _capacity - 1;
+        _buffer = static_cast<std::uint8_t *>(std::malloc(_capacity));
+        if (_buffer == nullptr)
+            throw std::bad_alloc();
+    }
+
+    SPSCRingBuffer(const SPSCRingBuffer &) = delete;
+    SPSCRingBuffer &operator=(const SPSCRingBuffer &) = delete;
+
+    ~SPSCRingBuffer()
+    {
+        std::free(_buffer);
+    }
+
+    std::uint8_t *buffer() const { return _buffer; }
+    std::size_t capacity() const { return _capacity; }
+
+    /** Returns the count of bytes committed by the producer and not released by the consumer yet. */
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire));
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Reserves a contiguous region of the given size for writing (producer only).
+     * Returns nullptr if there is not enough free space at the moment.
+     */
+    std::uint8_t *claim(std::size_t size)
+    {
+        const std::uint64_t head = _head.load(std::memory_order_relaxed);
+        const std::size_t index = static_cast<std::size_t>(head & _mask);
+        const std::size_t skip = (index + size > _capacity) ? (_capacity - index) : 0;
+        const std::uint64_t required = head + skip + size;
+
+        if (required - _tailCached > _capacity)
+        {
+            _tailCached = _tail.load(std::memory_order_acquire);
+            if (required - _tailCached > _capacity)
+                return nullptr;
+        }
+
+        // Publish the skip position before the head moves past it
+        if (skip > 0)
+            _wrap.store(head, std::memory_order_relaxed);
+
+        _claimed = skip;
+        return _buffer + ((head + skip) & _mask);
+    }
+
+    /** Makes the previously claimed region visible to the consumer (producer only). */
+    void commit(std::size_t size)
+    {
+        const std::uint64_t head = _head.load(std::memory_order_relaxed);
+        _head.store(head + _claimed + size, std::memory_order_release);
+        _claimed = 0;
+    }
+
+    /** Copies the given data into the buffer. Returns false if there is not enough free space (producer only). */
+    bool push(const void *data, std::size_t size)
+    {
+        std::uint8_t *region = claim(size);
+        if (region == nullptr)
+            return false;
+        std::memcpy(region, data, size);
+        commit(size);
+        return true;
+    }
+
+    /**
+     * Returns the next contiguous committed region up to the given limit (consumer only).
+     * Producer head is reloaded only when cached committed data is less than the limit.
+     * Returns 0 if there is nothing to read.
+     */
+    std::size_t read(const std::uint8_t *&data, std::size_t limit = std::numeric_limits<std::size_t>::max())
+    {
+        std::uint64_t tail = _tail.load(std::memory_order_relaxed);
+        if (_headCached - tail < limit)
+        {
+            _headCached = _head.load(std::memory_order_acquire);
+            if (tail == _headCached)
+                return 0;
+        }
+
+        // Skip the unused tail of the buffer left by the producer
+        if (tail == _wrap.load(std::memory_order_relaxed))
+        {
+            tail += _capacity - (tail & _mask);
+            _tail.store(tail, std::memory_order_release);
+            if (tail == _headCached)
+                return 0;
+        }
+
+        return region(tail, data, limit);
+    }
+
+    /**
+     * Returns the next contiguous committed region which starts the given count of bytes after
+     * the consumer position up to the given limit (consumer only). Bytes before the region stay
+     * not released, so data split by the end of the buffer lap can be joined before it is released.
+     * The offset must not point into the skipped tail of the buffer, see lap().
+     * Returns 0 if there is nothing to read.
+     */
+    std::size_t read(const std::uint8_t *&data, std::size_t limit, std::size_t offset)
+    {
+        const std::uint64_t position = _tail.load(std::memory_order_relaxed) + offset;
+        if ((_headCached < position) || (_headCached - position < limit))
+        {
+            _headCached = _head.load(std::memory_order_acquire);
+            if (_headCached <= position)
+                return 0;
+        }
+
+        return region(position, data, limit);
+    }
+
+    /** Returns the count of bytes from the consumer position to the beginning of the next buffer lap (consumer only). */
+    std::size_t lap() const
+    {
+        return _capacity - static_cast<std::size_t>(_tail.load(std::memory_order_relaxed) & _mask);
+    }
+
+    /**
+     * Returns true if the region of the given size obtained with read() ends at the end of
+     * the current buffer lap, so it cannot grow even if more data is committed (consumer only).
+     */
+    bool boundary(std::size_t size) const
+    {
+        const std::uint64_t end = _tail.load(std::memory_order_relaxed) + size;
+        return ((end & _mask) == 0) || (end == _wrap.load(std::memory_order_relaxed));
+    }
+
+    /** Returns the given count of bytes obtained with read() back to the producer (consumer only). */
+    void release(std::size_t size)
+    {
+        _tail.store(_tail.load(std::memory_order_relaxed) + size, std::memory_order_release);
+    }
+
+private:
+    // Contiguous committed region at the given position up to the end of the buffer or the skip position
+    std::size_t region(std::uint64_t position, const std::uint8_t *&data, std::size_t limit) const
+    {
+        const std::size_t index = static_cast<std::size_t>(position & _mask);
+        std::size_t available = static_cast<std::size_t>(_headCached - position);
+        available = std::min(available, _capacity - index);
+
+        const std::uint64_t wrap = _wrap.load(std::memory_order_relaxed);
+        if ((wrap > position) && (wrap - position < available))
+            available = static_cast<std::size_t>(wrap - position);
+
+        data = _buffer + index;
+        return std::min(available, limit);
+    }
+
+    // Shared read-mostly state (skip position changes once per buffer lap)
+    std::uint8_t *_buffer;
+    std::size_t _capacity;
+    std::uint64_t _mask;
+    std::atomic<std::uint64_t> _wrap{std::numeric_limits<std::uint64_t>::max()};
+
+    // Producer state
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> _head{0};
+    std::uint64_t _tailCached = 0;
+    std::uint64_t _claimed = 0;
+
+    // Consumer state
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> _tail{0};
+    std::uint64_t _headCached = 0;
+};
+
+
+}}
+
+#endif // TRADING_PLATFORM_AERON_SPSC_RING_BUFFER_H
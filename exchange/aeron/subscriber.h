@@ -2,15 +2,17 @@
 #define TRADING_PLATFORM_AERON_ITCH_SUBSCRIBER_H
 
 #include <iostream>
+#include <unordered_set>
 
 #include "system/stream.h"
 
 #include "Aeron.h"
-#include "concurrent/NoOpIdleStrategy.h"
 #include "util/Exceptions.h"
 
 #include "command_option_parser.h"
 #include "configuration.h"
+#include "idle_strategy.h"
+#include "thread.h"
 
 namespace TradingPlatform {
 namespace Aeron {
@@ -22,6 +24,8 @@ struct SubscriberSettings
     std::string channel = DEFAULT_CHANNEL;
     std::int32_t streamId = DEFAULT_STREAM_ID;
     int fragments = DEFAULT_FRAGMENT_COUNT_LIMIT;
+    ThreadSettings thread;
+    IdleSettings idle = { IdleStrategyType::BUSY_SPIN };
     bool invalid = true;
 };
 
@@ -41,9 +45,12 @@ using EndOfStreamHandler = std::function<void(
     aeron::Image &image
 )>;
 
+using DutyHandler = std::function<int()>;
+
 public:
     Subscriber(const SubscriberSettings &settings)
         : _settings(settings)
+        , _idleStrategy(settings.idle)
     {
         try
         {
@@ -111,12 +118,20 @@ public:
         _handlerEndOfStream = handler;
     }
 
+    /** Sets the handler called after each poll on the subscriber thread. It returns the amount of work done. */
+    void setDutyHandler(DutyHandler handler)
+    {
+        _handlerDuty = handler;
+    }
+
     void start()
     {
         stop();
         wait();
         _running = true;
         _thread = std::make_unique<Thread>(&Subscriber::loop, this);
+        if (!_thread->configure(_settings.thread))
+            std::cerr << "Failed to pin subscriber of stream " << _settings.streamId << " to CPU " << _settings.thread.cpu << " with priority " << _settings.thread.priority << std::endl;
     }
 
     void stop()
@@ -134,20 +149,23 @@ private:
 
     void loop()
     {
-        bool reachedEndOfStream = false;
+        // Images stay at the end of stream until they are closed, so each one is reported only once
+        std::unordered_set<std::int64_t> endedImages;
+        auto handlerEndOfStream = [this, &endedImages](aeron::Image &image)
+        {
+            if (endedImages.insert(image.correlationId()).second)
+                _handlerEndOfStream(image);
+        };
+
         while (_running)
         {
             try
             {
                 const int fragmentsRead = _handlerData ? _subscription->poll(_handlerData, _settings.fragments) : 0;
-                if (fragmentsRead == 0)
-                {
-                    if (!reachedEndOfStream && _handlerEndOfStream && _subscription->pollEndOfStreams(_handlerEndOfStream) > 0)
-                    {
-                        reachedEndOfStream = true;
-                    }
-                }
-                _idleStrategy.idle(fragmentsRead);
+                if ((fragmentsRead == 0) && _handlerEndOfStream)
+                    _subscription->pollEndOfStreams(handlerEndOfStream);
+                const int workDone = fragmentsRead + (_handlerDuty ? _handlerDuty() : 0);
+                _idleStrategy.idle(workDone);
             }
             catch (const aeron::SourcedException &e)
             {
@@ -163,16 +181,17 @@ private:
 private:
     SubscriberSettings _settings;
     aeron::Context _context;
-    aeron::NoOpIdleStrategy _idleStrategy;
+    IdleStrategy _idleStrategy;
 
     std::shared_ptr<aeron::Aeron> _aeron;
     std::shared_ptr<aeron::Subscription> _subscription;
 
     std::unique_ptr<Thread> _thread;
-    std::atomic<bool> _running;
+    std::atomic<bool> _running{false};
 
     DataHandler _handlerData;
     EndOfStreamHandler _handlerEndOfStream;
+    DutyHandler _handlerDuty;
 
     bool _failed = false;
 };
@@ -81,6 +81,9 @@ PublisherSettings parsePublisherSettings(int argc, char **argv)
         parser.addOption(CommandOption("itch.publisher.stream",  1, 1, "Stream ID as number."));
         parser.addOption(CommandOption("itch.publisher.buffer",  1, 1, "Size of buffer used to store cached data before sending to Aeron driver (in bytes)."));
         parser.addOption(CommandOption("itch.publisher.message", 1, 1, "Maximal size of message allowed to send to Aeron driver (in bytes)."));
+        parser.addOption(CommandOption("itch.publisher.batching", 1, 1, "Pack whole length-prefixed frames into batches (0 or 1)."));
+        parser.addOption(CommandOption("itch.publisher.deadline", 1, 1, "Maximal time to wait for more frames before sending not full batch (in microseconds)."));
+        parser.addOption(CommandOption("itch.publisher.claiming", 1, 1, "Serialize messages directly into Aeron log buffer when possible (0 or 1)."));
 
         // Parse command arguments
         parser.parse(argc, argv);
@@ -91,6 +94,9 @@ PublisherSettings parsePublisherSettings(int argc, char **argv)
         settings.streamId = parser.getOption("itch.publisher.stream").getParamAsInt(0, 1, INT32_MAX, settings.streamId);
         settings.bufferSize = static_cast<size_t>(parser.getOption("itch.publisher.buffer").getParamAsInt(0, 1024, INT32_MAX, static_cast<int>(settings.bufferSize)));
         settings.messageSize = static_cast<size_t>(parser.getOption("itch.publisher.message").getParamAsInt(0, 128, INT32_MAX, static_cast<int>(settings.messageSize)));
+        settings.batching = parser.getOption("itch.publisher.batching").getParamAsInt(0, 0, 1, settings.batching ? 1 : 0) != 0;
+        settings.batchDeadline = std::chrono::microseconds(parser.getOption("itch.publisher.deadline").getParamAsInt(0, 0, INT32_MAX, static_cast<int>(settings.batchDeadline.count())));
+        settings.claiming = parser.getOption("itch.publisher.claiming").getParamAsInt(0, 0, 1, settings.claiming ? 1 : 0) != 0;
         settings.invalid = false;
     }
     catch (const aeron::util::SourcedException &e)
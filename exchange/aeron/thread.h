@@ -1,10 +1,23 @@
 #ifndef TRADING_PLATFORM_THREAD_H
 #define TRADING_PLATFORM_THREAD_H
 
+#include <string>
 #include <thread>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace TradingPlatform {
 
+/** CPU core and real-time priority of the thread. */
+struct ThreadSettings
+{
+    int cpu = -1;       // CPU core to pin the thread to (-1 to disable pinning)
+    int priority = 0;   // SCHED_FIFO priority (1-99, 0 to keep the default scheduling)
+};
+
 class Thread : public std::thread
 {
 public:
@@ -77,6 +90,43 @@ public:
         m_priority = priority;
     }
 
+    /** Switches the thread to SCHED_FIFO with the given priority (1-99). Returns false if it is failed or not supported. */
+    bool setRealtimePriority(int priority)
+    {
+#if defined(__linux__)
+        sched_param param = {};
+        param.sched_priority = priority;
+        return pthread_setschedparam(native_handle(), SCHED_FIFO, &param) == 0;
+#else
+        (void)priority;
+        return false;
+#endif
+    }
+
+    /** Pins the thread to the given CPU core. Returns false if pinning is failed or not supported. */
+    bool setAffinity(size_t cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(cpu, &cpuset);
+        return pthread_setaffinity_np(native_handle(), sizeof(cpuset), &cpuset) == 0;
+#else
+        return false;
+#endif
+    }
+
+    /** Applies CPU pinning and real-time priority of the given settings. Returns false if any of them is failed. */
+    bool configure(const ThreadSettings &settings)
+    {
+        bool result = true;
+        if (settings.cpu >= 0)
+            result = setAffinity(static_cast<size_t>(settings.cpu)) && result;
+        if (settings.priority > 0)
+            result = setRealtimePriority(settings.priority) && result;
+        return result;
+    }
+
     /** Returns true in case when this method is called on it's own thread. */
     bool isCurrent() const { return get_id() == std::this_thread::get_id(); }
 
@@ -130,6 +180,35 @@ public:
             nativePriority = THREAD_PRIORITY_NORMAL;
         }
         SetThreadPriority(threadHandle, nativePriority);
+#elif defined(__linux__)
+        // Priorities above normal are real-time ones, the lower ones use background policies
+        int policy = SCHED_OTHER;
+        sched_param param = {};
+        switch (priority)
+        {
+        case Priority::Idle:
+            policy = SCHED_IDLE;
+            break;
+        case Priority::Lowest:
+        case Priority::BelowNormal:
+            policy = SCHED_BATCH;
+            break;
+        case Priority::AboveNormal:
+            policy = SCHED_FIFO;
+            param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+            break;
+        case Priority::Highest:
+            policy = SCHED_FIFO;
+            param.sched_priority = (sched_get_priority_min(SCHED_FIFO) + sched_get_priority_max(SCHED_FIFO)) / 2;
+            break;
+        case Priority::TimeCritical:
+            policy = SCHED_FIFO;
+            param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+            break;
+        default:
+            policy = SCHED_OTHER;
+        }
+        pthread_setschedparam(threadHandle, policy, &param);
 #endif
     }
 
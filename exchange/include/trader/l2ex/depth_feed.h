@@ -0,0 +1,445 @@
+#ifndef TRADING_PLATFORM_L2EX_DEPTH_FEED_H
+#define TRADING_PLATFORM_L2EX_DEPTH_FEED_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "trader/l2ex/timestamp.h"
+#include "trader/matching/batch_market_handler.h"
+#include "trader/matching/market_manager.h"
+#include "utility/endian.h"
+#include "../../../aeron/configuration.h"
+
+namespace TradingPlatform {
+namespace L2ex {
+
+/**
+ * Depth update message ('L') changes one price level of the top of the book.
+ *
+ * Action is 'A' for a new level, 'U' for a changed level and 'D' for a level
+ * which left the top of the book. Sequence is incremented for each update of
+ * the symbol, so receivers detect gaps and resync from the next snapshot.
+ */
+struct DepthUpdateMessage
+{
+    char Type;
+    uint32_t SymbolId;
+    uint64_t Sequence;
+    uint64_t Timestamp;
+    char Side;
+    char Action;
+    uint64_t Price;
+    uint64_t Volume;
+    uint32_t Orders;
+
+    static constexpr size_t SIZE = 43;
+
+    size_t serialize(void *buffer, size_t size) const
+    {
+        if (size < SIZE)
+            return 0;
+
+        uint8_t *data = (uint8_t *)buffer;
+
+        *data++ = this->Type;
+        data += CppCommon::Endian::WriteBigEndian(data, this->SymbolId);
+        data += CppCommon::Endian::WriteBigEndian(data, this->Sequence);
+        data += CppCommon::Endian::WriteBigEndian(data, this->Timestamp);
+        *data++ = this->Side;
+        *data++ = this->Action;
+        data += CppCommon::Endian::WriteBigEndian(data, this->Price);
+        data += CppCommon::Endian::WriteBigEndian(data, this->Volume);
+        data += CppCommon::Endian::WriteBigEndian(data, this->Orders);
+
+        return SIZE;
+    }
+
+    bool deserialize(void *buffer, size_t size)
+    {
+        if (size < SIZE)
+            return false;
+
+        uint8_t *data = (uint8_t *)buffer;
+
+        this->Type = *data++;
+        data += CppCommon::Endian::ReadBigEndian(data, this->SymbolId);
+        data += CppCommon::Endian::ReadBigEndian(data, this->Sequence);
+        data += CppCommon::Endian::ReadBigEndian(data, this->Timestamp);
+        this->Side = *data++;
+        this->Action = *data++;
+        data += CppCommon::Endian::ReadBigEndian(data, this->Price);
+        data += CppCommon::Endian::ReadBigEndian(data, this->Volume);
+        data += CppCommon::Endian::ReadBigEndian(data, this->Orders);
+
+        return true;
+    }
+
+    template <class TOutputStream>
+    friend TOutputStream &operator<<(TOutputStream &stream, const DepthUpdateMessage &message)
+    {
+        stream << "DepthUpdateMessage(Type=" << message.Type
+            << "; SymbolId=" << message.SymbolId
+            << "; Sequence=" << message.Sequence
+            << "; Timestamp=" << message.Timestamp
+            << "; Side=" << message.Side
+            << "; Action=" << message.Action
+            << "; Price=" << message.Price
+            << "; Volume=" << message.Volume
+            << "; Orders=" << message.Orders
+            << ")";
+        return stream;
+    }
+};
+
+/**
+ * Depth snapshot message ('F') starts the full refresh of the top of the book.
+ *
+ * It is followed by BidLevels bid and AskLevels ask depth update messages with
+ * 'A' action and the same sequence, best levels first. Receivers replace the
+ * whole symbol book with them and apply only updates with greater sequences.
+ */
+struct DepthSnapshotMessage
+{
+    char Type;
+    uint32_t SymbolId;
+    uint64_t Sequence;
+    uint64_t Timestamp;
+    uint16_t BidLevels;
+    uint16_t AskLevels;
+
+    static constexpr size_t SIZE = 25;
+
+    size_t serialize(void *buffer, size_t size) const
+    {
+        if (size < SIZE)
+            return 0;
+
+        uint8_t *data = (uint8_t *)buffer;
+
+        *data++ = this->Type;
+        data += CppCommon::Endian::WriteBigEndian(data, this->SymbolId);
+        data += CppCommon::Endian::WriteBigEndian(data, this->Sequence);
+        data += CppCommon::Endian::WriteBigEndian(data, this->Timestamp);
+        data += CppCommon::Endian::WriteBigEndian(data, this->BidLevels);
+        data += CppCommon::Endian::WriteBigEndian(data, this->AskLevels);
+
+        return SIZE;
+    }
+
+    bool deserialize(void *buffer, size_t size)
+    {
+        if (size < SIZE)
+            return false;
+
+        uint8_t *data = (uint8_t *)buffer;
+
+        this->Type = *data++;
+        data += CppCommon::Endian::ReadBigEndian(data, this->SymbolId);
+        data += CppCommon::Endian::ReadBigEndian(data, this->Sequence);
+        data += CppCommon::Endian::ReadBigEndian(data, this->Timestamp);
+        data += CppCommon::Endian::ReadBigEndian(data, this->BidLevels);
+        data += CppCommon::Endian::ReadBigEndian(data, this->AskLevels);
+
+        return true;
+    }
+
+    template <class TOutputStream>
+    friend TOutputStream &operator<<(TOutputStream &stream, const DepthSnapshotMessage &message)
+    {
+        stream << "DepthSnapshotMessage(Type=" << message.Type
+            << "; SymbolId=" << message.SymbolId
+            << "; Sequence=" << message.Sequence
+            << "; Timestamp=" << message.Timestamp
+            << "; BidLevels=" << message.BidLevels
+            << "; AskLevels=" << message.AskLevels
+            << ")";
+        return stream;
+    }
+};
+
+
+struct DepthSettings
+{
+    std::size_t levels = Aeron::DEFAULT_DEPTH_LEVELS;                   // Depth feed is disabled if zero
+    std::chrono::microseconds window = Aeron::DEFAULT_DEPTH_WINDOW;     // Updates are published after each command if zero
+    std::chrono::milliseconds refresh = Aeron::DEFAULT_DEPTH_REFRESH;   // Snapshots are not repeated if zero
+};
+
+
+/**
+ * Market-by-price depth feed of the top levels of all order books.
+ *
+ * Level events of market manager commands only mark their symbols as touched.
+ * When the conflation window since the first touch is over, the feed reads the
+ * current top levels of touched order books and publishes the difference with
+ * the previously published top levels. A burst of commands within the window
+ * produces at most one update per level, and levels which entered the top of
+ * the book when better ones were removed are published too.
+ *
+ * Full refresh snapshots of all order books are published on the first poll
+ * and then periodically, so late joiners sync without replaying the feed.
+ * Updates and snapshots of one symbol are published as contiguous frame blocks.
+ *
+ * Publisher type is a template argument, so the feed is bound to the Aeron
+ * publisher in the matching engine (see DepthFeed) and to a recording one in
+ * tests. It must provide FRAME_HEADER_SIZE, serializeFrame(), messageSize()
+ * and publish() like Aeron::Publisher does.
+ *
+ * Must be used from the matching thread of its market manager only.
+ */
+template <class TPublisher>
+class BasicDepthFeed
+{
+public:
+
+    BasicDepthFeed(const Matching::MarketManager &market, TPublisher *publisher, const DepthSettings &settings)
+        : _market(market)
+        , _publisher(publisher)
+        , _settings(settings)
+    {
+    }
+
+    BasicDepthFeed(const BasicDepthFeed &) = delete;
+    BasicDepthFeed &operator=(const BasicDepthFeed &) = delete;
+
+    /** Marks symbols touched by level and order book events of the market manager command. */
+    void onMarketEvents(const Matching::MarketEvent *events, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            switch (events[i].Type)
+            {
+                case Matching::MarketEventType::ADD_LEVEL:
+                case Matching::MarketEventType::UPDATE_LEVEL:
+                case Matching::MarketEventType::DELETE_LEVEL:
+                case Matching::MarketEventType::DELETE_ORDER_BOOK:
+                    touch(events[i].SymbolId);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if (!_touched.empty() && (_settings.window.count() == 0))
+            flush();
+    }
+
+    /** Publishes touched symbols after the conflation window and periodic snapshots. */
+    void poll()
+    {
+        if (_touched.empty() && (_settings.refresh.count() == 0) && _refreshed)
+            return;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (!_touched.empty() && (now - _touchedSince >= _settings.window))
+            flush();
+        if (!_refreshed || ((_settings.refresh.count() > 0) && (now - _refreshedAt >= _settings.refresh)))
+        {
+            refresh();
+            _refreshed = true;
+            _refreshedAt = now;
+        }
+    }
+
+    /** Publishes updates of all touched symbols. */
+    void flush()
+    {
+        const uint64_t timestamp = Timestamp::nanosecondsSinceMidnight();
+        for (auto id : _touched)
+        {
+            Book &book = _books[id];
+            book.touched = false;
+
+            collect(id);
+            _frames.clear();
+            update(book.bids, _bids, id, 'B', timestamp);
+            update(book.asks, _asks, id, 'S', timestamp);
+            publish();
+        }
+        _touched.clear();
+    }
+
+    /** Publishes snapshots of all order books. */
+    void refresh()
+    {
+        const uint64_t timestamp = Timestamp::nanosecondsSinceMidnight();
+        for (auto order_book_ptr : _market.order_books())
+        {
+            if (order_book_ptr == nullptr)
+                continue;
+
+            const uint32_t id = order_book_ptr->symbol().Id;
+            if (id >= _books.size())
+                _books.resize(id + 1);
+            Book &book = _books[id];
+
+            // Snapshot already includes pending updates of the symbol
+            collect(id);
+            book.bids = _bids;
+            book.asks = _asks;
+
+            _frames.clear();
+            DepthSnapshotMessage message = {};
+            message.Type = 'F';
+            message.SymbolId = id;
+            message.Sequence = book.sequence;
+            message.Timestamp = timestamp;
+            message.BidLevels = static_cast<uint16_t>(book.bids.size());
+            message.AskLevels = static_cast<uint16_t>(book.asks.size());
+            append(message);
+            for (const auto &level : book.bids)
+                append(level, id, book.sequence, timestamp, 'B', 'A');
+            for (const auto &level : book.asks)
+                append(level, id, book.sequence, timestamp, 'S', 'A');
+            publish();
+        }
+    }
+
+private:
+
+    struct Level
+    {
+        uint64_t price;
+        uint64_t volume;
+        uint32_t orders;
+    };
+
+    struct Book
+    {
+        std::vector<Level> bids;
+        std::vector<Level> asks;
+        uint64_t sequence = 0;
+        bool touched = false;
+    };
+
+    void touch(uint32_t id)
+    {
+        if (id >= _books.size())
+            _books.resize(id + 1);
+        Book &book = _books[id];
+        if (book.touched)
+            return;
+
+        book.touched = true;
+        if (_touched.empty())
+            _touchedSince = std::chrono::steady_clock::now();
+        _touched.push_back(id);
+    }
+
+    // Collect the current top levels of the order book with the visible volume (deleted order book has no levels)
+    void collect(uint32_t id)
+    {
+        _bids.clear();
+        _asks.clear();
+
+        const Matching::OrderBook *order_book_ptr = _market.GetOrderBook(id);
+        if (order_book_ptr == nullptr)
+            return;
+
+        collect(*order_book_ptr, order_book_ptr->best_bid(), _bids);
+        collect(*order_book_ptr, order_book_ptr->best_ask(), _asks);
+    }
+
+    void collect(const Matching::OrderBook &order_book, const Matching::LevelNode *level_ptr, std::vector<Level> &levels)
+    {
+        for (; (level_ptr != nullptr) && (levels.size() < _settings.levels); level_ptr = order_book.GetNextLevel(level_ptr))
+            if (level_ptr->VisibleVolume > 0)
+                levels.push_back(Level{ level_ptr->Price, level_ptr->VisibleVolume, static_cast<uint32_t>(level_ptr->Orders) });
+    }
+
+    // Append updates from the published levels to the current ones (both are sorted from the best price)
+    void update(std::vector<Level> &published, const std::vector<Level> &current, uint32_t id, char side, uint64_t timestamp)
+    {
+        Book &book = _books[id];
+        auto better = [side](uint64_t price1, uint64_t price2) { return (side == 'B') ? (price1 > price2) : (price1 < price2); };
+
+        // Deletes go first, so receivers never keep more than the top levels count
+        size_t j = 0;
+        for (const auto &level : published)
+        {
+            while ((j < current.size()) && better(current[j].price, level.price))
+                ++j;
+            if ((j == current.size()) || (current[j].price != level.price))
+                append(level, id, ++book.sequence, timestamp, side, 'D');
+        }
+
+        size_t i = 0;
+        for (const auto &level : current)
+        {
+            while ((i < published.size()) && better(published[i].price, level.price))
+                ++i;
+            if ((i == published.size()) || (published[i].price != level.price))
+                append(level, id, ++book.sequence, timestamp, side, 'A');
+            else if ((published[i].volume != level.volume) || (published[i].orders != level.orders))
+                append(level, id, ++book.sequence, timestamp, side, 'U');
+        }
+
+        published = current;
+    }
+
+    template <class TMessage>
+    void append(const TMessage &message)
+    {
+        const size_t offset = _frames.size();
+        _frames.resize(offset + TPublisher::FRAME_HEADER_SIZE + TMessage::SIZE);
+        TPublisher::serializeFrame(_frames.data() + offset, message);
+    }
+
+    void append(const Level &level, uint32_t id, uint64_t sequence, uint64_t timestamp, char side, char action)
+    {
+        DepthUpdateMessage message = {};
+        message.Type = 'L';
+        message.SymbolId = id;
+        message.Sequence = sequence;
+        message.Timestamp = timestamp;
+        message.Side = side;
+        message.Action = action;
+        message.Price = level.price;
+        message.Volume = (action == 'D') ? 0 : level.volume;
+        message.Orders = (action == 'D') ? 0 : level.orders;
+        append(message);
+    }
+
+    // Publish collected frames in blocks which fit into one Aeron message
+    void publish()
+    {
+        if (_frames.empty() || (_publisher == nullptr))
+            return;
+
+        const size_t limit = _publisher->messageSize();
+        size_t start = 0;
+        size_t position = 0;
+        while (position < _frames.size())
+        {
+            const size_t frame = TPublisher::FRAME_HEADER_SIZE + ((static_cast<size_t>(_frames[position]) << 8) | _frames[position + 1]);
+            if ((position > start) && (position + frame - start > limit))
+            {
+                _publisher->publish(_frames.data() + start, position - start);
+                start = position;
+            }
+            position += frame;
+        }
+        _publisher->publish(_frames.data() + start, position - start);
+    }
+
+private:
+
+    const Matching::MarketManager &_market;
+    TPublisher *_publisher;
+    DepthSettings _settings;
+
+    std::vector<Book> _books;
+    std::vector<uint32_t> _touched;
+    std::chrono::steady_clock::time_point _touchedSince;
+    std::chrono::steady_clock::time_point _refreshedAt;
+    bool _refreshed = false;
+
+    std::vector<Level> _bids;
+    std::vector<Level> _asks;
+    std::vector<std::uint8_t> _frames;
+};
+
+}}
+
+#endif // TRADING_PLATFORM_L2EX_DEPTH_FEED_H
@@ -3,6 +3,7 @@
 
 #include "trader/matching/market_manager.h"
 #include "trader/providers/nasdaq/itch_handler.h"
+#include "../../../aeron/logger.h"
 #include "../../../aeron/publisher.h"
 
 #define TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS 1
@@ -25,7 +26,7 @@ protected:
     bool onMessage(const ITCH::StockDirectoryMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         Matching::Symbol symbol(message.StockLocate, message.Stock);
         _market.AddSymbol(symbol);
@@ -37,7 +38,7 @@ protected:
     bool onMessage(const ITCH::AddOrderMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         Matching::Order order = Matching::Order::Limit(
             message.OrderReferenceNumber,
@@ -54,7 +55,7 @@ protected:
     bool onMessage(const ITCH::AddOrderMPIDMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         Matching::Order order = Matching::Order::Limit(
             message.OrderReferenceNumber,
@@ -71,7 +72,7 @@ protected:
     bool onMessage(const ITCH::OrderExecutedMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         _market.ExecuteOrder(message.OrderReferenceNumber, message.ExecutedShares);
         publishMessage(message);
@@ -81,7 +82,7 @@ protected:
     bool onMessage(const ITCH::OrderExecutedWithPriceMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         _market.ExecuteOrder(message.OrderReferenceNumber, message.ExecutionPrice, message.ExecutedShares);
         publishMessage(message);
@@ -91,7 +92,7 @@ protected:
     bool onMessage(const ITCH::OrderCancelMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         _market.ReduceOrder(message.OrderReferenceNumber, message.CanceledShares);
         publishMessage(message);
@@ -101,7 +102,7 @@ protected:
     bool onMessage(const ITCH::OrderDeleteMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         _market.DeleteOrder(message.OrderReferenceNumber);
         publishMessage(message);
@@ -111,7 +112,7 @@ protected:
     bool onMessage(const ITCH::OrderReplaceMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cout << "[ITCH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[ITCH] Message received: ", message);
 #endif
         _market.ReplaceOrder(message.OriginalOrderReferenceNumber, message.NewOrderReferenceNumber, message.Price, message.Shares);
         publishMessage(message);
@@ -121,7 +122,7 @@ protected:
     bool onMessage(const ITCH::UnknownMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_ITCH_HANDLER_PRINT_LOGS
-        std::cerr << "[ITCH] Unknown message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::ERROR, "[ITCH] Unknown message received: ", message.Type);
 #endif
         return true;
     }
@@ -132,18 +133,13 @@ private:
     void publishMessage(const Message &message)
     {
         if (_publisher)
-        {
-            auto length = message.serialize(_messageSerialized, sizeof(_messageSerialized));
-            if (length > 0)
-                _publisher->publish(_messageSerialized, length);
-        }
+            _publisher->publishMessage(message);
     }
 
 private:
 
     Matching::MarketManager &_market;
     Aeron::Publisher *_publisher;
-    uint8_t _messageSerialized[1024];
 };
 
 }}
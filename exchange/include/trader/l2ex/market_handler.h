@@ -1,255 +1,203 @@
 #ifndef TRADING_PLATFORM_L2EX_MARKET_HANDLER_H
 #define TRADING_PLATFORM_L2EX_MARKET_HANDLER_H
 
+#include "trader/l2ex/depth_feed.h"
+#include "trader/l2ex/timestamp.h"
+#include "trader/matching/batch_market_handler.h"
 #include "trader/matching/market_manager.h"
 #include "trader/providers/nasdaq/itch_handler.h"
 #include "trader/providers/nasdaq/ouch_handler.h"
+#include "../../../aeron/logger.h"
+#include "../../../aeron/publisher.h"
 
 #define TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS 1
 
 namespace TradingPlatform {
 namespace L2ex {
 
-class MarketHandler : public Matching::MarketHandler
+/** Depth feed published through the Aeron publisher. */
+typedef BasicDepthFeed<Aeron::Publisher> DepthFeed;
+
+/**
+ * L2ex market handler receives all market events of one market manager command
+ * as a batch and publishes the whole outcome of the command (order accepted,
+ * all its executions, etc.) as one contiguous block of ITCH and OUCH frames,
+ * so publishers offer it to Aeron driver at once. All messages of the command
+ * share the same timestamp. Level events are passed to the depth feed, which
+ * publishes conflated top of the book updates.
+ */
+class MarketHandler : public Matching::BatchMarketHandler
 {
 public:
 
     MarketHandler(Aeron::Publisher *itchPublisher = nullptr, Aeron::Publisher *ouchPublisher = nullptr)
-        : Matching::MarketHandler()
+        : Matching::BatchMarketHandler()
         , _itchPublisher(itchPublisher)
         , _ouchPublisher(ouchPublisher)
     {
     }
 
-protected:
+    /** Attaches the depth feed of the market manager. */
+    void setDepthFeed(DepthFeed *depthFeed) { _depthFeed = depthFeed; }
 
-    /////////////////////////////////////////////
-    // Symbol handlers
-    /////////////////////////////////////////////
+protected:
 
-    void onAddSymbol(const Matching::Symbol &symbol) override
+    void onMarketEvents(const Matching::MarketEvent *events, size_t size) override
     {
 #ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Add symbol: " << symbol << std::endl;
+        for (size_t i = 0; i < size; ++i)
+            Aeron::Logger::log(isBookEvent(events[i]) ? Aeron::LogLevel::INFO : Aeron::LogLevel::DEBUG, "[L2MM] Market event: ", events[i]);
 #endif
+        const uint64_t timestamp = Timestamp::nanosecondsSinceMidnight();
         if (_itchPublisher)
-        {
-            ITCH::StockDirectoryMessage message = {};
-            // TODO: Fill message properly
-            publishMessageITCH(message);
-        }
+            publishEvents(*_itchPublisher, events, size, timestamp, &MarketHandler::serializeITCH);
+        if (_ouchPublisher)
+            publishEvents(*_ouchPublisher, events, size, timestamp, &MarketHandler::serializeOUCH);
+        if (_depthFeed)
+            _depthFeed->onMarketEvents(events, size);
     }
 
-    void onDeleteSymbol(const Matching::Symbol &symbol) override
-    {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Delete symbol: " << symbol << std::endl;
-#endif
-        if (_itchPublisher)
-        {
-            ITCH::StockDirectoryMessage message = {};
-            // TODO: Fill message properly
-            publishMessageITCH(message);
-        }
-    }
+private:
 
-    /////////////////////////////////////////////
-    // Order book handlers
-    /////////////////////////////////////////////
+    // Serializes frames of the event into the buffer and returns their size (only counts the size if the buffer is nullptr)
+    using Serializer = size_t (*)(std::uint8_t *buffer, const Matching::MarketEvent &event, uint64_t timestamp);
 
-    void onAddOrderBook(const Matching::OrderBook &order_book) override
+    static bool isBookEvent(const Matching::MarketEvent &event)
     {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Add order book: " << order_book << std::endl;
-#endif
-        if (_itchPublisher)
-        {
-            ITCH::StockDirectoryMessage message = {};
-            // TODO: Fill message properly
-            //publishMessageITCH(message);
-        }
+        return (event.Type <= Matching::MarketEventType::DELETE_ORDER_BOOK) && (event.Type != Matching::MarketEventType::UPDATE_ORDER_BOOK);
     }
 
-    void onUpdateOrderBook(const Matching::OrderBook &order_book, bool top) override
+    // Serialize frames of all events into one publisher region
+    static void publishEvents(Aeron::Publisher &publisher, const Matching::MarketEvent *events, size_t size, uint64_t timestamp, Serializer serializer)
     {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Update order book: " << order_book << (top ? " - Top of the book!" : "") << std::endl;
-#endif
-        if (_itchPublisher)
-        {
-            ITCH::StockDirectoryMessage message = {};
-            // TODO: Fill message properly
-            //publishMessageITCH(message);
-        }
-    }
+        size_t total = 0;
+        for (size_t i = 0; i < size; ++i)
+            total += serializer(nullptr, events[i], timestamp);
+        if (total == 0)
+            return;
 
-    void onDeleteOrderBook(const Matching::OrderBook &order_book) override
-    {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Delete order book: " << order_book << std::endl;
-#endif
-        if (_itchPublisher)
+        // Fall back to frame by frame publishing if the block does not fit into one Aeron message
+        if (total > publisher.messageSize())
         {
-            ITCH::StockDirectoryMessage message = {};
-            // TODO: Fill message properly
-            //publishMessageITCH(message);
+            for (size_t i = 0; i < size; ++i)
+            {
+                std::uint8_t frame[Aeron::Publisher::FRAME_HEADER_SIZE + MAX_MESSAGE_SIZE];
+                size_t bytes = serializer(frame, events[i], timestamp);
+                if (bytes > 0)
+                    publisher.publish(frame, bytes);
+            }
+            return;
         }
-    }
 
-    /////////////////////////////////////////////
-    // Price level handlers
-    /////////////////////////////////////////////
-
-    void onAddLevel(const Matching::OrderBook &order_book, const Matching::Level &level, bool top) override
-    {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Add level: " << level << (top ? " - Top of the book!" : "") << std::endl;
-#endif
+        std::uint8_t *region = publisher.claim(total);
+        if (region == nullptr)
+            return;
+        size_t offset = 0;
+        for (size_t i = 0; i < size; ++i)
+            offset += serializer(region + offset, events[i], timestamp);
+        publisher.commit(total);
     }
 
-    void onUpdateLevel(const Matching::OrderBook &order_book, const Matching::Level &level, bool top) override
+    template <class Message>
+    static size_t serializeFrame(std::uint8_t *buffer, const Message &message)
     {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Update level: " << level << (top ? " - Top of the book!" : "") << std::endl;
-#endif
+        static_assert(Message::SIZE <= MAX_MESSAGE_SIZE, "Message is too big for the frame buffer!");
+        if (buffer)
+            Aeron::Publisher::serializeFrame(buffer, message);
+        return Aeron::Publisher::FRAME_HEADER_SIZE + Message::SIZE;
     }
 
-    void onDeleteLevel(const Matching::OrderBook &order_book, const Matching::Level &level, bool top) override
+    static size_t serializeITCH(std::uint8_t *buffer, const Matching::MarketEvent &event, uint64_t timestamp)
     {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Delete level: " << level << (top ? " - Top of the book!" : "") << std::endl;
-#endif
-    }
-
-    /////////////////////////////////////////////
-    // Order handlers
-    /////////////////////////////////////////////
-
-    void onAddOrder(const Matching::Order &order) override
-    {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Add order: " << order << std::endl;
-#endif
-        if (_itchPublisher)
+        switch (event.Type)
         {
-            ITCH::AddOrderMessage message = {};
-            message.Type = 'A';
-            message.Timestamp = nanosecondsSinceMidnight();
-            message.OrderReferenceNumber = order.Id;
-            message.BuySellIndicator = (order.Side == Matching::OrderSide::BUY ? 'B' : 'S');
-            message.Shares = static_cast<uint32_t>(order.Quantity);
-            message.Price = static_cast<uint32_t>(order.Price);
-            publishMessageITCH(message);
+            case Matching::MarketEventType::ADD_SYMBOL:
+            case Matching::MarketEventType::DELETE_SYMBOL:
+            {
+                ITCH::StockDirectoryMessage message = {};
+                // TODO: Fill message properly
+                return serializeFrame(buffer, message);
+            }
+            case Matching::MarketEventType::ADD_ORDER:
+            {
+                ITCH::AddOrderMessage message = {};
+                message.Type = 'A';
+                message.Timestamp = timestamp;
+                message.OrderReferenceNumber = event.Id;
+                message.BuySellIndicator = (event.Side == Matching::OrderSide::BUY ? 'B' : 'S');
+                message.Shares = static_cast<uint32_t>(event.Quantity);
+                message.Price = static_cast<uint32_t>(event.Price);
+                return serializeFrame(buffer, message);
+            }
+            case Matching::MarketEventType::EXECUTE_ORDER:
+            {
+                ITCH::OrderExecutedMessage message = {};
+                message.Type = 'P';
+                message.Timestamp = timestamp;
+                message.OrderReferenceNumber = event.Id;
+                message.ExecutedShares = static_cast<uint32_t>(event.Quantity);
+                return serializeFrame(buffer, message);
+            }
+            default:
+                return 0;
         }
-        if (_ouchPublisher)
-        {
-            OUCH::OrderAcceptedMessage message = {};
-            message.Type = 'A';
-            message.Timestamp = nanosecondsSinceMidnight();
-            message.OrderToken = static_cast<uint32_t>(order.Id);
-            message.OrderVerb = (order.Side == Matching::OrderSide::BUY ? 'B' : 'S');
-            message.Shares = order.Quantity;
-            message.Price = static_cast<uint32_t>(order.Price);
-            message.OrderReferenceNumber = order.Id;
-            message.OrderState = 'L';
-            publishMessageOUCH(message);
-        }
-    }
-
-    void onUpdateOrder(const Matching::Order &order) override
-    {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Update order: " << order << std::endl;
-#endif
     }
 
-    void onDeleteOrder(const Matching::Order &order) override
+    static size_t serializeOUCH(std::uint8_t *buffer, const Matching::MarketEvent &event, uint64_t timestamp)
     {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Delete order: " << order << std::endl;
-#endif
-    }
-
-    /////////////////////////////////////////////
-    // Order execution handler
-    /////////////////////////////////////////////
-
-    void onExecuteOrder(const Matching::Order &order, uint64_t price, uint64_t quantity) override
-    {
-#ifdef TRADING_PLATFORM_L2EX_MARKET_PRINT_LOGS
-        std::cout << "[L2MM] Execute order: " << order << " with price " << price << " and quantity " << quantity << std::endl;
-#endif
-        if (_itchPublisher)
+        switch (event.Type)
         {
-            ITCH::OrderExecutedMessage message = {};
-            message.Type = 'P';
-            message.Timestamp = nanosecondsSinceMidnight();
-            message.OrderReferenceNumber = order.Id;
-            message.ExecutedShares = static_cast<uint32_t>(quantity);
-            publishMessageITCH(message);
-        }
-        if (_ouchPublisher)
-        {
-            OUCH::OrderExecutedMessage message = {};
-            message.Type = 'E';
-            message.Timestamp = nanosecondsSinceMidnight();
-            message.OrderToken = static_cast<uint32_t>(order.Id);
-            message.ExecutedShares = order.Quantity;
-            message.ExecutedPrice = static_cast<uint32_t>(order.Price);
-            publishMessageOUCH(message);
+            case Matching::MarketEventType::ADD_ORDER:
+            {
+                OUCH::OrderAcceptedMessage message = {};
+                message.Type = 'A';
+                message.Timestamp = timestamp;
+                message.OrderToken = static_cast<uint32_t>(event.Id);
+                message.OrderVerb = (event.Side == Matching::OrderSide::BUY ? 'B' : 'S');
+                message.Shares = event.Quantity;
+                message.Price = static_cast<uint32_t>(event.Price);
+                message.OrderReferenceNumber = event.Id;
+                message.OrderState = 'L';
+                return serializeFrame(buffer, message);
+            }
+            case Matching::MarketEventType::EXECUTE_ORDER:
+            {
+                OUCH::OrderExecutedMessage message = {};
+                message.Type = 'E';
+                message.Timestamp = timestamp;
+                message.OrderToken = static_cast<uint32_t>(event.Id);
+                message.ExecutedShares = event.Quantity;
+                message.ExecutedPrice = static_cast<uint32_t>(event.Price);
+                return serializeFrame(buffer, message);
+            }
+            case Matching::MarketEventType::DELETE_ORDER:
+            {
+                // Fully executed orders are done with their last execution
+                if (event.LeavesQuantity == 0)
+                    return 0;
+
+                OUCH::OrderCanceledMessage message = {};
+                message.Type = 'C';
+                message.Timestamp = timestamp;
+                message.OrderToken = static_cast<uint32_t>(event.Id);
+                message.Shares = event.LeavesQuantity;
+                message.Reason = (event.OrderType == Matching::OrderType::MARKET) ? 'I' : 'U';
+                return serializeFrame(buffer, message);
+            }
+            default:
+                return 0;
         }
     }
 
 private:
 
-    template <class Message>
-    void publishMessageITCH(const Message &message)
-    {
-        if (!_itchPublisher)
-            return;
-        auto length = message.serialize(_messageSerialized + 2, sizeof(_messageSerialized) - 2);
-        if (length > 0)
-        {
-            CppCommon::Endian::WriteBigEndian(_messageSerialized, static_cast<uint16_t>(length));
-            _itchPublisher->publish(_messageSerialized, length + 2);
-        }
-    }
-
-    template <class Message>
-    void publishMessageOUCH(const Message &message)
-    {
-        if (!_ouchPublisher)
-            return;
-        auto length = message.serialize(_messageSerialized + 2, sizeof(_messageSerialized) - 2);
-        if (length > 0)
-        {
-            CppCommon::Endian::WriteBigEndian(_messageSerialized, static_cast<uint16_t>(length));
-            _ouchPublisher->publish(_messageSerialized, length + 2);
-        }
-    }
-
-    std::chrono::system_clock::duration durationSinceMidnight() {
-        auto now = std::chrono::system_clock::now();
-        time_t tnow = std::chrono::system_clock::to_time_t(now);
-        tm *date = std::localtime(&tnow);
-        date->tm_hour = 0;
-        date->tm_min = 0;
-        date->tm_sec = 0;
-        auto midnight = std::chrono::system_clock::from_time_t(std::mktime(date));
-        return now - midnight;
-    }
-
-    uint64_t nanosecondsSinceMidnight() {
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(durationSinceMidnight()).count();
-    }
-
-private:
+    static const size_t MAX_MESSAGE_SIZE = 256;
 
     Aeron::Publisher *_itchPublisher;
     Aeron::Publisher *_ouchPublisher;
-    uint8_t _messageSerialized[1024];
+    DepthFeed *_depthFeed = nullptr;
 };
 
 }}
 
-#endif // TRADING_PLATFORM_L2EX_MARKET_HANDLER_H
\ No newline at end of file
+#endif // TRADING_PLATFORM_L2EX_MARKET_HANDLER_H
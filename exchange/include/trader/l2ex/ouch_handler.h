@@ -1,8 +1,10 @@
 #ifndef TRADING_PLATFORM_L2EX_OUCH_HANDLER_H
 #define TRADING_PLATFORM_L2EX_OUCH_HANDLER_H
 
+#include "trader/l2ex/timestamp.h"
 #include "trader/matching/market_manager.h"
 #include "trader/providers/nasdaq/ouch_handler.h"
+#include "../../../aeron/logger.h"
 #include "../../../aeron/publisher.h"
 
 #define TRADING_PLATFORM_L2EX_OUCH_HANDLER_PRINT_LOGS 1
@@ -25,7 +27,7 @@ protected:
     bool onMessage(const OUCH::EnterOrderMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_OUCH_HANDLER_PRINT_LOGS
-        std::cout << "[OUTH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[OUTH] Message received: ", message);
 #endif
         uint64_t orderId = message.OrderToken;
         if (message.Price == 0x7fffffff)
@@ -41,9 +43,9 @@ protected:
             {
                 OUCH::OrderRejectedMessage rejected = {};
                 rejected.Type = 'J';
-                rejected.Timestamp = nanosecondsSinceMidnight();
+                rejected.Timestamp = Timestamp::nanosecondsSinceMidnight();
                 rejected.OrderToken = message.OrderToken;
-                rejected.Reason = 'W'; // TODO
+                rejected.Reason = rejectReason(error);
                 publishMessage(rejected);
                 return false;
             }
@@ -62,9 +64,9 @@ protected:
             {
                 OUCH::OrderRejectedMessage rejected = {};
                 rejected.Type = 'J';
-                rejected.Timestamp = nanosecondsSinceMidnight();
+                rejected.Timestamp = Timestamp::nanosecondsSinceMidnight();
                 rejected.OrderToken = message.OrderToken;
-                rejected.Reason = 'W'; // TODO
+                rejected.Reason = rejectReason(error);
                 publishMessage(rejected);
                 return false;
             }
@@ -75,10 +77,13 @@ protected:
     bool onMessage(const OUCH::ReplaceOrderMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_OUCH_HANDLER_PRINT_LOGS
-        std::cout << "[OUTH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[OUTH] Message received: ", message);
 #endif
         uint64_t existingOrderId = message.ExistingOrderToken;
         uint64_t replacementOrderId = message.ReplacementOrderToken;
+        // Orders of other market shards and done orders are not found here
+        if (_market.GetOrder(existingOrderId) == nullptr)
+            return false;
         auto error = _market.ReplaceOrder(existingOrderId, replacementOrderId, message.Price, message.Shares);
         if (error != Matching::ErrorCode::OK)
             return false;
@@ -88,9 +93,11 @@ protected:
     bool onMessage(const OUCH::CancelOrderMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_OUCH_HANDLER_PRINT_LOGS
-        std::cout << "[OUTH] Message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::DEBUG, "[OUTH] Message received: ", message);
 #endif
         uint64_t orderId = message.OrderToken;
+        if (_market.GetOrder(orderId) == nullptr)
+            return false;
         auto error = _market.DeleteOrder(orderId);
         if (error != Matching::ErrorCode::OK)
             return false;
@@ -100,47 +107,37 @@ protected:
     bool onMessage(const OUCH::UnknownMessage &message) override
     {
 #ifdef TRADING_PLATFORM_L2EX_OUCH_HANDLER_PRINT_LOGS
-        std::cerr << "[OUTH] Unknown message received: " << message << std::endl;
+        Aeron::Logger::log(Aeron::LogLevel::ERROR, "[OUTH] Unknown message received: ", message.Type);
 #endif
         return true;
     }
 
 private:
 
-    template <class Message>
-    void publishMessage(const Message &message)
+    // OUCH reject reason of the order refused by the market: 'S' is invalid order book, 'O' is other
+    static char rejectReason(Matching::ErrorCode error)
     {
-        if (_publisher)
+        switch (error)
         {
-            auto length = message.serialize(_messageSerialized + 2, sizeof(_messageSerialized) - 2);
-            if (length > 0)
-            {
-                CppCommon::Endian::WriteBigEndian(_messageSerialized, static_cast<uint16_t>(length));
-                _publisher->publish(_messageSerialized, length + 2);
-            }
+            case Matching::ErrorCode::SYMBOL_NOT_FOUND:
+            case Matching::ErrorCode::ORDER_BOOK_NOT_FOUND:
+                return 'S';
+            default:
+                return 'O';
         }
     }
 
-    std::chrono::system_clock::duration durationSinceMidnight() {
-        auto now = std::chrono::system_clock::now();
-        time_t tnow = std::chrono::system_clock::to_time_t(now);
-        tm *date = std::localtime(&tnow);
-        date->tm_hour = 0;
-        date->tm_min = 0;
-        date->tm_sec = 0;
-        auto midnight = std::chrono::system_clock::from_time_t(std::mktime(date));
-        return now - midnight;
-    }
-
-    uint64_t nanosecondsSinceMidnight() {
-        return std::chrono::duration_cast<std::chrono::nanoseconds>(durationSinceMidnight()).count();
+    template <class Message>
+    void publishMessage(const Message &message)
+    {
+        if (_publisher)
+            _publisher->publishMessage(message);
     }
 
 private:
 
     Matching::MarketManager &_market;
     Aeron::Publisher *_publisher;
-    uint8_t _messageSerialized[1024];
 };
 
 }}
@@ -0,0 +1,178 @@
+#ifndef TRADING_PLATFORM_L2EX_TIMESTAMP_H
+#define TRADING_PLATFORM_L2EX_TIMESTAMP_H
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRADING_PLATFORM_L2EX_TIMESTAMP_TSC 1
+#endif
+
+namespace TradingPlatform {
+namespace L2ex {
+
+enum class TimestampSource
+{
+    REALTIME,           // clock_gettime(CLOCK_REALTIME)
+    REALTIME_COARSE,    // clock_gettime(CLOCK_REALTIME_COARSE), tick resolution but few nanoseconds to read
+    TSC,                // rdtsc calibrated against CLOCK_REALTIME
+};
+
+/**
+ * Timestamp service of L2ex handlers.
+ *
+ * ITCH and OUCH messages carry nanoseconds since the local midnight. The midnight
+ * epoch is computed once per day and cached per thread together with the next
+ * midnight epoch, so the rollover is detected with a single comparison and the
+ * tz lock of localtime_r()/mktime() is taken only once a day.
+ *
+ * The clock source is selected once on startup before matching threads are
+ * started. With the TSC source the cycle rate is calibrated against the wall
+ * clock on selection, and every thread re-anchors its TSC origin to the wall
+ * clock on each midnight rollover to bound the drift.
+ *
+ * Timestamps returned to the same thread never go backwards, so handlers take
+ * one timestamp per matching event and share it between ITCH and OUCH messages.
+ */
+class Timestamp
+{
+public:
+    /** Selects the clock source. Must be called before timestamps are taken by other threads. */
+    static void setSource(TimestampSource source)
+    {
+#ifndef TRADING_PLATFORM_L2EX_TIMESTAMP_TSC
+        if (source == TimestampSource::TSC)
+            source = TimestampSource::REALTIME;
+#else
+        if (source == TimestampSource::TSC)
+            calibrate();
+#endif
+        sourceRef().store(source, std::memory_order_release);
+    }
+
+    static TimestampSource source()
+    {
+        return sourceRef().load(std::memory_order_relaxed);
+    }
+
+    /** Nanoseconds since the local midnight of the current day. */
+    static std::uint64_t nanosecondsSinceMidnight()
+    {
+        State &state = stateRef();
+        std::uint64_t now = nanoseconds(state);
+        if ((now >= state.nextMidnight) || (now < state.midnight))
+        {
+            rollover(state, now);
+            now = nanoseconds(state);
+        }
+        if (now < state.last)
+            now = state.last;
+        state.last = now;
+        return now - state.midnight;
+    }
+
+private:
+    struct State
+    {
+        std::uint64_t midnight = 0;
+        std::uint64_t nextMidnight = 0;
+        std::uint64_t last = 0;
+        std::uint64_t tsc = 0;
+        std::uint64_t tscNanoseconds = 0;
+    };
+
+    static std::atomic<TimestampSource> &sourceRef()
+    {
+        static std::atomic<TimestampSource> source(TimestampSource::REALTIME);
+        return source;
+    }
+
+    static State &stateRef()
+    {
+        static thread_local State state;
+        return state;
+    }
+
+    // Nanoseconds per TSC cycle
+    static double &tscRate()
+    {
+        static double rate = 0.0;
+        return rate;
+    }
+
+    static std::uint64_t clock(clockid_t id)
+    {
+        struct timespec ts;
+        ::clock_gettime(id, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000 + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    static std::uint64_t nanoseconds(const State &state)
+    {
+        switch (source())
+        {
+#ifdef CLOCK_REALTIME_COARSE
+            case TimestampSource::REALTIME_COARSE:
+                return clock(CLOCK_REALTIME_COARSE);
+#endif
+#ifdef TRADING_PLATFORM_L2EX_TIMESTAMP_TSC
+            case TimestampSource::TSC:
+                // Thread is not anchored yet, so force the rollover
+                if (state.tsc == 0)
+                    return UINT64_MAX;
+                return state.tscNanoseconds + static_cast<std::uint64_t>(static_cast<double>(__rdtsc() - state.tsc) * tscRate());
+#endif
+            default:
+                return clock(CLOCK_REALTIME);
+        }
+    }
+
+    static void rollover(State &state, std::uint64_t now)
+    {
+        // Re-anchor TSC to the wall clock
+        if (source() == TimestampSource::TSC)
+        {
+#ifdef TRADING_PLATFORM_L2EX_TIMESTAMP_TSC
+            state.tsc = __rdtsc();
+            state.tscNanoseconds = clock(CLOCK_REALTIME);
+            now = state.tscNanoseconds;
+#endif
+        }
+
+        time_t seconds = static_cast<time_t>(now / 1000000000);
+        struct tm date;
+        ::localtime_r(&seconds, &date);
+        date.tm_hour = 0;
+        date.tm_min = 0;
+        date.tm_sec = 0;
+        date.tm_isdst = -1;
+        state.midnight = static_cast<std::uint64_t>(std::mktime(&date)) * 1000000000;
+        date.tm_mday += 1;
+        date.tm_isdst = -1;
+        state.nextMidnight = static_cast<std::uint64_t>(std::mktime(&date)) * 1000000000;
+
+        // Timestamps are monotonic within the day
+        state.last = state.midnight;
+    }
+
+#ifdef TRADING_PLATFORM_L2EX_TIMESTAMP_TSC
+    static void calibrate()
+    {
+        const std::uint64_t tsc1 = __rdtsc();
+        const std::uint64_t ns1 = clock(CLOCK_MONOTONIC_RAW);
+        std::uint64_t ns2;
+        do
+        {
+            ns2 = clock(CLOCK_MONOTONIC_RAW);
+        } while (ns2 - ns1 < 10000000);
+        const std::uint64_t tsc2 = __rdtsc();
+        tscRate() = static_cast<double>(ns2 - ns1) / static_cast<double>(tsc2 - tsc1);
+    }
+#endif
+};
+
+}}
+
+#endif // TRADING_PLATFORM_L2EX_TIMESTAMP_H
@@ -0,0 +1,139 @@
+/*!
+    \file batch_market_handler.h
+    \brief Batch market handler definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_BATCH_MARKET_HANDLER_H
+#define TRADING_PLATFORM_MATCHING_BATCH_MARKET_HANDLER_H
+
+#include "market_handler.h"
+
+#include <vector>
+
+namespace TradingPlatform {
+namespace Matching {
+
+//! Market event type
+enum class MarketEventType : uint8_t
+{
+    ADD_SYMBOL,
+    DELETE_SYMBOL,
+    ADD_ORDER_BOOK,
+    UPDATE_ORDER_BOOK,
+    DELETE_ORDER_BOOK,
+    ADD_LEVEL,
+    UPDATE_LEVEL,
+    DELETE_LEVEL,
+    ADD_ORDER,
+    UPDATE_ORDER,
+    DELETE_ORDER,
+    EXECUTE_ORDER
+};
+template <class TOutputStream>
+TOutputStream& operator<<(TOutputStream& stream, MarketEventType type);
+
+//! Market event
+/*!
+    Compact POD record of a single market handler callback. Meaning of the
+    value fields depends on the event type:
+    \li Order events - order Id, price, quantity, leaves and executed quantity
+    \li Execution events - order Id, execution price, executed quantity, order leaves and executed quantity
+    \li Level events - level price, total volume, visible volume and orders count
+    \li Symbol and order book events - symbol Id only
+*/
+struct MarketEvent
+{
+    //! Event type
+    MarketEventType Type;
+    //! Order side (level events use BUY for bid levels and SELL for ask levels)
+    OrderSide Side;
+    //! Order type
+    Matching::OrderType OrderType;
+    //! Top of the book flag
+    bool Top;
+    //! Symbol Id
+    uint32_t SymbolId;
+    //! Order Id
+    uint64_t Id;
+    //! Order, execution or level price
+    uint64_t Price;
+    //! Order quantity, executed quantity or level total volume
+    uint64_t Quantity;
+    //! Order leaves quantity or level visible volume
+    uint64_t LeavesQuantity;
+    //! Order executed quantity or level orders count
+    uint64_t ExecutedQuantity;
+
+    template <class TOutputStream>
+    friend TOutputStream& operator<<(TOutputStream& stream, const MarketEvent& event);
+};
+
+//! Batch market handler
+/*!
+    Batch market handler collects market events of a single market manager
+    command (add, modify, delete or execute order, matching, etc.) into one
+    contiguous vector of compact event records and passes them into the
+    onMarketEvents() handler at the end of the command. The whole matching
+    outcome of the command could be processed or published at once instead of
+    a virtual call per each event.
+
+    Not thread-safe.
+*/
+class BatchMarketHandler : public MarketHandler
+{
+public:
+    //! Initialize the batch market handler with the given events capacity
+    explicit BatchMarketHandler(size_t capacity = 1024) { _events.reserve(capacity); }
+    BatchMarketHandler(const BatchMarketHandler&) = delete;
+    BatchMarketHandler(BatchMarketHandler&&) noexcept = default;
+    ~BatchMarketHandler() = default;
+
+    BatchMarketHandler& operator=(const BatchMarketHandler&) = delete;
+    BatchMarketHandler& operator=(BatchMarketHandler&&) noexcept = default;
+
+protected:
+    // Market events handler
+    virtual void onMarketEvents(const MarketEvent* events, size_t size) {}
+
+    // Symbol handlers
+    void onAddSymbol(const Symbol& symbol) final { Push(MarketEventType::ADD_SYMBOL, symbol); }
+    void onDeleteSymbol(const Symbol& symbol) final { Push(MarketEventType::DELETE_SYMBOL, symbol); }
+
+    // Order book handlers
+    void onAddOrderBook(const OrderBook& order_book) final { Push(MarketEventType::ADD_ORDER_BOOK, order_book.symbol()); }
+    void onUpdateOrderBook(const OrderBook& order_book, bool top) final { Push(MarketEventType::UPDATE_ORDER_BOOK, order_book.symbol()).Top = top; }
+    void onDeleteOrderBook(const OrderBook& order_book) final { Push(MarketEventType::DELETE_ORDER_BOOK, order_book.symbol()); }
+
+    // Price level handlers
+    void onAddLevel(const OrderBook& order_book, const Level& level, bool top) final { Push(MarketEventType::ADD_LEVEL, order_book, level, top); }
+    void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) final { Push(MarketEventType::UPDATE_LEVEL, order_book, level, top); }
+    void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) final { Push(MarketEventType::DELETE_LEVEL, order_book, level, top); }
+
+    // Order handlers
+    void onAddOrder(const Order& order) final { Push(MarketEventType::ADD_ORDER, order); }
+    void onUpdateOrder(const Order& order) final { Push(MarketEventType::UPDATE_ORDER, order); }
+    void onDeleteOrder(const Order& order) final { Push(MarketEventType::DELETE_ORDER, order); }
+
+    // Order execution handlers
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) final;
+
+    // Market events flush handler
+    void onFlush() final;
+
+private:
+    std::vector<MarketEvent> _events;
+
+    MarketEvent& Push(MarketEventType type, const Symbol& symbol);
+    MarketEvent& Push(MarketEventType type, const OrderBook& order_book, const Level& level, bool top);
+    MarketEvent& Push(MarketEventType type, const Order& order);
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#include "batch_market_handler.inl"
+
+#endif // TRADING_PLATFORM_MATCHING_BATCH_MARKET_HANDLER_H
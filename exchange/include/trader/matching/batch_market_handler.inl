@@ -0,0 +1,115 @@
+/*!
+    \file batch_market_handler.inl
+    \brief Batch market handler inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace Matching {
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, MarketEventType type)
+{
+    switch (type)
+    {
+        case MarketEventType::ADD_SYMBOL:
+            return stream << "ADD-SYMBOL";
+        case MarketEventType::DELETE_SYMBOL:
+            return stream << "DELETE-SYMBOL";
+        case MarketEventType::ADD_ORDER_BOOK:
+            return stream << "ADD-ORDER-BOOK";
+        case MarketEventType::UPDATE_ORDER_BOOK:
+            return stream << "UPDATE-ORDER-BOOK";
+        case MarketEventType::DELETE_ORDER_BOOK:
+            return stream << "DELETE-ORDER-BOOK";
+        case MarketEventType::ADD_LEVEL:
+            return stream << "ADD-LEVEL";
+        case MarketEventType::UPDATE_LEVEL:
+            return stream << "UPDATE-LEVEL";
+        case MarketEventType::DELETE_LEVEL:
+            return stream << "DELETE-LEVEL";
+        case MarketEventType::ADD_ORDER:
+            return stream << "ADD-ORDER";
+        case MarketEventType::UPDATE_ORDER:
+            return stream << "UPDATE-ORDER";
+        case MarketEventType::DELETE_ORDER:
+            return stream << "DELETE-ORDER";
+        case MarketEventType::EXECUTE_ORDER:
+            return stream << "EXECUTE-ORDER";
+        default:
+            return stream << "<unknown>";
+    }
+}
+
+template <class TOutputStream>
+inline TOutputStream& operator<<(TOutputStream& stream, const MarketEvent& event)
+{
+    stream << "MarketEvent(Type=" << event.Type
+        << "; SymbolId=" << event.SymbolId
+        << "; Id=" << event.Id
+        << "; Price=" << event.Price
+        << "; Quantity=" << event.Quantity
+        << "; LeavesQuantity=" << event.LeavesQuantity
+        << "; ExecutedQuantity=" << event.ExecutedQuantity
+        << (event.Top ? "; Top" : "")
+        << ")";
+    return stream;
+}
+
+inline MarketEvent& BatchMarketHandler::Push(MarketEventType type, const Symbol& symbol)
+{
+    _events.push_back(MarketEvent());
+    MarketEvent& event = _events.back();
+    event.Type = type;
+    event.SymbolId = symbol.Id;
+    return event;
+}
+
+inline MarketEvent& BatchMarketHandler::Push(MarketEventType type, const OrderBook& order_book, const Level& level, bool top)
+{
+    MarketEvent& event = Push(type, order_book.symbol());
+    event.Side = level.IsBid() ? OrderSide::BUY : OrderSide::SELL;
+    event.Top = top;
+    event.Price = level.Price;
+    event.Quantity = level.TotalVolume;
+    event.LeavesQuantity = level.VisibleVolume;
+    event.ExecutedQuantity = level.Orders;
+    return event;
+}
+
+inline MarketEvent& BatchMarketHandler::Push(MarketEventType type, const Order& order)
+{
+    _events.push_back(MarketEvent());
+    MarketEvent& event = _events.back();
+    event.Type = type;
+    event.Side = order.Side;
+    event.OrderType = order.Type;
+    event.SymbolId = order.SymbolId;
+    event.Id = order.Id;
+    event.Price = order.Price;
+    event.Quantity = order.Quantity;
+    event.LeavesQuantity = order.LeavesQuantity;
+    event.ExecutedQuantity = order.ExecutedQuantity;
+    return event;
+}
+
+inline void BatchMarketHandler::onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity)
+{
+    MarketEvent& event = Push(MarketEventType::EXECUTE_ORDER, order);
+    event.Price = price;
+    event.Quantity = quantity;
+}
+
+inline void BatchMarketHandler::onFlush()
+{
+    if (_events.empty())
+        return;
+
+    onMarketEvents(_events.data(), _events.size());
+    _events.clear();
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
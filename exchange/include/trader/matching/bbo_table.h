@@ -0,0 +1,137 @@
+/*!
+    \file bbo_table.h
+    \brief Best bid and offer shared memory table definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_BBO_TABLE_H
+#define TRADING_PLATFORM_MATCHING_BBO_TABLE_H
+
+#include "order_book.h"
+
+#include "system/shared_memory.h"
+
+#include <atomic>
+#include <string>
+
+namespace TradingPlatform {
+namespace Matching {
+
+//! Best bid and offer of the symbol
+struct BBO
+{
+    //! Best bid price (zero if there are no bids)
+    uint64_t BidPrice;
+    //! Best bid visible volume
+    uint64_t BidVolume;
+    //! Best ask price (zero if there are no asks)
+    uint64_t AskPrice;
+    //! Best ask visible volume
+    uint64_t AskVolume;
+    //! Best bid orders count
+    uint32_t BidOrders;
+    //! Best ask orders count
+    uint32_t AskOrders;
+};
+
+//! Best bid and offer table
+/*!
+    Best bid and offer table keeps the top of the book of all symbols in a
+    named shared memory segment, so co-located processes read it directly
+    without subscribing to the market data feed.
+
+    Table consists of the header and one cache line sized record per symbol
+    indexed by symbol Id. Each record is protected by its own sequence lock:
+    the writer makes the sequence odd, updates the record and makes it even
+    again. Readers never block the writer. They copy the record and retry if
+    the sequence was odd or changed during the copy.
+
+    Market manager updates records of its order books when the top of the book
+    changes (see MarketManager::AttachBBOTable()). Several market managers could
+    share the same table if their symbols are different, because every record
+    must have only one writer.
+
+    Thread-safe for one writer per record and any number of readers.
+*/
+class BBOTable
+{
+public:
+    //! Table magic signature
+    static constexpr char MAGIC[8] = { 'L', '2', 'E', 'X', 'B', 'B', 'O', 'T' };
+    //! Table format version
+    static constexpr uint32_t VERSION = 1;
+
+    //! Create or open the table in the named shared memory segment
+    /*!
+        \param name - Shared memory segment name
+        \param capacity - Maximal count of symbols (symbol Id must be less than capacity)
+    */
+    BBOTable(const std::string& name, size_t capacity);
+    BBOTable(const BBOTable&) = delete;
+    BBOTable(BBOTable&&) = delete;
+    ~BBOTable() = default;
+
+    BBOTable& operator=(const BBOTable&) = delete;
+    BBOTable& operator=(BBOTable&&) = delete;
+
+    //! Get the shared memory segment name
+    const std::string& name() const noexcept { return _shared_memory.name(); }
+    //! Get the table capacity
+    size_t capacity() const noexcept { return _capacity; }
+    //! Is the table valid? (table created by an incompatible build is invalid)
+    bool valid() const noexcept { return _records != nullptr; }
+
+    //! Read the best bid and offer of the given symbol
+    /*!
+        \param id - Symbol Id
+        \param bbo - Best bid and offer to read
+        \return 'true' if the best bid and offer was read, 'false' if the symbol was never written or its writer stopped in the middle of the update
+    */
+    bool Read(uint32_t id, BBO& bbo) const noexcept;
+
+    //! Update the best bid and offer record from the order book
+    /*!
+        \param order_book - Order book
+    */
+    void Update(const OrderBook& order_book) noexcept;
+    //! Clear the best bid and offer record of the given symbol
+    /*!
+        \param id - Symbol Id
+    */
+    void Clear(uint32_t id) noexcept;
+
+private:
+    struct Header
+    {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t RecordSize;
+        uint64_t Capacity;
+        uint8_t Reserved[40];
+    };
+
+    struct alignas(64) Record
+    {
+        std::atomic<uint64_t> Sequence;
+        std::atomic<uint64_t> BidPrice;
+        std::atomic<uint64_t> BidVolume;
+        std::atomic<uint64_t> AskPrice;
+        std::atomic<uint64_t> AskVolume;
+        std::atomic<uint64_t> Orders;
+    };
+
+    CppCommon::SharedMemory _shared_memory;
+    Record* _records;
+    size_t _capacity;
+
+    void Write(uint32_t id, const BBO& bbo) noexcept;
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#include "bbo_table.inl"
+
+#endif // TRADING_PLATFORM_MATCHING_BBO_TABLE_H
@@ -0,0 +1,94 @@
+/*!
+    \file bbo_table.inl
+    \brief Best bid and offer shared memory table inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace Matching {
+
+inline bool BBOTable::Read(uint32_t id, BBO& bbo) const noexcept
+{
+    if ((_records == nullptr) || (id >= _capacity))
+        return false;
+
+    const Record& record = _records[id];
+
+    // Writer updates the record within a few stores, so the retry limit is reached only if it has died in the middle
+    for (size_t retry = 0; retry < 1024; ++retry)
+    {
+        uint64_t sequence1 = record.Sequence.load(std::memory_order_acquire);
+        if ((sequence1 & 1) != 0)
+            continue;
+
+        bbo.BidPrice = record.BidPrice.load(std::memory_order_relaxed);
+        bbo.BidVolume = record.BidVolume.load(std::memory_order_relaxed);
+        bbo.AskPrice = record.AskPrice.load(std::memory_order_relaxed);
+        bbo.AskVolume = record.AskVolume.load(std::memory_order_relaxed);
+        uint64_t orders = record.Orders.load(std::memory_order_relaxed);
+        bbo.BidOrders = (uint32_t)(orders >> 32);
+        bbo.AskOrders = (uint32_t)orders;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t sequence2 = record.Sequence.load(std::memory_order_relaxed);
+        if (sequence1 == sequence2)
+            return (sequence1 != 0);
+    }
+
+    return false;
+}
+
+inline void BBOTable::Write(uint32_t id, const BBO& bbo) noexcept
+{
+    if ((_records == nullptr) || (id >= _capacity))
+        return;
+
+    Record& record = _records[id];
+
+    // Start from the even sequence even if the previous writer has died in the middle of the update
+    uint64_t sequence = (record.Sequence.load(std::memory_order_relaxed) + 1) & ~(uint64_t)1;
+    record.Sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record.BidPrice.store(bbo.BidPrice, std::memory_order_relaxed);
+    record.BidVolume.store(bbo.BidVolume, std::memory_order_relaxed);
+    record.AskPrice.store(bbo.AskPrice, std::memory_order_relaxed);
+    record.AskVolume.store(bbo.AskVolume, std::memory_order_relaxed);
+    record.Orders.store(((uint64_t)bbo.BidOrders << 32) | bbo.AskOrders, std::memory_order_relaxed);
+
+    record.Sequence.store(sequence + 2, std::memory_order_release);
+}
+
+inline void BBOTable::Update(const OrderBook& order_book) noexcept
+{
+    BBO bbo = {};
+
+    const LevelNode* bid_ptr = order_book.best_bid();
+    if (bid_ptr != nullptr)
+    {
+        bbo.BidPrice = bid_ptr->Price;
+        bbo.BidVolume = bid_ptr->VisibleVolume;
+        bbo.BidOrders = (uint32_t)bid_ptr->Orders;
+    }
+
+    const LevelNode* ask_ptr = order_book.best_ask();
+    if (ask_ptr != nullptr)
+    {
+        bbo.AskPrice = ask_ptr->Price;
+        bbo.AskVolume = ask_ptr->VisibleVolume;
+        bbo.AskOrders = (uint32_t)ask_ptr->Orders;
+    }
+
+    Write(order_book.symbol().Id, bbo);
+}
+
+inline void BBOTable::Clear(uint32_t id) noexcept
+{
+    BBO bbo = {};
+    Write(id, bbo);
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
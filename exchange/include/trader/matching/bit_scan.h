@@ -0,0 +1,66 @@
+/*!
+    \file bit_scan.h
+    \brief Bit scan helper definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_BIT_SCAN_H
+#define TRADING_PLATFORM_MATCHING_BIT_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace TradingPlatform {
+namespace Matching {
+
+//! Bit scan helper
+/*!
+    Bit scan helper finds the lowest or the highest set bit of the integer
+    value with a single compiler intrinsic on GCC, Clang and MSVC.
+
+    Thread-safe.
+*/
+class BitScan
+{
+public:
+    BitScan() = delete;
+    BitScan(const BitScan&) = delete;
+    BitScan(BitScan&&) = delete;
+    ~BitScan() = delete;
+
+    BitScan& operator=(const BitScan&) = delete;
+    BitScan& operator=(BitScan&&) = delete;
+
+    //! Get the index of the lowest set bit
+    /*!
+        \param value - Integer value (must not be zero)
+        \return Index of the lowest set bit
+    */
+    static size_t Lowest(uint32_t value) noexcept;
+    //! Get the index of the lowest set bit
+    /*!
+        \param value - Integer value (must not be zero)
+        \return Index of the lowest set bit
+    */
+    static size_t Lowest(uint64_t value) noexcept;
+
+    //! Get the index of the highest set bit
+    /*!
+        \param value - Integer value (must not be zero)
+        \return Index of the highest set bit
+    */
+    static size_t Highest(uint64_t value) noexcept;
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#include "bit_scan.inl"
+
+#endif // TRADING_PLATFORM_MATCHING_BIT_SCAN_H
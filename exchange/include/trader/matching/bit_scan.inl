@@ -0,0 +1,58 @@
+/*!
+    \file bit_scan.inl
+    \brief Bit scan helper inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace Matching {
+
+inline size_t BitScan::Lowest(uint32_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+inline size_t BitScan::Lowest(uint64_t value) noexcept
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)value))
+        return index;
+    _BitScanForward(&index, (unsigned long)(value >> 32));
+    return index + 32;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+inline size_t BitScan::Highest(uint64_t value) noexcept
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanReverse(&index, (unsigned long)(value >> 32)))
+        return index + 32;
+    _BitScanReverse(&index, (unsigned long)value);
+    return index;
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
@@ -0,0 +1,244 @@
+/*!
+    \file flat_hash_map.h
+    \brief Flat hash map definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_FLAT_HASH_MAP_H
+#define TRADING_PLATFORM_MATCHING_FLAT_HASH_MAP_H
+
+#include "bit_scan.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace TradingPlatform {
+namespace Matching {
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+class FlatHashMapIterator;
+
+//! Flat hash map
+/*!
+    Flat hash map is an open-addressing hash map with Swiss table style
+    control bytes. Each slot has a control byte with 7 bits of the key hash
+    or an empty mark. Lookups compare a group of 16 control bytes at once
+    with SSE2 instructions (with a portable fallback) and touch the slots
+    storage only for matching candidates.
+
+    Slots are probed linearly starting from the home slot of the key hash.
+    Erased items are removed with backward shift deletion, so there are no
+    tombstones and lookups never slow down after many inserts and erases.
+
+    Large tables are allocated with mmap() and advised to be backed with
+    transparent huge pages to reduce TLB misses of random lookups.
+
+    The map has the same interface as CppCommon::HashMap for the used
+    operations, so both could be used as a market manager orders container.
+    Any erase or insert operation invalidates all iterators.
+
+    Not thread-safe.
+*/
+template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TEqual = std::equal_to<TKey>>
+class FlatHashMap
+{
+    friend class FlatHashMapIterator<TKey, TValue, THash, TEqual>;
+
+public:
+    // Standard container type definitions
+    typedef TKey key_type;
+    typedef TValue mapped_type;
+    typedef std::pair<TKey, TValue> value_type;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef FlatHashMapIterator<TKey, TValue, THash, TEqual> iterator;
+    typedef FlatHashMapIterator<TKey, TValue, THash, TEqual> const_iterator;
+
+    //! Size of the control bytes group probed at once
+    static constexpr size_t GROUP_SIZE = 16;
+    //! Minimal table size to be backed with huge pages
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    //! Initialize the hash map with a given capacity
+    /*!
+        \param capacity - Hash map capacity (default is 128)
+        \param blank - Blank key value (not used, kept for CppCommon::HashMap compatibility)
+        \param hash - Key hasher (default is THash())
+        \param equal - Key comparator (default is TEqual())
+    */
+    explicit FlatHashMap(size_t capacity = 128, const TKey& blank = TKey(), const THash& hash = THash(), const TEqual& equal = TEqual());
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap(FlatHashMap&& hashmap) noexcept;
+    ~FlatHashMap();
+
+    FlatHashMap& operator=(const FlatHashMap&) = delete;
+    FlatHashMap& operator=(FlatHashMap&& hashmap) noexcept;
+
+    //! Check if the hash map is not empty
+    explicit operator bool() const noexcept { return !empty(); }
+
+    //! Is the hash map empty?
+    bool empty() const noexcept { return _size == 0; }
+
+    //! Get the hash map size
+    size_t size() const noexcept { return _size; }
+    //! Get the hash map bucket count
+    size_t bucket_count() const noexcept { return _capacity; }
+    //! Is the hash map backed with huge pages?
+    bool huge() const noexcept { return _mapped; }
+
+    //! Get the begin hash map iterator
+    iterator begin() const noexcept;
+    //! Get the end hash map iterator
+    iterator end() const noexcept;
+
+    //! Find the iterator which points to the first item with the given key in the hash map or return end iterator
+    iterator find(const TKey& key) const noexcept;
+    //! Count items with the given key in the hash map
+    size_t count(const TKey& key) const noexcept { return (find(key) != end()) ? 1 : 0; }
+
+    //! Insert a new item into the hash map
+    /*!
+        \param item - Item to insert
+        \return Pair with the iterator to the inserted item and success flag
+    */
+    std::pair<iterator, bool> insert(const value_type& item);
+    //! Emplace a new item into the hash map
+    /*!
+        \param key - Item key
+        \param args - Item value arguments
+        \return Pair with the iterator to the emplaced item and success flag
+    */
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const TKey& key, Args&&... args);
+
+    //! Erase the item with the given key from the hash map
+    /*!
+        \param key - Key of the item to erase
+        \return Number of erased items
+    */
+    size_t erase(const TKey& key);
+    //! Erase the item by its iterator from the hash map
+    /*!
+        \param position - Iterator position to the erased item
+    */
+    void erase(const const_iterator& position);
+
+    //! Rehash the hash map to the given capacity or more
+    void rehash(size_t capacity);
+    //! Reserve the hash map capacity to fit the given count of items
+    void reserve(size_t count);
+
+    //! Clear the hash map
+    void clear() noexcept;
+
+    //! Swap two instances
+    void swap(FlatHashMap& hashmap) noexcept;
+    template <typename UKey, typename UValue, typename UHash, typename UEqual>
+    friend void swap(FlatHashMap<UKey, UValue, UHash, UEqual>& hashmap1, FlatHashMap<UKey, UValue, UHash, UEqual>& hashmap2) noexcept;
+
+private:
+    // Control byte of the empty slot
+    static constexpr uint8_t EMPTY = 0x80;
+
+    THash _hash;
+    TEqual _equal;
+    size_t _size;
+    size_t _capacity;
+    size_t _mask;
+    size_t _bytes;
+    bool _mapped;
+    uint8_t* _control;
+    value_type* _slots;
+
+    // Split the key hash into the home slot and 7-bit control value
+    static size_t H1(size_t hash) noexcept { return hash >> 7; }
+    static uint8_t H2(size_t hash) noexcept { return (uint8_t)(hash & 0x7F); }
+
+    // Match control bytes group with the given control value
+    static uint32_t Match(const uint8_t* group, uint8_t value) noexcept;
+    static uint32_t MatchEmpty(const uint8_t* group) noexcept;
+
+    // Set the control byte and its mirror after the end of the table
+    void SetControl(size_t index, uint8_t value) noexcept;
+
+    // Find the slot index of the given key or the capacity if not found
+    size_t FindIndex(const TKey& key, size_t hash) const noexcept;
+    // Find the first empty slot index starting from the given hash home slot
+    size_t FindEmpty(size_t hash) const noexcept;
+    // Erase the item in the given slot index with backward shift
+    void EraseIndex(size_t index);
+
+    // Allocate and release the table
+    void Allocate(size_t capacity);
+    static void Release(value_type* slots, size_t bytes, bool mapped) noexcept;
+};
+
+//! Flat hash map iterator
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+class FlatHashMapIterator
+{
+    friend class FlatHashMap<TKey, TValue, THash, TEqual>;
+
+public:
+    // Standard iterator type definitions
+    typedef std::pair<TKey, TValue> value_type;
+    typedef value_type& reference;
+    typedef value_type* pointer;
+    typedef ptrdiff_t difference_type;
+    typedef std::forward_iterator_tag iterator_category;
+
+    FlatHashMapIterator() noexcept : _container(nullptr), _index(0) {}
+    FlatHashMapIterator(const FlatHashMap<TKey, TValue, THash, TEqual>* container, size_t index) noexcept : _container(container), _index(index) {}
+    FlatHashMapIterator(const FlatHashMapIterator&) noexcept = default;
+    FlatHashMapIterator(FlatHashMapIterator&&) noexcept = default;
+    ~FlatHashMapIterator() noexcept = default;
+
+    FlatHashMapIterator& operator=(const FlatHashMapIterator&) noexcept = default;
+    FlatHashMapIterator& operator=(FlatHashMapIterator&&) noexcept = default;
+
+    friend bool operator==(const FlatHashMapIterator& it1, const FlatHashMapIterator& it2) noexcept
+    { return (it1._container == it2._container) && (it1._index == it2._index); }
+    friend bool operator!=(const FlatHashMapIterator& it1, const FlatHashMapIterator& it2) noexcept
+    { return (it1._container != it2._container) || (it1._index != it2._index); }
+
+    FlatHashMapIterator& operator++() noexcept;
+    FlatHashMapIterator operator++(int) noexcept;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+
+    //! Check if the iterator is valid
+    explicit operator bool() const noexcept { return (_container != nullptr) && (_index < _container->_capacity); }
+
+private:
+    const FlatHashMap<TKey, TValue, THash, TEqual>* _container;
+    size_t _index;
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#include "flat_hash_map.inl"
+
+#endif // TRADING_PLATFORM_MATCHING_FLAT_HASH_MAP_H
@@ -0,0 +1,400 @@
+/*!
+    \file flat_hash_map.inl
+    \brief Flat hash map inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace Matching {
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline FlatHashMap<TKey, TValue, THash, TEqual>::FlatHashMap(size_t capacity, const TKey& blank, const THash& hash, const TEqual& equal)
+    : _hash(hash),
+      _equal(equal),
+      _size(0),
+      _capacity(0),
+      _mask(0),
+      _bytes(0),
+      _mapped(false),
+      _control(nullptr),
+      _slots(nullptr)
+{
+    (void)blank;
+    Allocate(capacity);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline FlatHashMap<TKey, TValue, THash, TEqual>::FlatHashMap(FlatHashMap&& hashmap) noexcept
+    : _hash(std::move(hashmap._hash)),
+      _equal(std::move(hashmap._equal)),
+      _size(hashmap._size),
+      _capacity(hashmap._capacity),
+      _mask(hashmap._mask),
+      _bytes(hashmap._bytes),
+      _mapped(hashmap._mapped),
+      _control(hashmap._control),
+      _slots(hashmap._slots)
+{
+    hashmap._size = 0;
+    hashmap._capacity = 0;
+    hashmap._mask = 0;
+    hashmap._bytes = 0;
+    hashmap._mapped = false;
+    hashmap._control = nullptr;
+    hashmap._slots = nullptr;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline FlatHashMap<TKey, TValue, THash, TEqual>::~FlatHashMap()
+{
+    clear();
+    Release(_slots, _bytes, _mapped);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline FlatHashMap<TKey, TValue, THash, TEqual>& FlatHashMap<TKey, TValue, THash, TEqual>::operator=(FlatHashMap&& hashmap) noexcept
+{
+    FlatHashMap(std::move(hashmap)).swap(*this);
+    return *this;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline typename FlatHashMap<TKey, TValue, THash, TEqual>::iterator FlatHashMap<TKey, TValue, THash, TEqual>::begin() const noexcept
+{
+    size_t index = 0;
+    while ((index < _capacity) && (_control[index] == EMPTY))
+        ++index;
+    return iterator(this, index);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline typename FlatHashMap<TKey, TValue, THash, TEqual>::iterator FlatHashMap<TKey, TValue, THash, TEqual>::end() const noexcept
+{
+    return iterator(this, _capacity);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline typename FlatHashMap<TKey, TValue, THash, TEqual>::iterator FlatHashMap<TKey, TValue, THash, TEqual>::find(const TKey& key) const noexcept
+{
+    return iterator(this, FindIndex(key, _hash(key)));
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline std::pair<typename FlatHashMap<TKey, TValue, THash, TEqual>::iterator, bool> FlatHashMap<TKey, TValue, THash, TEqual>::insert(const value_type& item)
+{
+    return emplace(item.first, item.second);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+template <typename... Args>
+inline std::pair<typename FlatHashMap<TKey, TValue, THash, TEqual>::iterator, bool> FlatHashMap<TKey, TValue, THash, TEqual>::emplace(const TKey& key, Args&&... args)
+{
+    size_t hash = _hash(key);
+
+    // Check for the duplicate key
+    size_t index = FindIndex(key, hash);
+    if (index < _capacity)
+        return std::make_pair(iterator(this, index), false);
+
+    // Keep the load factor below 7/8 to have empty slots in every probe sequence
+    if (((_size + 1) * 8) > (_capacity * 7))
+        rehash(_capacity * 2);
+
+    // Place the new item into the first empty slot
+    index = FindEmpty(hash);
+    new (&_slots[index]) value_type(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    SetControl(index, H2(hash));
+    ++_size;
+
+    return std::make_pair(iterator(this, index), true);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline size_t FlatHashMap<TKey, TValue, THash, TEqual>::erase(const TKey& key)
+{
+    size_t index = FindIndex(key, _hash(key));
+    if (index == _capacity)
+        return 0;
+
+    EraseIndex(index);
+    return 1;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::erase(const const_iterator& position)
+{
+    assert((position._container == this) && (position._index < _capacity) && "Invalid hash map iterator!");
+    EraseIndex(position._index);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::rehash(size_t capacity)
+{
+    // Keep the old table
+    size_t old_capacity = _capacity;
+    size_t old_bytes = _bytes;
+    bool old_mapped = _mapped;
+    const uint8_t* old_control = _control;
+    value_type* old_slots = _slots;
+
+    // Allocate a new table which fits all items
+    size_t required = (_size * 8) / 7 + 1;
+    Allocate((capacity > required) ? capacity : required);
+
+    // Move items into the new table
+    for (size_t i = 0; i < old_capacity; ++i)
+    {
+        if (old_control[i] != EMPTY)
+        {
+            size_t hash = _hash(old_slots[i].first);
+            size_t index = FindEmpty(hash);
+            new (&_slots[index]) value_type(std::move(old_slots[i]));
+            SetControl(index, H2(hash));
+            old_slots[i].~value_type();
+        }
+    }
+
+    // Release the old table
+    Release(old_slots, old_bytes, old_mapped);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::reserve(size_t count)
+{
+    size_t capacity = (count * 8) / 7 + 1;
+    if (capacity > _capacity)
+        rehash(capacity);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::clear() noexcept
+{
+    if (_size > 0)
+    {
+        for (size_t i = 0; i < _capacity; ++i)
+            if (_control[i] != EMPTY)
+                _slots[i].~value_type();
+        std::memset(_control, EMPTY, _capacity + GROUP_SIZE);
+        _size = 0;
+    }
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::swap(FlatHashMap& hashmap) noexcept
+{
+    using std::swap;
+    swap(_hash, hashmap._hash);
+    swap(_equal, hashmap._equal);
+    swap(_size, hashmap._size);
+    swap(_capacity, hashmap._capacity);
+    swap(_mask, hashmap._mask);
+    swap(_bytes, hashmap._bytes);
+    swap(_mapped, hashmap._mapped);
+    swap(_control, hashmap._control);
+    swap(_slots, hashmap._slots);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void swap(FlatHashMap<TKey, TValue, THash, TEqual>& hashmap1, FlatHashMap<TKey, TValue, THash, TEqual>& hashmap2) noexcept
+{
+    hashmap1.swap(hashmap2);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline uint32_t FlatHashMap<TKey, TValue, THash, TEqual>::Match(const uint8_t* group, uint8_t value) noexcept
+{
+#if defined(__SSE2__)
+    __m128i control = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)value)));
+#else
+    uint32_t result = 0;
+    for (size_t i = 0; i < GROUP_SIZE; ++i)
+        if (group[i] == value)
+            result |= (1u << i);
+    return result;
+#endif
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline uint32_t FlatHashMap<TKey, TValue, THash, TEqual>::MatchEmpty(const uint8_t* group) noexcept
+{
+#if defined(__SSE2__)
+    // Only the empty control byte has the high bit set
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    return Match(group, EMPTY);
+#endif
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::SetControl(size_t index, uint8_t value) noexcept
+{
+    _control[index] = value;
+
+    // Mirror first control bytes after the end of the table, so groups could be loaded without wrapping
+    if (index < GROUP_SIZE)
+        _control[_capacity + index] = value;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline size_t FlatHashMap<TKey, TValue, THash, TEqual>::FindIndex(const TKey& key, size_t hash) const noexcept
+{
+    size_t position = H1(hash) & _mask;
+    uint8_t value = H2(hash);
+
+    for (;;)
+    {
+        const uint8_t* group = _control + position;
+
+        // Check all candidates with the same control value in the group
+        uint32_t matches = Match(group, value);
+        while (matches != 0)
+        {
+            size_t index = (position + BitScan::Lowest(matches)) & _mask;
+            if (_equal(_slots[index].first, key))
+                return index;
+            matches &= matches - 1;
+        }
+
+        // Empty slot terminates the probe sequence
+        if (MatchEmpty(group) != 0)
+            return _capacity;
+
+        position = (position + GROUP_SIZE) & _mask;
+    }
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline size_t FlatHashMap<TKey, TValue, THash, TEqual>::FindEmpty(size_t hash) const noexcept
+{
+    size_t position = H1(hash) & _mask;
+
+    for (;;)
+    {
+        uint32_t empty = MatchEmpty(_control + position);
+        if (empty != 0)
+            return (position + BitScan::Lowest(empty)) & _mask;
+
+        position = (position + GROUP_SIZE) & _mask;
+    }
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::EraseIndex(size_t index)
+{
+    _slots[index].~value_type();
+
+    // Shift following items of the probe sequence back into the hole
+    size_t hole = index;
+    size_t next = (index + 1) & _mask;
+    while (_control[next] != EMPTY)
+    {
+        size_t home = H1(_hash(_slots[next].first)) & _mask;
+
+        // Item could be moved only if its home slot is not between the hole and the item
+        if (((next - home) & _mask) >= ((next - hole) & _mask))
+        {
+            new (&_slots[hole]) value_type(std::move(_slots[next]));
+            _slots[next].~value_type();
+            SetControl(hole, _control[next]);
+            hole = next;
+        }
+
+        next = (next + 1) & _mask;
+    }
+
+    SetControl(hole, EMPTY);
+    --_size;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::Allocate(size_t capacity)
+{
+    // Table capacity is a power of two not less than a control bytes group
+    size_t size = GROUP_SIZE;
+    while (size < capacity)
+        size <<= 1;
+
+    // Slots are followed by control bytes with mirrored first group
+    size_t slots = ((size * sizeof(value_type)) + 63) & ~(size_t)63;
+    size_t bytes = slots + size + GROUP_SIZE;
+
+    void* buffer = nullptr;
+    bool mapped = false;
+#if defined(__linux__)
+    if (bytes >= HUGE_PAGE_SIZE)
+    {
+        bytes = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        buffer = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffer == MAP_FAILED)
+            throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+        madvise(buffer, bytes, MADV_HUGEPAGE);
+#endif
+        mapped = true;
+    }
+#endif
+    if (buffer == nullptr)
+        buffer = ::operator new(bytes);
+
+    _capacity = size;
+    _mask = size - 1;
+    _bytes = bytes;
+    _mapped = mapped;
+    _slots = (value_type*)buffer;
+    _control = (uint8_t*)buffer + slots;
+    std::memset(_control, EMPTY, size + GROUP_SIZE);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline void FlatHashMap<TKey, TValue, THash, TEqual>::Release(value_type* slots, size_t bytes, bool mapped) noexcept
+{
+    if (slots == nullptr)
+        return;
+
+#if defined(__linux__)
+    if (mapped)
+    {
+        munmap(slots, bytes);
+        return;
+    }
+#endif
+    ::operator delete(slots);
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline FlatHashMapIterator<TKey, TValue, THash, TEqual>& FlatHashMapIterator<TKey, TValue, THash, TEqual>::operator++() noexcept
+{
+    do
+    {
+        ++_index;
+    } while ((_index < _container->_capacity) && (_container->_control[_index] == FlatHashMap<TKey, TValue, THash, TEqual>::EMPTY));
+    return *this;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline FlatHashMapIterator<TKey, TValue, THash, TEqual> FlatHashMapIterator<TKey, TValue, THash, TEqual>::operator++(int) noexcept
+{
+    FlatHashMapIterator<TKey, TValue, THash, TEqual> result(*this);
+    operator++();
+    return result;
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline typename FlatHashMapIterator<TKey, TValue, THash, TEqual>::reference FlatHashMapIterator<TKey, TValue, THash, TEqual>::operator*() const noexcept
+{
+    assert(((_container != nullptr) && (_index < _container->_capacity)) && "Iterator must be valid!");
+
+    return _container->_slots[_index];
+}
+
+template <typename TKey, typename TValue, typename THash, typename TEqual>
+inline typename FlatHashMapIterator<TKey, TValue, THash, TEqual>::pointer FlatHashMapIterator<TKey, TValue, THash, TEqual>::operator->() const noexcept
+{
+    return ((_container != nullptr) && (_index < _container->_capacity)) ? &_container->_slots[_index] : nullptr;
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
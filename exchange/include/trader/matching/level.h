@@ -73,12 +73,30 @@ struct Level
     bool IsAsk() const noexcept { return Type == LevelType::ASK; }
 };
 
+struct TrailingStopBucket;
+
 //! Price level node
 struct LevelNode : public Level, public CppCommon::BinTreeAVL<LevelNode>::Node
 {
     //! Price level orders
     CppCommon::List<OrderNode> OrderList;
 
+    //! Price level 'All-Or-None' orders volume
+    uint64_t AONVolume;
+
+    //! Volume index links
+    LevelNode* IndexParent;
+    LevelNode* IndexLeft;
+    LevelNode* IndexRight;
+
+    //! Volume index aggregated volume of the price level subtree
+    uint64_t SubtreeTotalVolume;
+    uint64_t SubtreeVisibleVolume;
+    uint64_t SubtreeAONVolume;
+
+    //! Trailing stop orders bucket of the trailing stop price level
+    TrailingStopBucket* Bucket;
+
     LevelNode(LevelType type, uint64_t price) noexcept;
     LevelNode(const Level& level) noexcept;
     LevelNode(const LevelNode&) noexcept = default;
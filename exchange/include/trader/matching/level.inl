@@ -48,11 +48,28 @@ inline TOutputStream& operator<<(TOutputStream& stream, const Level& level)
 }
 
 inline LevelNode::LevelNode(LevelType type, uint64_t price) noexcept
-    : Level(type, price)
+    : Level(type, price),
+      AONVolume(0),
+      IndexParent(nullptr),
+      IndexLeft(nullptr),
+      IndexRight(nullptr),
+      SubtreeTotalVolume(0),
+      SubtreeVisibleVolume(0),
+      SubtreeAONVolume(0),
+      Bucket(nullptr)
 {
 }
 
-inline LevelNode::LevelNode(const Level& level) noexcept : Level(level)
+inline LevelNode::LevelNode(const Level& level) noexcept
+    : Level(level),
+      AONVolume(0),
+      IndexParent(nullptr),
+      IndexLeft(nullptr),
+      IndexRight(nullptr),
+      SubtreeTotalVolume(0),
+      SubtreeVisibleVolume(0),
+      SubtreeAONVolume(0),
+      Bucket(nullptr)
 {
 }
 
@@ -60,6 +77,14 @@ inline LevelNode& LevelNode::operator=(const Level& level) noexcept
 {
     Level::operator=(level);
     OrderList.clear();
+    AONVolume = 0;
+    IndexParent = nullptr;
+    IndexLeft = nullptr;
+    IndexRight = nullptr;
+    SubtreeTotalVolume = 0;
+    SubtreeVisibleVolume = 0;
+    SubtreeAONVolume = 0;
+    Bucket = nullptr;
     return *this;
 }
 
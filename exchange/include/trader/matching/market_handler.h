@@ -31,7 +31,8 @@ namespace Matching {
 */
 class MarketHandler
 {
-    friend class MarketManager;
+    template <class THandler>
+    friend class BasicMarketManager;
 
 public:
     MarketHandler() = default;
@@ -64,6 +65,9 @@ protected:
 
     // Order execution handlers
     virtual void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) {}
+
+    // Market events flush handler (called once at the end of each market manager command)
+    virtual void onFlush() {}
 };
 
 } // namespace Matching
@@ -9,12 +9,14 @@
 #ifndef TRADING_PLATFORM_MATCHING_MARKET_MANAGER_H
 #define TRADING_PLATFORM_MATCHING_MARKET_MANAGER_H
 
+#include "bbo_table.h"
 #include "fast_hash.h"
+#include "flat_hash_map.h"
 #include "market_handler.h"
 
-#include "containers/hashmap.h"
 #include "memory/allocator_pool.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -33,26 +35,53 @@ namespace Matching {
     Automatic orders matching can be enabled with EnableMatching() method or can be
     manually performed with Match() method.
 
+    Market handler type is bound at compile time. MarketManager instantiation calls
+    handler methods through MarketHandler virtual interface. Market manager with a
+    concrete final handler type calls them directly, so empty or trivial handler
+    methods are inlined into the matching code:
+    \code{.cpp}
+    class MyMarketHandler final : public MarketHandler
+    {
+        friend class BasicMarketManager<MyMarketHandler>;
+
+    protected:
+        void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { ++_executions; }
+        ...
+    };
+
+    MyMarketHandler handler;
+    BasicMarketManager<MyMarketHandler> market(handler);
+    \endcode
+
     Not thread-safe.
+
+    \tparam THandler - Market handler type (MarketHandler or its final subclass)
 */
-class MarketManager
+template <class THandler>
+class BasicMarketManager
 {
+    friend class MarketSnapshot;
+
 public:
     //! Symbols container
     typedef std::vector<Symbol*> Symbols;
     //! Order books container
     typedef std::vector<OrderBook*> OrderBooks;
     //! Orders container
-    typedef CppCommon::HashMap<uint64_t, OrderNode*, FastHash> Orders;
+    /*!
+        Flat hash map keeps cancel-heavy flow fast with millions of resting orders.
+        CppCommon::HashMap<uint64_t, OrderNode*, FastHash> could be used instead.
+    */
+    typedef FlatHashMap<uint64_t, OrderNode*, FastHash> Orders;
 
-    MarketManager();
-    MarketManager(MarketHandler& market_handler);
-    MarketManager(const MarketManager&) = delete;
-    MarketManager(MarketManager&&) noexcept = default;
-    ~MarketManager();
+    BasicMarketManager();
+    BasicMarketManager(THandler& market_handler);
+    BasicMarketManager(const BasicMarketManager&) = delete;
+    BasicMarketManager(BasicMarketManager&&) noexcept = default;
+    ~BasicMarketManager();
 
-    MarketManager& operator=(const MarketManager&) = delete;
-    MarketManager& operator=(MarketManager&&) noexcept = default;
+    BasicMarketManager& operator=(const BasicMarketManager&) = delete;
+    BasicMarketManager& operator=(BasicMarketManager&&) noexcept = default;
 
     //! Get the symbols container
     const Symbols& symbols() const noexcept { return _symbols; }
@@ -95,10 +124,15 @@ public:
 
     //! Add a new order book
     /*!
+        Order books of symbols which trade within a narrow band of ticks
+        could use a direct-indexed price ladder instead of price level trees.
+
         \param symbol - Symbol of the order book to add
+        \param ladder - Price ladder size in ticks (default is 0 to use only price level trees)
+        \param tick - Price ladder tick size (default is 1)
         \return Error code
     */
-    ErrorCode AddOrderBook(const Symbol& symbol);
+    ErrorCode AddOrderBook(const Symbol& symbol, size_t ladder = 0, uint64_t tick = 1);
     //! Delete the order book
     /*!
         \param id - Symbol Id of the order book
@@ -221,10 +255,61 @@ public:
     */
     void Match();
 
+    //! Attach the best bid and offer table
+    /*!
+        Market manager writes the top of the book of its order books into the
+        table at the end of each command which changed it, so readers never see
+        intermediate states of the command (e.g. levels removed one by one by a
+        sweeping order). Top of the book of all existing order books is written
+        on attach.
+
+        \param bbo_table - Best bid and offer table (nullptr to detach)
+    */
+    void AttachBBOTable(BBOTable* bbo_table);
+
+    //! Get the count of commands between trailing stop orders notifications
+    size_t trailing_stop_throttle() const noexcept { return _trailing_throttle; }
+    //! Set the count of commands between trailing stop orders notifications
+    /*!
+        Trailing stop price levels are moved by the market without updating
+        stop prices of their orders. Orders of moved price levels are updated
+        and notified with onUpdateOrder() handler all together at the end of
+        the given count of commands since the first move, so many moves of the
+        same order are coalesced into the single notification. Until then
+        GetOrder() returns previous stop prices of moved orders.
+
+        Trailing stop orders are always updated before they are activated,
+        modified or deleted.
+
+        \param commands - Count of commands (default is 1 to notify at the end of each command)
+    */
+    void SetTrailingStopThrottle(size_t commands) noexcept { _trailing_throttle = std::max(commands, (size_t)1); }
+
 private:
     // Market handler
-    static MarketHandler _default;
-    MarketHandler& _market_handler;
+    static THandler _default;
+    THandler& _market_handler;
+
+    // Nested public commands counter, market handler is flushed at the end of the outer command
+    size_t _commands;
+
+    struct Command
+    {
+        BasicMarketManager& manager;
+
+        explicit Command(BasicMarketManager& market_manager) noexcept : manager(market_manager) { ++manager._commands; }
+        ~Command()
+        {
+            if (--manager._commands == 0)
+            {
+                if (!manager._trailing_updates.empty() && (++manager._trailing_commands >= manager._trailing_throttle))
+                    manager.FlushTrailingStops();
+                if (!manager._bbo_updates.empty())
+                    manager.FlushBBO();
+                manager._market_handler.onFlush();
+            }
+        }
+    };
 
     // Auxiliary memory manager
     CppCommon::DefaultMemoryManager _auxiliary_memory_manager;
@@ -253,6 +338,11 @@ private:
     ErrorCode ReplaceOrder(uint64_t id, uint64_t new_id, uint64_t new_price, uint64_t new_quantity, bool internal);
     ErrorCode DeleteOrder(uint64_t id, bool internal);
 
+    // Internal mutations of order nodes already found by matching loops (no order lookups and no nested matching)
+    void ExecuteOrder(OrderBook* order_book_ptr, OrderNode* order_ptr, uint64_t price, uint64_t quantity);
+    void ReduceOrder(OrderBook* order_book_ptr, OrderNode* order_ptr, uint64_t quantity);
+    void DeleteOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
+
     // Matching
     bool _matching;
 
@@ -260,20 +350,47 @@ private:
     void MatchMarket(OrderBook* order_book_ptr, Order* order_ptr);
     void MatchLimit(OrderBook* order_book_ptr, Order* order_ptr);
     void MatchOrder(OrderBook* order_book_ptr, Order* order_ptr);
+    // Matching kernels selected once per order by the order side and by the presence of 'Fill-Or-Kill'/'All-Or-None' orders
+    template <bool BUY, bool AON>
+    void MatchOrder(OrderBook* order_book_ptr, Order* order_ptr);
+
+    // Stop orders crossed by the market are moved from the order book into the activation queue
+    CppCommon::List<OrderNode> _activations;
 
     bool ActivateStopOrders(OrderBook* order_book_ptr);
-    bool ActivateStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t stop_price);
-    bool ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
-    bool ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
+    bool QueueStopOrders(OrderBook* order_book_ptr);
+    void QueueStopOrders(OrderBook* order_book_ptr, LevelNode* level_ptr);
+    void ActivateQueuedOrders(OrderBook* order_book_ptr);
+    void ActivateStopOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
+    void ActivateStopLimitOrder(OrderBook* order_book_ptr, OrderNode* order_ptr);
 
     uint64_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume);
     uint64_t CalculateMatchingChain(OrderBook* order_book_ptr, LevelNode* bid_level_ptr, LevelNode* ask_level_ptr);
     void ExecuteMatchingChain(OrderBook* order_book_ptr, LevelNode* level_ptr, uint64_t price, uint64_t volume);
     void RecalculateTrailingStopPrice(OrderBook* order_book_ptr, LevelNode* level_ptr);
 
-    void UpdateLevel(const OrderBook& order_book, const LevelUpdate& update) const;
+    // Order books with trailing stop orders moved since the last notification
+    std::vector<uint32_t> _trailing_updates;
+    size_t _trailing_throttle;
+    size_t _trailing_commands;
+
+    void UpdateTrailingStops(uint32_t id);
+    void FlushTrailingStops();
+    void FlushTrailingStops(TrailingStops& trailing_stops);
+
+    void UpdateLevel(const OrderBook& order_book, const LevelUpdate& update);
+
+    // Best bid and offer table with symbols changed by the current command
+    BBOTable* _bbo_table;
+    std::vector<uint32_t> _bbo_updates;
+
+    void UpdateBBO(uint32_t id);
+    void FlushBBO();
 };
 
+//! Market manager with virtual market handler
+typedef BasicMarketManager<MarketHandler> MarketManager;
+
 /*! \example market_manager.cpp Market manager example */
 /*! \example matching_engine.cpp Matching engine example */
 
@@ -282,4 +399,13 @@ private:
 
 #include "market_manager.inl"
 
+namespace TradingPlatform {
+namespace Matching {
+
+// Virtual market handler instantiation is compiled once in market_manager.cpp
+extern template class BasicMarketManager<MarketHandler>;
+
+} // namespace Matching
+} // namespace TradingPlatform
+
 #endif // TRADING_PLATFORM_MATCHING_MARKET_MANAGER_H
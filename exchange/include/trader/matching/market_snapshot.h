@@ -0,0 +1,133 @@
+/*!
+    \file market_snapshot.h
+    \brief Market snapshot definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_MARKET_SNAPSHOT_H
+#define TRADING_PLATFORM_MATCHING_MARKET_SNAPSHOT_H
+
+#include "market_manager.h"
+
+#include <string>
+
+namespace TradingPlatform {
+namespace Matching {
+
+//! Market snapshot
+/*!
+    Market snapshot is used to save the full market manager state into a
+    compact binary format and to restore it back.
+
+    Snapshot consists of fixed size records with native byte order aligned
+    to 8 bytes, so it could be restored directly from a memory-mapped file:
+    \code
+    SnapshotHeader
+    SnapshotSymbol * Symbols
+    (SnapshotOrderBook + Order * SnapshotOrderBook::Orders) * OrderBooks
+    \endcode
+
+    Orders of each order book are stored in the queue order: bid and ask
+    price levels from the best one, then buy/sell stop and trailing stop
+    levels. Restore bulk loads symbols, order books and orders into memory
+    pools and indexes of an empty market manager without calling any market
+    handler callbacks, so the restored market manager is in the same state
+    as the saved one.
+
+    Snapshot format depends on the Order structure layout, so snapshots are
+    not portable between different builds or platforms. Market manager which
+    failed to restore is left partially loaded and should be discarded.
+
+    Not thread-safe.
+*/
+class MarketSnapshot
+{
+public:
+    //! Snapshot magic signature
+    static constexpr char MAGIC[8] = { 'L', '2', 'E', 'X', 'S', 'N', 'A', 'P' };
+    //! Snapshot format version
+    static constexpr uint32_t VERSION = 1;
+
+    //! Snapshot header
+    struct SnapshotHeader
+    {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t OrderSize;
+        uint64_t Sequence;
+        uint64_t Symbols;
+        uint64_t OrderBooks;
+        uint64_t Orders;
+        uint64_t Matching;
+    };
+
+    //! Snapshot symbol record
+    struct SnapshotSymbol
+    {
+        uint32_t Id;
+        char Name[8];
+        uint32_t Reserved;
+    };
+
+    //! Snapshot order book record
+    struct SnapshotOrderBook
+    {
+        uint32_t SymbolId;
+        uint32_t Reserved;
+        uint64_t Ladder;
+        uint64_t Tick;
+        uint64_t LastBidPrice;
+        uint64_t LastAskPrice;
+        uint64_t TrailingBidPrice;
+        uint64_t TrailingAskPrice;
+        uint64_t Orders;
+    };
+
+    MarketSnapshot() = delete;
+    MarketSnapshot(const MarketSnapshot&) = delete;
+    MarketSnapshot(MarketSnapshot&&) = delete;
+    ~MarketSnapshot() = delete;
+
+    MarketSnapshot& operator=(const MarketSnapshot&) = delete;
+    MarketSnapshot& operator=(MarketSnapshot&&) = delete;
+
+    //! Save the market manager state into the snapshot file
+    /*!
+        \param market - Market manager to save
+        \param path - Snapshot file path
+        \param sequence - Sequence number of the last message applied to the market manager (default is 0)
+        \return 'true' if the snapshot was successfully saved, 'false' if the file was not written
+    */
+    static bool Save(const MarketManager& market, const std::string& path, uint64_t sequence = 0);
+
+    //! Restore the market manager state from the snapshot buffer
+    /*!
+        \param market - Empty market manager to restore
+        \param buffer - Snapshot buffer (e.g. memory-mapped snapshot file)
+        \param size - Snapshot buffer size
+        \param sequence - Sequence number of the last message applied to the saved market manager
+        \return 'true' if the snapshot was successfully restored, 'false' if the snapshot is invalid or the market manager is not empty
+    */
+    static bool Load(MarketManager& market, const void* buffer, size_t size, uint64_t& sequence);
+    //! Restore the market manager state from the snapshot file
+    /*!
+        \param market - Empty market manager to restore
+        \param path - Snapshot file path
+        \param sequence - Sequence number of the last message applied to the saved market manager
+        \return 'true' if the snapshot was successfully restored, 'false' if the snapshot is invalid or the market manager is not empty
+    */
+    static bool Load(MarketManager& market, const std::string& path, uint64_t& sequence);
+
+private:
+    static void SaveLevels(std::vector<Order>& orders, const OrderBook& order_book, const LevelNode* level_ptr);
+    static void SaveLevels(std::vector<Order>& orders, const OrderBook::Levels& levels);
+    static void SaveLevels(std::vector<Order>& orders, const TrailingStops& trailing_stops);
+    static void SaveLevel(std::vector<Order>& orders, const LevelNode* level_ptr);
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#endif // TRADING_PLATFORM_MATCHING_MARKET_SNAPSHOT_H
@@ -120,6 +120,10 @@ TOutputStream& operator<<(TOutputStream& stream, OrderTimeInForce tif);
     bond market, commodity market, or financial derivative market. These instructions can
     be simple or complicated, and can be sent to either a broker or directly to a trading
     venue via direct market access.
+
+    Fields are ordered by access frequency: fields used to match limit orders
+    go first, so they share a single cache line in the order node, quantities
+    and attributes of stop, market and trailing orders go last.
 */
 struct Order
 {
@@ -131,21 +135,13 @@ struct Order
     OrderType Type;
     //! Order side
     OrderSide Side;
+    //! Time in Force
+    OrderTimeInForce TimeInForce;
     //! Order price
     uint64_t Price;
-    //! Order stop price
-    uint64_t StopPrice;
-
-    //! Order quantity
-    uint64_t Quantity;
-    //! Order executed quantity
-    uint64_t ExecutedQuantity;
     //! Order leaves quantity
     uint64_t LeavesQuantity;
 
-    //! Time in Force
-    OrderTimeInForce TimeInForce;
-
     //! Order max visible quantity
     /*!
         This property allows to prepare 'iceberg'/'hidden' orders with the
@@ -162,6 +158,13 @@ struct Order
     //! Order visible quantity
     uint64_t VisibleQuantity() const noexcept { return std::min(LeavesQuantity, MaxVisibleQuantity); }
 
+    //! Order executed quantity
+    uint64_t ExecutedQuantity;
+    //! Order quantity
+    uint64_t Quantity;
+    //! Order stop price
+    uint64_t StopPrice;
+
     //! Market order slippage
     /*!
         Slippage is useful to protect market order from executions at prices
@@ -294,11 +297,23 @@ struct Order
 
 struct LevelNode;
 
-//! Order node
-struct OrderNode : public Order, public CppCommon::List<OrderNode>::Node
+//! Order node price level link
+struct OrderNodeLevel
 {
-    LevelNode* Level;
+    //! Price level of the order
+    LevelNode* Level = nullptr;
+};
 
+//! Order node
+/*!
+    Order node is aligned to the cache line and keeps list links, price level
+    and order fields used to match limit orders (Id, SymbolId, Type, Side,
+    TimeInForce, Price, LeavesQuantity and MaxVisibleQuantity) in the first
+    cache line. Executed quantity and attributes of stop, market and trailing
+    orders are placed in the second cache line.
+*/
+struct alignas(64) OrderNode : public CppCommon::List<OrderNode>::Node, public OrderNodeLevel, public Order
+{
     OrderNode(const Order& order) noexcept;
     OrderNode(const OrderNode&) noexcept = default;
     OrderNode(OrderNode&&) noexcept = default;
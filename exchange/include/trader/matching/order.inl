@@ -71,13 +71,13 @@ inline Order::Order(uint64_t id, uint32_t symbol, OrderType type, OrderSide side
       SymbolId(symbol),
       Type(type),
       Side(side),
+      TimeInForce(tif),
       Price(price),
-      StopPrice(stop_price),
-      Quantity(quantity),
-      ExecutedQuantity(0),
       LeavesQuantity(quantity),
-      TimeInForce(tif),
       MaxVisibleQuantity(max_visible_quantity),
+      ExecutedQuantity(0),
+      Quantity(quantity),
+      StopPrice(stop_price),
       Slippage(slippage),
       TrailingDistance(trailing_distance),
       TrailingStep(trailing_step)
@@ -200,7 +200,7 @@ inline Order Order::TrailingSellStopLimit(uint64_t id, uint32_t symbol, uint64_t
     return Order(id, symbol, OrderType::TRAILING_STOP_LIMIT, OrderSide::SELL, price, stop_price, quantity, tif, max_visible_quantity, std::numeric_limits<uint64_t>::max(), trailing_distance, trailing_step);
 }
 
-inline OrderNode::OrderNode(const Order& order) noexcept : Order(order), Level(nullptr)
+inline OrderNode::OrderNode(const Order& order) noexcept : Order(order)
 {
 }
 
@@ -10,7 +10,10 @@
 #define TRADING_PLATFORM_MATCHING_ORDER_BOOK_H
 
 #include "level.h"
+#include "price_ladder.h"
 #include "symbol.h"
+#include "trailing_stops.h"
+#include "volume_index.h"
 
 #include "memory/allocator_pool.h"
 
@@ -21,17 +24,31 @@ namespace Matching {
 /*!
     Order book is used to keep buy and sell orders in a price level order.
 
+    Bid and ask price levels are kept in AVL trees by default. For dense
+    books which trade within a narrow band of ticks the order book could
+    be created with a price ladder. In this case price levels inside the
+    ladder window are kept in the direct-indexed price ladder and AVL trees
+    are used only as a fallback for prices outside of the window.
+
     Not thread-safe.
 */
 class OrderBook
 {
-    friend class MarketManager;
+    template <class THandler>
+    friend class BasicMarketManager;
+    friend class MarketSnapshot;
 
 public:
     //! Price level container
     typedef CppCommon::BinTreeAVL<LevelNode, std::less<LevelNode>> Levels;
 
-    OrderBook(const Symbol& symbol);
+    //! Initialize the order book with a given symbol and optional price ladder
+    /*!
+        \param symbol - Symbol
+        \param ladder - Price ladder size in ticks (default is 0 to use only price level trees)
+        \param tick - Price ladder tick size (default is 1)
+    */
+    OrderBook(const Symbol& symbol, size_t ladder = 0, uint64_t tick = 1);
     OrderBook(const OrderBook&) = delete;
     OrderBook(OrderBook&&) noexcept = default;
     ~OrderBook();
@@ -46,7 +63,7 @@ public:
     bool empty() const noexcept { return size() == 0; }
 
     //! Get the order book size
-    size_t size() const noexcept { return _bids.size() + _asks.size() + _buy_stop.size() + _sell_stop.size() + _trailing_buy_stop.size() + _trailing_sell_stop.size(); }
+    size_t size() const noexcept { return bid_levels() + ask_levels() + _buy_stop.size() + _sell_stop.size() + _trailing_buy_stop.size() + _trailing_sell_stop.size(); }
 
     //! Get the order book symbol
     const Symbol& symbol() const noexcept { return _symbol; }
@@ -56,11 +73,26 @@ public:
     //! Get the order book best ask price level
     const LevelNode* best_ask() const noexcept { return _best_ask; }
 
-    //! Get the order book bids container
+    //! Get the order book bids container (price levels outside of the bid price ladder)
     const Levels& bids() const noexcept { return _bids; }
-    //! Get the order book asks container
+    //! Get the order book asks container (price levels outside of the ask price ladder)
     const Levels& asks() const noexcept { return _asks; }
 
+    //! Get the order book bid price ladder
+    const PriceLadder& bid_ladder() const noexcept { return _bid_ladder; }
+    //! Get the order book ask price ladder
+    const PriceLadder& ask_ladder() const noexcept { return _ask_ladder; }
+
+    //! Get the order book bid price levels volume index
+    const VolumeIndex& bid_index() const noexcept { return _bid_index; }
+    //! Get the order book ask price levels volume index
+    const VolumeIndex& ask_index() const noexcept { return _ask_index; }
+
+    //! Get the order book bid price levels count
+    size_t bid_levels() const noexcept { return _bids.size() + _bid_ladder.size(); }
+    //! Get the order book ask price levels count
+    size_t ask_levels() const noexcept { return _asks.size() + _ask_ladder.size(); }
+
     //! Get the order book best buy stop order price level
     const LevelNode* best_buy_stop() const noexcept { return _best_buy_stop; }
     //! Get the order book best sell stop order price level
@@ -72,14 +104,19 @@ public:
     const Levels& sell_stop() const noexcept { return _sell_stop; }
 
     //! Get the order book best trailing buy stop order price level
-    const LevelNode* best_trailing_buy_stop() const noexcept { return _best_trailing_buy_stop; }
+    const LevelNode* best_trailing_buy_stop() const noexcept { return _trailing_buy_stop.best(); }
     //! Get the order book best trailing sell stop order price level
-    const LevelNode* best_trailing_sell_stop() const noexcept { return _best_trailing_sell_stop; }
+    const LevelNode* best_trailing_sell_stop() const noexcept { return _trailing_sell_stop.best(); }
 
     //! Get the order book trailing buy stop orders container
-    const Levels& trailing_buy_stop() const noexcept { return _trailing_buy_stop; }
+    const TrailingStops& trailing_buy_stop() const noexcept { return _trailing_buy_stop; }
     //! Get the order book trailing sell stop orders container
-    const Levels& trailing_sell_stop() const noexcept { return _trailing_sell_stop; }
+    const TrailingStops& trailing_sell_stop() const noexcept { return _trailing_sell_stop; }
+
+    //! Get the order book count of 'All-Or-None' bid orders
+    size_t aon_bids() const noexcept { return _aon_bids; }
+    //! Get the order book count of 'All-Or-None' ask orders
+    size_t aon_asks() const noexcept { return _aon_asks; }
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderBook& order_book);
@@ -97,31 +134,54 @@ public:
     */
     const LevelNode* GetAsk(uint64_t price) const noexcept;
 
-    //! Get the order book buy stop level with the given price
+    //! Get the volume available for the order of the given side up to the given price
     /*!
+        Buy orders are matched with asks, sell orders are matched with bids.
+        Volume of all price levels from the best one up to the given price
+        (inclusive) is aggregated in logarithmic time.
+
+        \param side - Order side
         \param price - Price
-        \return Pointer to the order book buy stop level with the given price or nullptr
+        \return Aggregated total, visible and 'All-Or-None' volume
     */
-    const LevelNode* GetBuyStopLevel(uint64_t price) const noexcept;
-    //! Get the order book sell stop level with the given price
+    VolumeIndex::Volume VolumeToPrice(OrderSide side, uint64_t price) const noexcept
+    { return (side == OrderSide::BUY) ? _ask_index.VolumeToPrice(price) : _bid_index.VolumeToPrice(price); }
+
+    //! Get the price level at which the order of the given side reaches the given volume
     /*!
-        \param price - Price
-        \return Pointer to the order book sell stop level with the given price or nullptr
+        Buy orders are matched with asks, sell orders are matched with bids.
+        Found price level is the worst one required to match the given volume,
+        'All-Or-None' orders are not taken into account.
+
+        \param side - Order side
+        \param volume - Volume
+        \return Pointer to the price level or nullptr if the order book side has not enough volume
     */
-    const LevelNode* GetSellStopLevel(uint64_t price) const noexcept;
+    const LevelNode* PriceForVolume(OrderSide side, uint64_t volume) const noexcept
+    { return (side == OrderSide::BUY) ? _ask_index.PriceForVolume(volume) : _bid_index.PriceForVolume(volume); }
 
-    //! Get the order book trailing buy stop level with the given price
+    //! Get the next bid/ask price level in the price level order
+    /*!
+        Could be used to iterate all price levels of the order book side
+        starting from the best one regardless of the price ladder.
+
+        \param level - Bid or ask price level
+        \return Pointer to the next worse price level of the same side or nullptr
+    */
+    const LevelNode* GetNextLevel(const LevelNode* level) const noexcept;
+
+    //! Get the order book buy stop level with the given price
     /*!
         \param price - Price
-        \return Pointer to the order book trailing buy stop level with the given price or nullptr
+        \return Pointer to the order book buy stop level with the given price or nullptr
     */
-    const LevelNode* GetTrailingBuyStopLevel(uint64_t price) const noexcept;
-    //! Get the order book trailing sell stop level with the given price
+    const LevelNode* GetBuyStopLevel(uint64_t price) const noexcept;
+    //! Get the order book sell stop level with the given price
     /*!
         \param price - Price
-        \return Pointer to the order book trailing sell stop level with the given price or nullptr
+        \return Pointer to the order book sell stop level with the given price or nullptr
     */
-    const LevelNode* GetTrailingSellStopLevel(uint64_t price) const noexcept;
+    const LevelNode* GetSellStopLevel(uint64_t price) const noexcept;
 
 private:
     // Order book symbol
@@ -138,11 +198,29 @@ private:
     Levels _bids;
     Levels _asks;
 
+    // Bid/Ask price ladders
+    PriceLadder _bid_ladder;
+    PriceLadder _ask_ladder;
+
+    // Bid/Ask price levels volume indexes
+    VolumeIndex _bid_index;
+    VolumeIndex _ask_index;
+
+    // Bid/Ask 'All-Or-None' orders count, matching skips AON checks of the side without them
+    size_t _aon_bids;
+    size_t _aon_asks;
+
     // Price level management
     LevelNode* GetNextLevel(LevelNode* level) noexcept;
     LevelNode* AddLevel(OrderNode* order_ptr);
     LevelNode* DeleteLevel(OrderNode* order_ptr);
 
+    // Price ladder management
+    static LevelNode* GetLowerLevel(Levels& levels, const PriceLadder& ladder, LevelNode* level) noexcept;
+    static LevelNode* GetHigherLevel(Levels& levels, const PriceLadder& ladder, LevelNode* level) noexcept;
+    static void InsertLevel(Levels& levels, PriceLadder& ladder, LevelNode* level);
+    static void EraseLevel(Levels& levels, PriceLadder& ladder, LevelNode* level);
+
     // Orders management
     LevelUpdate AddOrder(OrderNode* order_ptr);
     LevelUpdate ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
@@ -164,24 +242,33 @@ private:
     void ReduceStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
     void DeleteStopOrder(OrderNode* order_ptr);
 
-    // Buy/Sell trailing stop orders levels
-    LevelNode* _best_trailing_buy_stop;
-    LevelNode* _best_trailing_sell_stop;
-    Levels _trailing_buy_stop;
-    Levels _trailing_sell_stop;
+    // Buy/Sell trailing stop orders levels grouped by trailing distance and step
+    CppCommon::PoolMemoryManager<CppCommon::DefaultMemoryManager> _bucket_memory_manager;
+    CppCommon::PoolAllocator<TrailingStopBucket, CppCommon::DefaultMemoryManager> _bucket_pool;
+    TrailingStops _trailing_buy_stop;
+    TrailingStops _trailing_sell_stop;
 
     // Trailing stop orders price level management
-    LevelNode* GetNextTrailingStopLevel(LevelNode* level) noexcept;
     LevelNode* AddTrailingStopLevel(OrderNode* order_ptr);
     LevelNode* DeleteTrailingStopLevel(OrderNode* order_ptr);
+    LevelNode* MergeTrailingStopLevels(LevelNode* level1, LevelNode* level2);
+    void ReleaseTrailingStops(TrailingStops& trailing_stops);
 
     // Trailing stop orders management
     void AddTrailingStopOrder(OrderNode* order_ptr);
     void ReduceTrailingStopOrder(OrderNode* order_ptr, uint64_t quantity, uint64_t hidden, uint64_t visible);
     void DeleteTrailingStopOrder(OrderNode* order_ptr);
 
+    // Update the stop price of the trailing stop order from its price level moved by the market
+    static bool UpdateTrailingStopOrder(OrderNode* order_ptr) noexcept { return UpdateTrailingStopPrice(*order_ptr, order_ptr->Level->Price); }
+    static bool UpdateTrailingStopPrice(Order& order, uint64_t stop_price) noexcept;
+
     // Trailing stop price calculation
     uint64_t CalculateTrailingStopPrice(const Order& order) const noexcept;
+    static uint64_t CalculateTrailingStopPrice(bool buy, int64_t trailing_distance, int64_t trailing_step, uint64_t market_price, uint64_t old_price) noexcept;
+
+    // Move trailing stop price levels of all buckets after the market
+    bool RecalculateTrailingStops(TrailingStops& trailing_stops);
 
     // Market last and trailing prices
     uint64_t _last_bid_price;
@@ -9,17 +9,25 @@
 namespace TradingPlatform {
 namespace Matching {
 
-inline OrderBook::OrderBook(const Symbol& symbol)
+inline OrderBook::OrderBook(const Symbol& symbol, size_t ladder, uint64_t tick)
     : _symbol(symbol),
       _auxiliary_memory_manager(),
       _level_memory_manager(_auxiliary_memory_manager, 1024),
       _level_pool(_level_memory_manager),
       _best_bid(nullptr),
       _best_ask(nullptr),
+      _bid_ladder((ladder > 0) ? PriceLadder(ladder, tick) : PriceLadder()),
+      _ask_ladder((ladder > 0) ? PriceLadder(ladder, tick) : PriceLadder()),
+      _bid_index(LevelType::BID),
+      _ask_index(LevelType::ASK),
+      _aon_bids(0),
+      _aon_asks(0),
       _best_buy_stop(nullptr),
       _best_sell_stop(nullptr),
-      _best_trailing_buy_stop(nullptr),
-      _best_trailing_sell_stop(nullptr),
+      _bucket_memory_manager(_auxiliary_memory_manager, 64),
+      _bucket_pool(_bucket_memory_manager),
+      _trailing_buy_stop(LevelType::ASK),
+      _trailing_sell_stop(LevelType::BID),
       _last_bid_price(0),
       _last_ask_price(std::numeric_limits<uint64_t>::max()),
       _trailing_bid_price(0),
@@ -31,8 +39,8 @@ template <class TOutputStream>
 inline TOutputStream& operator<<(TOutputStream& stream, const OrderBook& order_book)
 {
     stream << "OrderBook(Symbol=" << order_book._symbol
-        << "; Bids=" << order_book._bids.size()
-        << "; Asks=" << order_book._asks.size()
+        << "; Bids=" << order_book.bid_levels()
+        << "; Asks=" << order_book.ask_levels()
         << "; BuyStop=" << order_book._buy_stop.size()
         << "; SellStop=" << order_book._sell_stop.size()
         << "; TrailingBuyStop=" << order_book._trailing_buy_stop.size()
@@ -43,12 +51,18 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderBook& order_b
 
 inline const LevelNode* OrderBook::GetBid(uint64_t price) const noexcept
 {
+    if (_bid_ladder.Contains(price))
+        return _bid_ladder.Find(price);
+
     auto it = _bids.find(LevelNode(LevelType::BID, price));
     return (it != _bids.end()) ? it.operator->() : nullptr;
 }
 
 inline const LevelNode* OrderBook::GetAsk(uint64_t price) const noexcept
 {
+    if (_ask_ladder.Contains(price))
+        return _ask_ladder.Find(price);
+
     auto it = _asks.find(LevelNode(LevelType::ASK, price));
     return (it != _asks.end()) ? it.operator->() : nullptr;
 }
@@ -65,28 +79,27 @@ inline const LevelNode* OrderBook::GetSellStopLevel(uint64_t price) const noexce
     return (it != _sell_stop.end()) ? it.operator->() : nullptr;
 }
 
-inline const LevelNode* OrderBook::GetTrailingBuyStopLevel(uint64_t price) const noexcept
-{
-    auto it = _trailing_buy_stop.find(LevelNode(LevelType::ASK, price));
-    return (it != _trailing_buy_stop.end()) ? it.operator->() : nullptr;
-}
-
-inline const LevelNode* OrderBook::GetTrailingSellStopLevel(uint64_t price) const noexcept
+inline const LevelNode* OrderBook::GetNextLevel(const LevelNode* level) const noexcept
 {
-    auto it = _trailing_sell_stop.find(LevelNode(LevelType::BID, price));
-    return (it != _trailing_sell_stop.end()) ? it.operator->() : nullptr;
+    return const_cast<OrderBook*>(this)->GetNextLevel(const_cast<LevelNode*>(level));
 }
 
 inline LevelNode* OrderBook::GetNextLevel(LevelNode* level) noexcept
 {
     if (level->IsBid())
     {
+        if (_bid_ladder)
+            return GetLowerLevel(_bids, _bid_ladder, level);
+
         Levels::reverse_iterator it(&_bids, level);
         ++it;
         return it.operator->();
     }
     else
     {
+        if (_ask_ladder)
+            return GetHigherLevel(_asks, _ask_ladder, level);
+
         Levels::iterator it(&_asks, level);
         ++it;
         return it.operator->();
@@ -109,20 +122,19 @@ inline LevelNode* OrderBook::GetNextStopLevel(LevelNode* level) noexcept
     }
 }
 
-inline LevelNode* OrderBook::GetNextTrailingStopLevel(LevelNode* level) noexcept
+inline bool OrderBook::UpdateTrailingStopPrice(Order& order, uint64_t stop_price) noexcept
 {
-    if (level->IsBid())
-    {
-        Levels::reverse_iterator it(&_trailing_sell_stop, level);
-        ++it;
-        return it.operator->();
-    }
-    else
+    if (order.StopPrice == stop_price)
+        return false;
+
+    // Trailing stop-limit order keeps the distance between its stop price and price
+    if (order.IsTrailingStopLimit())
     {
-        Levels::iterator it(&_trailing_buy_stop, level);
-        ++it;
-        return it.operator->();
+        int64_t diff = order.Price - order.StopPrice;
+        order.Price = stop_price + diff;
     }
+    order.StopPrice = stop_price;
+    return true;
 }
 
 inline uint64_t OrderBook::GetMarketPriceBid() const noexcept
@@ -0,0 +1,146 @@
+/*!
+    \file price_ladder.h
+    \brief Price ladder definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_PRICE_LADDER_H
+#define TRADING_PLATFORM_MATCHING_PRICE_LADDER_H
+
+#include "bit_scan.h"
+#include "level.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+namespace TradingPlatform {
+namespace Matching {
+
+//! Price ladder
+/*!
+    Price ladder is a direct-indexed array of price levels for a fixed window
+    of ticks. It is used by the order book to keep dense price levels without
+    tree rebalancing.
+
+    Ladder slots are addressed by price ticks modulo the ladder size, so the
+    window could be moved (re-centred) without copying when the ladder is empty.
+    Non-empty slots are marked in a bitmap which is scanned with find-first-set
+    to get the next best price level.
+
+    Only prices inside the window which are multiple of the tick size belong
+    to the ladder. All other prices should be kept by the caller in a fallback
+    container.
+
+    Not thread-safe.
+*/
+class PriceLadder
+{
+public:
+    PriceLadder() noexcept;
+    //! Initialize the price ladder with a given size and tick
+    /*!
+        \param size - Price ladder size in ticks (will be rounded up to the power of two, at least 64)
+        \param tick - Price ladder tick size (default is 1)
+    */
+    PriceLadder(size_t size, uint64_t tick = 1);
+    PriceLadder(const PriceLadder&) = delete;
+    PriceLadder(PriceLadder&&) noexcept = default;
+    ~PriceLadder() noexcept = default;
+
+    PriceLadder& operator=(const PriceLadder&) = delete;
+    PriceLadder& operator=(PriceLadder&&) noexcept = default;
+
+    //! Check if the price ladder is enabled
+    explicit operator bool() const noexcept { return enabled(); }
+
+    //! Is the price ladder enabled?
+    bool enabled() const noexcept { return !_levels.empty(); }
+    //! Is the price ladder empty?
+    bool empty() const noexcept { return _size == 0; }
+
+    //! Get the price ladder size
+    size_t size() const noexcept { return _size; }
+    //! Get the price ladder capacity in ticks
+    size_t capacity() const noexcept { return _levels.size(); }
+    //! Get the price ladder tick size
+    uint64_t tick() const noexcept { return _tick; }
+    //! Get the lowest price of the price ladder window
+    uint64_t low() const noexcept { return _low; }
+    //! Get the highest price (exclusive) of the price ladder window
+    uint64_t high() const noexcept { return _high; }
+
+    //! Check if the given price belongs to the price ladder
+    /*!
+        \param price - Price
+        \return 'true' if the given price is inside the window and is a multiple of the tick size, 'false' otherwise
+    */
+    bool Contains(uint64_t price) const noexcept
+    { return (price >= _low) && (price < _high) && ((_tick == 1) || ((price % _tick) == 0)); }
+
+    //! Get the price level with the given price
+    /*!
+        \param price - Price (must belong to the price ladder)
+        \return Pointer to the price level with the given price or nullptr
+    */
+    LevelNode* Find(uint64_t price) const noexcept
+    { return _levels[Slot(price)]; }
+
+    //! Get the lowest price level
+    LevelNode* Lowest() const noexcept;
+    //! Get the highest price level
+    LevelNode* Highest() const noexcept;
+    //! Get the price level with the nearest price below the given one
+    LevelNode* Lower(uint64_t price) const noexcept;
+    //! Get the price level with the nearest price above the given one
+    LevelNode* Higher(uint64_t price) const noexcept;
+
+    //! Insert the given price level into the price ladder
+    /*!
+        \param level - Price level (price must belong to the price ladder)
+    */
+    void Insert(LevelNode* level) noexcept;
+    //! Erase the given price level from the price ladder
+    /*!
+        \param level - Price level (price must belong to the price ladder)
+    */
+    void Erase(LevelNode* level) noexcept;
+
+    //! Move the price ladder window to be centred around the given price
+    /*!
+        The price ladder must be empty.
+
+        \param price - Centre price
+    */
+    void Recenter(uint64_t price) noexcept;
+
+private:
+    // Price ladder tick size and window
+    uint64_t _tick;
+    uint64_t _low;
+    uint64_t _high;
+    uint64_t _mask;
+
+    // Price levels and non-empty levels bitmap
+    size_t _size;
+    std::vector<LevelNode*> _levels;
+    std::vector<uint64_t> _bitmap;
+
+    // Get the slot index of the given price
+    size_t Slot(uint64_t price) const noexcept
+    { return (size_t)(((_tick == 1) ? price : (price / _tick)) & _mask); }
+
+    // Scan the bitmap for the lowest/highest non-empty price level in the given range of ticks [from, to)
+    LevelNode* ScanUp(uint64_t from, uint64_t to) const noexcept;
+    LevelNode* ScanDown(uint64_t from, uint64_t to) const noexcept;
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#include "price_ladder.inl"
+
+#endif // TRADING_PLATFORM_MATCHING_PRICE_LADDER_H
@@ -0,0 +1,151 @@
+/*!
+    \file price_ladder.inl
+    \brief Price ladder inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace Matching {
+
+inline PriceLadder::PriceLadder() noexcept
+    : _tick(1),
+      _low(0),
+      _high(0),
+      _mask(0),
+      _size(0)
+{
+}
+
+inline PriceLadder::PriceLadder(size_t size, uint64_t tick)
+    : _tick((tick > 0) ? tick : 1),
+      _low(0),
+      _high(0),
+      _mask(0),
+      _size(0)
+{
+    // Round the price ladder capacity up to the power of two bitmap words
+    size_t capacity = 64;
+    while (capacity < size)
+        capacity <<= 1;
+
+    _mask = capacity - 1;
+    _levels.resize(capacity, nullptr);
+    _bitmap.resize(capacity / 64, 0);
+}
+
+inline LevelNode* PriceLadder::Lowest() const noexcept
+{
+    return (_size > 0) ? ScanUp(_low / _tick, _high / _tick) : nullptr;
+}
+
+inline LevelNode* PriceLadder::Highest() const noexcept
+{
+    return (_size > 0) ? ScanDown(_low / _tick, _high / _tick) : nullptr;
+}
+
+inline LevelNode* PriceLadder::Lower(uint64_t price) const noexcept
+{
+    if ((_size == 0) || (price <= _low))
+        return nullptr;
+
+    // Scan all ticks with prices strictly below the given one
+    uint64_t to = (std::min(price, _high) + _tick - 1) / _tick;
+    return ScanDown(_low / _tick, to);
+}
+
+inline LevelNode* PriceLadder::Higher(uint64_t price) const noexcept
+{
+    if ((_size == 0) || (price >= _high))
+        return nullptr;
+
+    // Scan all ticks with prices strictly above the given one
+    uint64_t from = (price < _low) ? (_low / _tick) : (price / _tick + 1);
+    return ScanUp(from, _high / _tick);
+}
+
+inline void PriceLadder::Insert(LevelNode* level) noexcept
+{
+    assert(Contains(level->Price) && "Price level is outside of the price ladder!");
+
+    size_t slot = Slot(level->Price);
+    assert((_levels[slot] == nullptr) && "Duplicate price level detected!");
+
+    _levels[slot] = level;
+    _bitmap[slot >> 6] |= (1ull << (slot & 63));
+    ++_size;
+}
+
+inline void PriceLadder::Erase(LevelNode* level) noexcept
+{
+    assert(Contains(level->Price) && "Price level is outside of the price ladder!");
+
+    size_t slot = Slot(level->Price);
+    assert((_levels[slot] == level) && "Price level not found!");
+
+    _levels[slot] = nullptr;
+    _bitmap[slot >> 6] &= ~(1ull << (slot & 63));
+    --_size;
+}
+
+inline void PriceLadder::Recenter(uint64_t price) noexcept
+{
+    assert(enabled() && "Price ladder is disabled!");
+    assert(empty() && "Price ladder must be empty to be re-centred!");
+
+    uint64_t capacity = _levels.size();
+    uint64_t center = price / _tick;
+    uint64_t low = (center > (capacity / 2)) ? (center - capacity / 2) : 0;
+
+    // Keep the window inside the valid price range
+    uint64_t max = std::numeric_limits<uint64_t>::max() / _tick;
+    if (low > (max - capacity))
+        low = max - capacity;
+
+    _low = low * _tick;
+    _high = (low + capacity) * _tick;
+}
+
+inline LevelNode* PriceLadder::ScanUp(uint64_t from, uint64_t to) const noexcept
+{
+    while (from < to)
+    {
+        // Bitmap words never cross the ladder end, so each step stays inside one word
+        size_t slot = (size_t)(from & _mask);
+        size_t bit = slot & 63;
+        uint64_t span = std::min<uint64_t>(64 - bit, to - from);
+
+        uint64_t bits = _bitmap[slot >> 6] >> bit;
+        if (span < 64)
+            bits &= (1ull << span) - 1;
+        if (bits != 0)
+            return _levels[slot + BitScan::Lowest(bits)];
+
+        from += span;
+    }
+    return nullptr;
+}
+
+inline LevelNode* PriceLadder::ScanDown(uint64_t from, uint64_t to) const noexcept
+{
+    while (from < to)
+    {
+        // Bitmap words never cross the ladder end, so each step stays inside one word
+        size_t slot = (size_t)((to - 1) & _mask);
+        size_t bit = slot & 63;
+        uint64_t span = std::min<uint64_t>(bit + 1, to - from);
+
+        uint64_t bits = _bitmap[slot >> 6] << (63 - bit);
+        if (span < 64)
+            bits &= ~0ull << (64 - span);
+        if (bits != 0)
+            return _levels[slot - (63 - BitScan::Highest(bits))];
+
+        to -= span;
+    }
+    return nullptr;
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
@@ -0,0 +1,212 @@
+/*!
+    \file trailing_stops.h
+    \brief Trailing stop orders container definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_TRAILING_STOPS_H
+#define TRADING_PLATFORM_MATCHING_TRAILING_STOPS_H
+
+#include "level.h"
+
+#include "containers/list.h"
+
+#include <cassert>
+#include <vector>
+
+namespace TradingPlatform {
+namespace Matching {
+
+//! Trailing stop orders bucket
+/*!
+    Bucket keeps trailing stop price levels of orders with the same trailing
+    distance and trailing step. All orders of the bucket follow the market in
+    the same way, so price levels far enough from the market are moved by the
+    market all together into the single price level without touching their
+    orders.
+
+    Orders of moved price levels keep their previous stop prices until they
+    are updated from their price level (see OrderBook::UpdateTrailingStopOrder()).
+*/
+struct TrailingStopBucket : public CppCommon::List<TrailingStopBucket>::Node
+{
+    //! Trailing distance of bucket orders
+    int64_t TrailingDistance;
+    //! Trailing step of bucket orders
+    int64_t TrailingStep;
+
+    //! Trailing stop price levels of the bucket
+    CppCommon::BinTreeAVL<LevelNode, std::less<LevelNode>> Levels;
+    //! Best trailing stop price level of the bucket
+    LevelNode* Best;
+    //! Price levels moved by the market with not updated stop prices of orders
+    std::vector<LevelNode*> Moved;
+
+    TrailingStopBucket(int64_t trailing_distance, int64_t trailing_step) noexcept;
+    TrailingStopBucket(const TrailingStopBucket&) = delete;
+    TrailingStopBucket(TrailingStopBucket&&) noexcept = default;
+    ~TrailingStopBucket() noexcept = default;
+
+    TrailingStopBucket& operator=(const TrailingStopBucket&) = delete;
+    TrailingStopBucket& operator=(TrailingStopBucket&&) noexcept = default;
+};
+
+//! Trailing stop price levels iterator
+/*!
+    Iterates price levels of all buckets, bucket by bucket.
+*/
+class TrailingStopsIterator
+{
+public:
+    TrailingStopsIterator() noexcept : _bucket(nullptr), _level(nullptr) {}
+    explicit TrailingStopsIterator(const TrailingStopBucket* bucket) noexcept;
+    TrailingStopsIterator(const TrailingStopsIterator&) noexcept = default;
+    TrailingStopsIterator(TrailingStopsIterator&&) noexcept = default;
+    ~TrailingStopsIterator() noexcept = default;
+
+    TrailingStopsIterator& operator=(const TrailingStopsIterator&) noexcept = default;
+    TrailingStopsIterator& operator=(TrailingStopsIterator&&) noexcept = default;
+
+    friend bool operator==(const TrailingStopsIterator& it1, const TrailingStopsIterator& it2) noexcept
+    { return it1._level == it2._level; }
+    friend bool operator!=(const TrailingStopsIterator& it1, const TrailingStopsIterator& it2) noexcept
+    { return it1._level != it2._level; }
+
+    TrailingStopsIterator& operator++() noexcept;
+    TrailingStopsIterator operator++(int) noexcept;
+
+    const LevelNode& operator*() const noexcept { return *_level; }
+    const LevelNode* operator->() const noexcept { return _level; }
+
+private:
+    const TrailingStopBucket* _bucket;
+    const LevelNode* _level;
+
+    // Skip empty buckets
+    void SkipBuckets() noexcept;
+};
+
+//! Trailing stop orders container
+/*!
+    Trailing stop orders container keeps trailing stop price levels of the
+    order book side grouped into buckets by trailing distance and trailing
+    step (see TrailingStopBucket). Absolute and percentage trailing distances
+    are kept in different buckets.
+
+    Best trailing stop price level of all buckets is cached to check the
+    trailing stop orders activation in constant time.
+
+    Container is intrusive: price levels and buckets are allocated by the
+    caller.
+
+    Not thread-safe.
+*/
+class TrailingStops
+{
+public:
+    //! Price level container
+    typedef CppCommon::BinTreeAVL<LevelNode, std::less<LevelNode>> Levels;
+    //! Buckets container
+    typedef CppCommon::List<TrailingStopBucket> Buckets;
+    //! Price levels iterator
+    typedef TrailingStopsIterator iterator;
+
+    //! Initialize the trailing stop orders container of the given price levels type
+    /*!
+        Trailing buy stop orders are kept in ask price levels, the best one
+        has the lowest price. Trailing sell stop orders are kept in bid price
+        levels, the best one has the highest price.
+
+        \param type - Price levels type
+    */
+    explicit TrailingStops(LevelType type) noexcept;
+    TrailingStops(const TrailingStops&) = delete;
+    TrailingStops(TrailingStops&&) noexcept = default;
+    ~TrailingStops() noexcept = default;
+
+    TrailingStops& operator=(const TrailingStops&) = delete;
+    TrailingStops& operator=(TrailingStops&&) noexcept = default;
+
+    //! Is the trailing stop orders container empty?
+    bool empty() const noexcept { return _size == 0; }
+
+    //! Get the trailing stop price levels count
+    size_t size() const noexcept { return _size; }
+
+    //! Get the price levels type
+    LevelType type() const noexcept { return _type; }
+
+    //! Get the buckets container
+    const Buckets& buckets() const noexcept { return _buckets; }
+    Buckets& buckets() noexcept { return _buckets; }
+
+    //! Get the best trailing stop price level of all buckets
+    LevelNode* best() const noexcept { return _best; }
+
+    //! Get the begin price levels iterator
+    iterator begin() const noexcept { return iterator(_buckets.front()); }
+    //! Get the end price levels iterator
+    iterator end() const noexcept { return iterator(); }
+
+    //! Get the bucket with the given trailing distance and trailing step
+    /*!
+        \param trailing_distance - Trailing distance
+        \param trailing_step - Trailing step
+        \return Pointer to the bucket or nullptr
+    */
+    TrailingStopBucket* GetBucket(int64_t trailing_distance, int64_t trailing_step) const noexcept;
+    //! Insert the given empty bucket
+    void InsertBucket(TrailingStopBucket* bucket) noexcept;
+    //! Erase the given empty bucket
+    void EraseBucket(TrailingStopBucket* bucket) noexcept;
+
+    //! Get the bucket price level with the given price
+    /*!
+        \param bucket - Bucket
+        \param price - Price
+        \return Pointer to the price level or nullptr
+    */
+    LevelNode* GetLevel(const TrailingStopBucket* bucket, uint64_t price) const noexcept;
+    //! Get the bucket price level which is the most far from the market
+    /*!
+        \param bucket - Bucket
+        \return Pointer to the price level or nullptr if the bucket is empty
+    */
+    LevelNode* GetWorstLevel(const TrailingStopBucket* bucket) const noexcept;
+
+    //! Insert the given price level into the bucket
+    /*!
+        \param bucket - Bucket
+        \param level - Price level (price must not be in the bucket yet)
+    */
+    void InsertLevel(TrailingStopBucket* bucket, LevelNode* level) noexcept;
+    //! Erase the given price level from its bucket
+    /*!
+        Bucket is not erased even if it becomes empty.
+
+        \param level - Price level of the bucket
+    */
+    void EraseLevel(LevelNode* level) noexcept;
+
+private:
+    LevelType _type;
+    Buckets _buckets;
+    LevelNode* _best;
+    size_t _size;
+
+    // Check if the first stop price is closer to the market than the second one
+    bool Better(uint64_t price1, uint64_t price2) const noexcept
+    { return (_type == LevelType::ASK) ? (price1 < price2) : (price1 > price2); }
+
+    // Find the best trailing stop price level of all buckets
+    void UpdateBest() noexcept;
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#include "trailing_stops.inl"
+
+#endif // TRADING_PLATFORM_MATCHING_TRAILING_STOPS_H
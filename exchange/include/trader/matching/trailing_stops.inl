@@ -0,0 +1,161 @@
+/*!
+    \file trailing_stops.inl
+    \brief Trailing stop orders container inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace Matching {
+
+inline TrailingStopBucket::TrailingStopBucket(int64_t trailing_distance, int64_t trailing_step) noexcept
+    : TrailingDistance(trailing_distance),
+      TrailingStep(trailing_step),
+      Best(nullptr)
+{
+}
+
+inline TrailingStopsIterator::TrailingStopsIterator(const TrailingStopBucket* bucket) noexcept
+    : _bucket(bucket),
+      _level(nullptr)
+{
+    SkipBuckets();
+}
+
+inline TrailingStopsIterator& TrailingStopsIterator::operator++() noexcept
+{
+    TrailingStops::Levels::iterator it(const_cast<TrailingStops::Levels*>(&_bucket->Levels), const_cast<LevelNode*>(_level));
+    ++it;
+    _level = it.operator->();
+
+    // Move to the next bucket
+    if (_level == nullptr)
+    {
+        _bucket = _bucket->next;
+        SkipBuckets();
+    }
+
+    return *this;
+}
+
+inline TrailingStopsIterator TrailingStopsIterator::operator++(int) noexcept
+{
+    TrailingStopsIterator result(*this);
+    operator++();
+    return result;
+}
+
+inline void TrailingStopsIterator::SkipBuckets() noexcept
+{
+    for (; _bucket != nullptr; _bucket = _bucket->next)
+    {
+        _level = _bucket->Levels.lowest();
+        if (_level != nullptr)
+            return;
+    }
+}
+
+inline TrailingStops::TrailingStops(LevelType type) noexcept
+    : _type(type),
+      _best(nullptr),
+      _size(0)
+{
+}
+
+inline TrailingStopBucket* TrailingStops::GetBucket(int64_t trailing_distance, int64_t trailing_step) const noexcept
+{
+    // Orders use a few distinct trailing distances, so buckets are searched linearly
+    for (TrailingStopBucket* bucket = _buckets.front(); bucket != nullptr; bucket = bucket->next)
+        if ((bucket->TrailingDistance == trailing_distance) && (bucket->TrailingStep == trailing_step))
+            return bucket;
+    return nullptr;
+}
+
+inline void TrailingStops::InsertBucket(TrailingStopBucket* bucket) noexcept
+{
+    assert(bucket->Levels.empty() && "Bucket must be empty!");
+    _buckets.push_back(*bucket);
+}
+
+inline void TrailingStops::EraseBucket(TrailingStopBucket* bucket) noexcept
+{
+    assert(bucket->Levels.empty() && "Bucket must be empty!");
+    _buckets.pop_current(*bucket);
+}
+
+inline LevelNode* TrailingStops::GetLevel(const TrailingStopBucket* bucket, uint64_t price) const noexcept
+{
+    auto it = bucket->Levels.find(LevelNode(_type, price));
+    return (it != bucket->Levels.end()) ? it.operator->() : nullptr;
+}
+
+inline LevelNode* TrailingStops::GetWorstLevel(const TrailingStopBucket* bucket) const noexcept
+{
+    return (_type == LevelType::ASK) ? bucket->Levels.highest() : bucket->Levels.lowest();
+}
+
+inline void TrailingStops::InsertLevel(TrailingStopBucket* bucket, LevelNode* level) noexcept
+{
+    bucket->Levels.insert(*level);
+    level->Bucket = bucket;
+    ++_size;
+
+    // Update the best price level of the bucket and of all buckets
+    if ((bucket->Best == nullptr) || Better(level->Price, bucket->Best->Price))
+        bucket->Best = level;
+    if ((_best == nullptr) || Better(level->Price, _best->Price))
+        _best = level;
+}
+
+inline void TrailingStops::EraseLevel(LevelNode* level) noexcept
+{
+    TrailingStopBucket* bucket = level->Bucket;
+
+    // Update the best price level of the bucket
+    if (level == bucket->Best)
+    {
+        if (_type == LevelType::ASK)
+        {
+            Levels::iterator it(&bucket->Levels, level);
+            ++it;
+            bucket->Best = it.operator->();
+        }
+        else
+        {
+            Levels::reverse_iterator it(&bucket->Levels, level);
+            ++it;
+            bucket->Best = it.operator->();
+        }
+    }
+
+    bucket->Levels.erase(Levels::iterator(&bucket->Levels, level));
+    level->Bucket = nullptr;
+    --_size;
+
+    // Forget the moved price level
+    for (size_t i = 0; i < bucket->Moved.size(); ++i)
+    {
+        if (bucket->Moved[i] == level)
+        {
+            bucket->Moved[i] = bucket->Moved.back();
+            bucket->Moved.pop_back();
+            break;
+        }
+    }
+
+    // Update the best price level of all buckets
+    if (level == _best)
+        UpdateBest();
+}
+
+inline void TrailingStops::UpdateBest() noexcept
+{
+    _best = nullptr;
+    for (TrailingStopBucket* bucket = _buckets.front(); bucket != nullptr; bucket = bucket->next)
+        if ((bucket->Best != nullptr) && ((_best == nullptr) || Better(bucket->Best->Price, _best->Price)))
+            _best = bucket->Best;
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
@@ -0,0 +1,144 @@
+/*!
+    \file volume_index.h
+    \brief Price level volume index definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_MATCHING_VOLUME_INDEX_H
+#define TRADING_PLATFORM_MATCHING_VOLUME_INDEX_H
+
+#include "fast_hash.h"
+#include "level.h"
+
+#include <cassert>
+
+namespace TradingPlatform {
+namespace Matching {
+
+//! Price level volume index
+/*!
+    Volume index keeps all price levels of the order book side in the price
+    order starting from the best one regardless of the container (price ladder
+    or price level tree) the price level is kept in. Each price level carries
+    the aggregated total, visible and 'All-Or-None' volume of its subtree, so
+    the volume available up to the given price and the price level which
+    completes the given volume are found in logarithmic time.
+
+    Index is an intrusive treap linked through index fields of price levels.
+    Node priorities are hashes of price level prices, so the index shape does
+    not depend on the order of price level insertions.
+
+    Volume changes of indexed price levels must be passed into Add() and
+    Subtract() to keep aggregated volume of subtrees.
+
+    Not thread-safe.
+*/
+class VolumeIndex
+{
+public:
+    //! Aggregated volume of price levels
+    struct Volume
+    {
+        uint64_t TotalVolume;
+        uint64_t VisibleVolume;
+        uint64_t AONVolume;
+    };
+
+    //! Initialize the volume index of the given price levels type
+    /*!
+        Bid price levels are ordered by descending price, ask price levels
+        are ordered by ascending price.
+
+        \param type - Price levels type
+    */
+    explicit VolumeIndex(LevelType type) noexcept;
+    VolumeIndex(const VolumeIndex&) = delete;
+    VolumeIndex(VolumeIndex&&) noexcept = default;
+    ~VolumeIndex() noexcept = default;
+
+    VolumeIndex& operator=(const VolumeIndex&) = delete;
+    VolumeIndex& operator=(VolumeIndex&&) noexcept = default;
+
+    //! Is the volume index empty?
+    bool empty() const noexcept { return _size == 0; }
+
+    //! Get the volume index size
+    size_t size() const noexcept { return _size; }
+
+    //! Get the aggregated volume of all price levels
+    Volume volume() const noexcept;
+
+    //! Insert the given price level into the volume index
+    /*!
+        \param level - Price level (price must not be indexed yet)
+    */
+    void Insert(LevelNode* level) noexcept;
+    //! Erase the given price level from the volume index
+    /*!
+        \param level - Indexed price level
+    */
+    void Erase(LevelNode* level) noexcept;
+
+    //! Add the given volume to the aggregated volume of the price level and its parents
+    /*!
+        Should be called when the volume of the indexed price level is increased.
+
+        \param level - Indexed price level
+        \param total - Total volume
+        \param visible - Visible volume
+        \param aon - 'All-Or-None' volume
+    */
+    void Add(LevelNode* level, uint64_t total, uint64_t visible, uint64_t aon) noexcept;
+    //! Subtract the given volume from the aggregated volume of the price level and its parents
+    /*!
+        Should be called when the volume of the indexed price level is decreased.
+
+        \param level - Indexed price level
+        \param total - Total volume
+        \param visible - Visible volume
+        \param aon - 'All-Or-None' volume
+    */
+    void Subtract(LevelNode* level, uint64_t total, uint64_t visible, uint64_t aon) noexcept;
+
+    //! Get the aggregated volume of price levels from the best one up to the given price (inclusive)
+    /*!
+        \param price - Price
+        \return Aggregated volume of price levels
+    */
+    Volume VolumeToPrice(uint64_t price) const noexcept;
+
+    //! Get the price level at which the total volume from the best price level reaches the given volume
+    /*!
+        \param volume - Volume
+        \return Pointer to the price level or nullptr if the volume index has not enough volume
+    */
+    LevelNode* PriceForVolume(uint64_t volume) const noexcept;
+
+private:
+    LevelType _type;
+    LevelNode* _root;
+    size_t _size;
+
+    // Check if the first price goes before the second one in the index order
+    bool Before(uint64_t price1, uint64_t price2) const noexcept
+    { return (_type == LevelType::BID) ? (price1 > price2) : (price1 < price2); }
+
+    // Get the treap priority of the given price level
+    static uint64_t Priority(const LevelNode* level) noexcept
+    { return FastHash()(level->Price); }
+
+    // Recalculate aggregated volume of the given price level from its children
+    static void Recalculate(LevelNode* level) noexcept;
+
+    // Rotate the given price level above its parent
+    void Rotate(LevelNode* level) noexcept;
+};
+
+} // namespace Matching
+} // namespace TradingPlatform
+
+#include "volume_index.inl"
+
+#endif // TRADING_PLATFORM_MATCHING_VOLUME_INDEX_H
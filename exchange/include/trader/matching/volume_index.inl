@@ -0,0 +1,240 @@
+/*!
+    \file volume_index.inl
+    \brief Price level volume index inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace Matching {
+
+inline VolumeIndex::VolumeIndex(LevelType type) noexcept
+    : _type(type),
+      _root(nullptr),
+      _size(0)
+{
+}
+
+inline VolumeIndex::Volume VolumeIndex::volume() const noexcept
+{
+    if (_root == nullptr)
+        return Volume{ 0, 0, 0 };
+
+    return Volume{ _root->SubtreeTotalVolume, _root->SubtreeVisibleVolume, _root->SubtreeAONVolume };
+}
+
+inline void VolumeIndex::Insert(LevelNode* level) noexcept
+{
+    level->IndexParent = nullptr;
+    level->IndexLeft = nullptr;
+    level->IndexRight = nullptr;
+    level->SubtreeTotalVolume = level->TotalVolume;
+    level->SubtreeVisibleVolume = level->VisibleVolume;
+    level->SubtreeAONVolume = level->AONVolume;
+
+    // Find the leaf position of the price level and account its volume in all parents
+    LevelNode* parent = nullptr;
+    LevelNode* current = _root;
+    while (current != nullptr)
+    {
+        assert((current->Price != level->Price) && "Duplicate price level detected!");
+
+        current->SubtreeTotalVolume += level->TotalVolume;
+        current->SubtreeVisibleVolume += level->VisibleVolume;
+        current->SubtreeAONVolume += level->AONVolume;
+
+        parent = current;
+        current = Before(level->Price, current->Price) ? current->IndexLeft : current->IndexRight;
+    }
+
+    // Link the price level
+    level->IndexParent = parent;
+    if (parent == nullptr)
+        _root = level;
+    else if (Before(level->Price, parent->Price))
+        parent->IndexLeft = level;
+    else
+        parent->IndexRight = level;
+    ++_size;
+
+    // Restore the heap order of priorities
+    while ((level->IndexParent != nullptr) && (Priority(level) > Priority(level->IndexParent)))
+        Rotate(level);
+}
+
+inline void VolumeIndex::Erase(LevelNode* level) noexcept
+{
+    // Move the price level down to the leaf position
+    while ((level->IndexLeft != nullptr) || (level->IndexRight != nullptr))
+    {
+        LevelNode* child;
+        if (level->IndexLeft == nullptr)
+            child = level->IndexRight;
+        else if (level->IndexRight == nullptr)
+            child = level->IndexLeft;
+        else
+            child = (Priority(level->IndexLeft) > Priority(level->IndexRight)) ? level->IndexLeft : level->IndexRight;
+        Rotate(child);
+    }
+
+    // Unlink the price level
+    LevelNode* parent = level->IndexParent;
+    if (parent == nullptr)
+        _root = nullptr;
+    else if (parent->IndexLeft == level)
+        parent->IndexLeft = nullptr;
+    else
+        parent->IndexRight = nullptr;
+    level->IndexParent = nullptr;
+    --_size;
+
+    // Remove the price level volume from all parents (order book erases only empty price levels)
+    if ((level->TotalVolume == 0) && (level->VisibleVolume == 0) && (level->AONVolume == 0))
+        return;
+    for (; parent != nullptr; parent = parent->IndexParent)
+    {
+        parent->SubtreeTotalVolume -= level->TotalVolume;
+        parent->SubtreeVisibleVolume -= level->VisibleVolume;
+        parent->SubtreeAONVolume -= level->AONVolume;
+    }
+}
+
+inline void VolumeIndex::Add(LevelNode* level, uint64_t total, uint64_t visible, uint64_t aon) noexcept
+{
+    for (; level != nullptr; level = level->IndexParent)
+    {
+        level->SubtreeTotalVolume += total;
+        level->SubtreeVisibleVolume += visible;
+        level->SubtreeAONVolume += aon;
+    }
+}
+
+inline void VolumeIndex::Subtract(LevelNode* level, uint64_t total, uint64_t visible, uint64_t aon) noexcept
+{
+    for (; level != nullptr; level = level->IndexParent)
+    {
+        level->SubtreeTotalVolume -= total;
+        level->SubtreeVisibleVolume -= visible;
+        level->SubtreeAONVolume -= aon;
+    }
+}
+
+inline VolumeIndex::Volume VolumeIndex::VolumeToPrice(uint64_t price) const noexcept
+{
+    Volume result = { 0, 0, 0 };
+
+    LevelNode* current = _root;
+    while (current != nullptr)
+    {
+        // Skip price levels behind the given price
+        if (Before(price, current->Price))
+        {
+            current = current->IndexLeft;
+            continue;
+        }
+
+        // Take the current price level with its left subtree
+        if (current->IndexLeft != nullptr)
+        {
+            result.TotalVolume += current->IndexLeft->SubtreeTotalVolume;
+            result.VisibleVolume += current->IndexLeft->SubtreeVisibleVolume;
+            result.AONVolume += current->IndexLeft->SubtreeAONVolume;
+        }
+        result.TotalVolume += current->TotalVolume;
+        result.VisibleVolume += current->VisibleVolume;
+        result.AONVolume += current->AONVolume;
+
+        current = current->IndexRight;
+    }
+
+    return result;
+}
+
+inline LevelNode* VolumeIndex::PriceForVolume(uint64_t volume) const noexcept
+{
+    if (volume == 0)
+        return nullptr;
+
+    LevelNode* current = _root;
+    while (current != nullptr)
+    {
+        // The volume is reached in the left subtree
+        uint64_t left = (current->IndexLeft != nullptr) ? current->IndexLeft->SubtreeTotalVolume : 0;
+        if (volume <= left)
+        {
+            current = current->IndexLeft;
+            continue;
+        }
+        volume -= left;
+
+        // The volume is reached at the current price level
+        if (volume <= current->TotalVolume)
+            return current;
+        volume -= current->TotalVolume;
+
+        current = current->IndexRight;
+    }
+
+    return nullptr;
+}
+
+inline void VolumeIndex::Recalculate(LevelNode* level) noexcept
+{
+    level->SubtreeTotalVolume = level->TotalVolume;
+    level->SubtreeVisibleVolume = level->VisibleVolume;
+    level->SubtreeAONVolume = level->AONVolume;
+
+    if (level->IndexLeft != nullptr)
+    {
+        level->SubtreeTotalVolume += level->IndexLeft->SubtreeTotalVolume;
+        level->SubtreeVisibleVolume += level->IndexLeft->SubtreeVisibleVolume;
+        level->SubtreeAONVolume += level->IndexLeft->SubtreeAONVolume;
+    }
+
+    if (level->IndexRight != nullptr)
+    {
+        level->SubtreeTotalVolume += level->IndexRight->SubtreeTotalVolume;
+        level->SubtreeVisibleVolume += level->IndexRight->SubtreeVisibleVolume;
+        level->SubtreeAONVolume += level->IndexRight->SubtreeAONVolume;
+    }
+}
+
+inline void VolumeIndex::Rotate(LevelNode* level) noexcept
+{
+    LevelNode* parent = level->IndexParent;
+    LevelNode* grandparent = parent->IndexParent;
+
+    // Move the inner subtree of the price level to its parent
+    if (parent->IndexLeft == level)
+    {
+        parent->IndexLeft = level->IndexRight;
+        if (level->IndexRight != nullptr)
+            level->IndexRight->IndexParent = parent;
+        level->IndexRight = parent;
+    }
+    else
+    {
+        parent->IndexRight = level->IndexLeft;
+        if (level->IndexLeft != nullptr)
+            level->IndexLeft->IndexParent = parent;
+        level->IndexLeft = parent;
+    }
+    parent->IndexParent = level;
+
+    // Link the price level to the grandparent
+    level->IndexParent = grandparent;
+    if (grandparent == nullptr)
+        _root = level;
+    else if (grandparent->IndexLeft == parent)
+        grandparent->IndexLeft = level;
+    else
+        grandparent->IndexRight = level;
+
+    // Only aggregated volume of rotated price levels is changed
+    Recalculate(parent);
+    Recalculate(level);
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
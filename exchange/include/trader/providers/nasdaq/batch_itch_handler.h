@@ -0,0 +1,153 @@
+/*!
+    \file batch_itch_handler.h
+    \brief NASDAQ ITCH batch handler definition
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#ifndef TRADING_PLATFORM_ITCH_BATCH_HANDLER_H
+#define TRADING_PLATFORM_ITCH_BATCH_HANDLER_H
+
+#include "itch_handler.h"
+
+#include <array>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace TradingPlatform {
+namespace ITCH {
+
+//! Batch of order messages
+/*!
+    Fields of add order, order executed, order executed with price, order
+    cancel, order delete and order replace messages are decoded into separate
+    columns (structure of arrays), so handlers could process the whole batch
+    with tight loops over the fields they need. Messages keep their order in
+    the stream, Type column tells the message type. Only the first Size
+    elements of columns are valid.
+
+    Fields missing in the message type are zero. Columns with fields of
+    different messages:
+    \li OrderReferenceNumber - original order reference number of replace messages
+    \li Shares - executed shares of execution messages and canceled shares of cancel messages
+    \li Price - execution price of execution with price messages
+*/
+struct OrderMessageBatch
+{
+    //! Count of messages in the batch
+    size_t Size;
+
+    std::vector<char> Type;
+    std::vector<uint16_t> StockLocate;
+    std::vector<uint16_t> TrackingNumber;
+    std::vector<uint64_t> Timestamp;
+    std::vector<uint64_t> OrderReferenceNumber;
+    std::vector<uint64_t> NewOrderReferenceNumber;
+    std::vector<char> BuySellIndicator;
+    std::vector<uint32_t> Shares;
+    std::vector<std::array<char, 8>> Stock;
+    std::vector<uint32_t> Price;
+    std::vector<uint64_t> MatchNumber;
+    std::vector<char> Printable;
+
+    //! Resize columns to the given capacity
+    void Resize(size_t capacity);
+};
+
+//! NASDAQ ITCH batch handler class
+/*!
+    NASDAQ ITCH batch handler processes the whole received buffer at once.
+    At first it scans length-prefixed frames of the buffer and builds the
+    frame index. Then consecutive order messages (add, execute, cancel,
+    delete and replace) are decoded together into columns of the batch and
+    passed into the onMessages() handler. Other messages are processed one
+    by one as usual.
+
+    Order messages share the same header layout, which is byte-swapped with
+    a single SSSE3 shuffle when the build enables it. Other fields are read
+    from offsets of the layout table of the message type, so decoding does
+    not branch on the message type. Market data feeds interleave message
+    types, so batches of the same type would be only a couple of messages
+    long.
+
+    Default onMessages() handlers pass every message of the batch into the
+    corresponding onMessage() handler, so the batch processing gives the
+    same sequence of messages as Process() does. Frames split between buffers
+    are completed in the reassembly buffer of the ITCH handler.
+
+    Not thread-safe.
+*/
+class BatchITCHHandler : public ITCHHandler
+{
+public:
+    //! Initialize the batch handler with the given frames capacity of the batch
+    explicit BatchITCHHandler(size_t capacity = 1024);
+    BatchITCHHandler(const BatchITCHHandler&) = delete;
+    BatchITCHHandler(BatchITCHHandler&&) noexcept = default;
+    virtual ~BatchITCHHandler() = default;
+
+    BatchITCHHandler& operator=(const BatchITCHHandler&) = delete;
+    BatchITCHHandler& operator=(BatchITCHHandler&&) noexcept = default;
+
+    //! Process all messages from the given buffer in ITCH format in batches and call corresponding handlers
+    /*!
+        \param buffer - Buffer to process
+        \param size - Buffer size
+        \return 'true' if the given buffer was successfully processed, 'false' if the given buffer process was failed
+    */
+    bool ProcessBatch(void* buffer, size_t size);
+
+protected:
+    // Order messages batch handler
+    virtual bool onMessages(const OrderMessageBatch& batch);
+
+private:
+    size_t _capacity;
+
+    // Frame index
+    std::vector<uint8_t*> _frames;
+    std::vector<uint16_t> _sizes;
+    std::vector<uint8_t> _layouts;
+
+    // Order messages batch
+    OrderMessageBatch _orders;
+
+    // Offsets of order message fields, missing fields are read from the offset 0 and masked out
+    struct Layout
+    {
+        uint8_t Size;
+        uint8_t NewOrderReferenceNumber;
+        uint8_t BuySellIndicator;
+        uint8_t Shares;
+        uint8_t Stock;
+        uint8_t Price;
+        uint8_t MatchNumber;
+        uint8_t Printable;
+        uint64_t NewOrderReferenceNumberMask;
+        uint64_t StockMask;
+        uint64_t MatchNumberMask;
+        uint32_t SharesMask;
+        uint32_t PriceMask;
+        uint8_t BuySellIndicatorMask;
+        uint8_t PrintableMask;
+    };
+
+    // Layouts of order messages, the first one is used for other messages
+    static const Layout LAYOUTS[7];
+
+    size_t IndexFrames(uint8_t* data, size_t size, size_t& count);
+    bool ProcessFrames(size_t count);
+    bool ProcessOrders(size_t first, size_t last);
+
+    static void Decode(OrderMessageBatch& batch, uint8_t* const* frames, const uint8_t* layouts, size_t count);
+};
+
+} // namespace ITCH
+} // namespace TradingPlatform
+
+#include "batch_itch_handler.inl"
+
+#endif // TRADING_PLATFORM_ITCH_BATCH_HANDLER_H
@@ -0,0 +1,79 @@
+/*!
+    \file batch_itch_handler.inl
+    \brief NASDAQ ITCH batch handler inline implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+namespace TradingPlatform {
+namespace ITCH {
+
+inline void BatchITCHHandler::Decode(OrderMessageBatch& batch, uint8_t* const* frames, const uint8_t* layouts, size_t count)
+{
+    // Column pointers are kept in locals, because char stores could alias the columns storage
+    char* types = batch.Type.data();
+    uint16_t* stock_locates = batch.StockLocate.data();
+    uint16_t* tracking_numbers = batch.TrackingNumber.data();
+    uint64_t* timestamps = batch.Timestamp.data();
+    uint64_t* references = batch.OrderReferenceNumber.data();
+    uint64_t* new_references = batch.NewOrderReferenceNumber.data();
+    char* buy_sell_indicators = batch.BuySellIndicator.data();
+    uint32_t* shares = batch.Shares.data();
+    std::array<char, 8>* stocks = batch.Stock.data();
+    uint32_t* prices = batch.Price.data();
+    uint64_t* match_numbers = batch.MatchNumber.data();
+    char* printables = batch.Printable.data();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint8_t* data = frames[i];
+        const Layout& layout = LAYOUTS[layouts[i]];
+
+        types[i] = (char)data[0];
+        CppCommon::Endian::ReadBigEndian(data + 1, stock_locates[i]);
+        CppCommon::Endian::ReadBigEndian(data + 3, tracking_numbers[i]);
+
+        // Timestamp is decoded the same way as ReadTimestamp() does
+#if defined(__SSSE3__)
+        // Swap timestamp and order reference number bytes with one shuffle
+        const __m128i mask = _mm_setr_epi8(4, 3, 2, -1, -1, -1, -1, -1, 15, 14, 13, 12, 11, 10, 9, 8);
+        __m128i fields = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 3)), mask);
+        _mm_storel_epi64((__m128i*)&timestamps[i], fields);
+        _mm_storel_epi64((__m128i*)&references[i], _mm_unpackhi_epi64(fields, fields));
+#else
+        timestamps[i] = ((uint64_t)data[5] << 16) | ((uint64_t)data[6] << 8) | (uint64_t)data[7];
+        CppCommon::Endian::ReadBigEndian(data + 11, references[i]);
+#endif
+
+        uint64_t new_reference;
+        CppCommon::Endian::ReadBigEndian(data + layout.NewOrderReferenceNumber, new_reference);
+        new_references[i] = new_reference & layout.NewOrderReferenceNumberMask;
+
+        buy_sell_indicators[i] = (char)(data[layout.BuySellIndicator] & layout.BuySellIndicatorMask);
+
+        uint32_t share;
+        CppCommon::Endian::ReadBigEndian(data + layout.Shares, share);
+        shares[i] = share & layout.SharesMask;
+
+        uint64_t stock;
+        std::memcpy(&stock, data + layout.Stock, sizeof(stock));
+        stock &= layout.StockMask;
+        std::memcpy(stocks[i].data(), &stock, sizeof(stock));
+
+        uint32_t price;
+        CppCommon::Endian::ReadBigEndian(data + layout.Price, price);
+        prices[i] = price & layout.PriceMask;
+
+        uint64_t match;
+        CppCommon::Endian::ReadBigEndian(data + layout.MatchNumber, match);
+        match_numbers[i] = match & layout.MatchNumberMask;
+
+        printables[i] = (char)(data[layout.Printable] & layout.PrintableMask);
+    }
+
+    batch.Size = count;
+}
+
+} // namespace ITCH
+} // namespace TradingPlatform
@@ -12,6 +12,7 @@
 #include "utility/endian.h"
 #include "utility/iostream.h"
 
+#include <type_traits>
 #include <vector>
 
 namespace TradingPlatform {
@@ -22,25 +23,20 @@ namespace TradingPlatform {
 */
 namespace ITCH {
 
-//! Base class for all ITCH messages
-class SerializableMessage
-{
-public:
-    virtual size_t serialize(void *buffer, size_t size) const = 0;
-    virtual bool deserialize(void *buffer, size_t size) = 0;
-
-protected:
-    template <size_t N>
-    static size_t ReadString(const void* buffer, char (&str)[N]);
-    template <size_t N>
-    static size_t WriteString(void* buffer, const char (&str)[N]);
+//! Read the fixed size string of the ITCH message
+template <size_t N>
+size_t ReadString(const void* buffer, char (&str)[N]);
+//! Write the fixed size string of the ITCH message
+template <size_t N>
+size_t WriteString(void* buffer, const char (&str)[N]);
 
-    static size_t ReadTimestamp(const void* buffer, uint64_t& value);
-    static size_t WriteTimestamp(void* buffer, const uint64_t& value);
-};
+//! Read the 6 bytes timestamp of the ITCH message
+size_t ReadTimestamp(const void* buffer, uint64_t& value);
+//! Write the 6 bytes timestamp of the ITCH message
+size_t WriteTimestamp(void* buffer, const uint64_t& value);
 
 //! System Event Message
-struct SystemEventMessage : public SerializableMessage
+struct SystemEventMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -48,15 +44,17 @@ struct SystemEventMessage : public SerializableMessage
     uint64_t Timestamp;
     char EventCode;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 12;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const SystemEventMessage& message);
 };
 
 //! Stock Directory Message
-struct StockDirectoryMessage : public SerializableMessage
+struct StockDirectoryMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -77,15 +75,17 @@ struct StockDirectoryMessage : public SerializableMessage
     uint32_t ETPLeverageFactor;
     char InverseIndicator;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 39;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const StockDirectoryMessage& message);
 };
 
 //! Stock Trading Action Message
-struct StockTradingActionMessage : public SerializableMessage
+struct StockTradingActionMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -94,17 +94,19 @@ struct StockTradingActionMessage : public SerializableMessage
     char Stock[8];
     char TradingState;
     char Reserved;
-    char Reason;
+    char Reason[4];
+
+    static constexpr size_t SIZE = 25;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const StockTradingActionMessage& message);
 };
 
 //! Reg SHO Short Sale Price Test Restricted Indicator Message
-struct RegSHOMessage : public SerializableMessage
+struct RegSHOMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -113,15 +115,17 @@ struct RegSHOMessage : public SerializableMessage
     char Stock[8];
     char RegSHOAction;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 20;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const RegSHOMessage& message);
 };
 
 //! Market Participant Position Message
-struct MarketParticipantPositionMessage : public SerializableMessage
+struct MarketParticipantPositionMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -133,15 +137,17 @@ struct MarketParticipantPositionMessage : public SerializableMessage
     char MarketMakerMode;
     char MarketParticipantState;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 26;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const MarketParticipantPositionMessage& message);
 };
 
 //! MWCB Decline Level Message
-struct MWCBDeclineMessage : public SerializableMessage
+struct MWCBDeclineMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -151,15 +157,17 @@ struct MWCBDeclineMessage : public SerializableMessage
     uint64_t Level2;
     uint64_t Level3;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 35;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const MWCBDeclineMessage& message);
 };
 
 //! MWCB Status Message
-struct MWCBStatusMessage : public SerializableMessage
+struct MWCBStatusMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -167,15 +175,17 @@ struct MWCBStatusMessage : public SerializableMessage
     uint64_t Timestamp;
     char BreachedLevel;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 12;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const MWCBStatusMessage& message);
 };
 
 //! IPO Quoting Period Update Message
-struct IPOQuotingMessage : public SerializableMessage
+struct IPOQuotingMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -186,15 +196,17 @@ struct IPOQuotingMessage : public SerializableMessage
     char IPOReleaseQualifier;
     uint32_t IPOPrice;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 28;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const IPOQuotingMessage& message);
 };
 
 //! Add Order Message
-struct AddOrderMessage : public SerializableMessage
+struct AddOrderMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -206,15 +218,17 @@ struct AddOrderMessage : public SerializableMessage
     char Stock[8];
     uint32_t Price;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 36;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const AddOrderMessage& message);
 };
 
 //! Add Order with MPID Attribution Message
-struct AddOrderMPIDMessage : public SerializableMessage
+struct AddOrderMPIDMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -225,17 +239,19 @@ struct AddOrderMPIDMessage : public SerializableMessage
     uint32_t Shares;
     char Stock[8];
     uint32_t Price;
-    char Attribution;
+    char Attribution[4];
+
+    static constexpr size_t SIZE = 40;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const AddOrderMPIDMessage& message);
 };
 
 //! Order Executed Message
-struct OrderExecutedMessage : public SerializableMessage
+struct OrderExecutedMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -245,15 +261,17 @@ struct OrderExecutedMessage : public SerializableMessage
     uint32_t ExecutedShares;
     uint64_t MatchNumber;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 31;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderExecutedMessage& message);
 };
 
 //! Order Executed With Price Message
-struct OrderExecutedWithPriceMessage : public SerializableMessage
+struct OrderExecutedWithPriceMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -265,15 +283,17 @@ struct OrderExecutedWithPriceMessage : public SerializableMessage
     char Printable;
     uint32_t ExecutionPrice;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 36;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderExecutedWithPriceMessage& message);
 };
 
 //! Order Cancel Message
-struct OrderCancelMessage : public SerializableMessage
+struct OrderCancelMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -282,15 +302,17 @@ struct OrderCancelMessage : public SerializableMessage
     uint64_t OrderReferenceNumber;
     uint32_t CanceledShares;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 23;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderCancelMessage& message);
 };
 
 //! Order Delete Message
-struct OrderDeleteMessage : public SerializableMessage
+struct OrderDeleteMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -298,15 +320,17 @@ struct OrderDeleteMessage : public SerializableMessage
     uint64_t Timestamp;
     uint64_t OrderReferenceNumber;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 19;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderDeleteMessage& message);
 };
 
 //! Order Replace Message
-struct OrderReplaceMessage : public SerializableMessage
+struct OrderReplaceMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -317,15 +341,17 @@ struct OrderReplaceMessage : public SerializableMessage
     uint32_t Shares;
     uint32_t Price;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 35;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderReplaceMessage& message);
 };
 
 //! Trade Message
-struct TradeMessage : public SerializableMessage
+struct TradeMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -338,15 +364,17 @@ struct TradeMessage : public SerializableMessage
     uint32_t Price;
     uint64_t MatchNumber;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 44;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const TradeMessage& message);
 };
 
 //! Cross Trade Message
-struct CrossTradeMessage : public SerializableMessage
+struct CrossTradeMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -358,15 +386,17 @@ struct CrossTradeMessage : public SerializableMessage
     uint64_t MatchNumber;
     char CrossType;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 40;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const CrossTradeMessage& message);
 };
 
 //! Broken Trade Message
-struct BrokenTradeMessage : public SerializableMessage
+struct BrokenTradeMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -374,15 +404,17 @@ struct BrokenTradeMessage : public SerializableMessage
     uint64_t Timestamp;
     uint64_t MatchNumber;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 19;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const BrokenTradeMessage& message);
 };
 
 //! Net Order Imbalance Indicator (NOII) Message
-struct NOIIMessage : public SerializableMessage
+struct NOIIMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -398,15 +430,17 @@ struct NOIIMessage : public SerializableMessage
     char CrossType;
     char PriceVariationIndicator;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 50;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const NOIIMessage& message);
 };
 
 //! Retail Price Improvement Indicator (RPII) Messsage
-struct RPIIMessage : public SerializableMessage
+struct RPIIMessage
 {
     char Type;
     uint16_t StockLocate;
@@ -415,25 +449,52 @@ struct RPIIMessage : public SerializableMessage
     char Stock[8];
     char InterestFlag;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 20;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const RPIIMessage& message);
 };
 
 //! Unknown message
-struct UnknownMessage : public SerializableMessage
+struct UnknownMessage
 {
     char Type;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 1;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const UnknownMessage& message);
 };
 
+// Messages are plain structs, so they could be copied into buffers and logs as is
+static_assert(std::is_trivially_copyable<SystemEventMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<StockDirectoryMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<StockTradingActionMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<RegSHOMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<MarketParticipantPositionMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<MWCBDeclineMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<MWCBStatusMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<IPOQuotingMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<AddOrderMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<AddOrderMPIDMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderExecutedMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderExecutedWithPriceMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderCancelMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderDeleteMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderReplaceMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<TradeMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<CrossTradeMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<BrokenTradeMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<NOIIMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<RPIIMessage>::value, "ITCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<UnknownMessage>::value, "ITCH message must be trivially copyable!");
+
 //! NASDAQ ITCH handler class
 /*!
     NASDAQ ITCH handler is used to parse NASDAQ ITCH protocol and handle its
@@ -473,6 +534,9 @@ public:
     */
     bool ProcessMessage(void* buffer, size_t size);
 
+    //! Get count of frames split between buffers and completed in the reassembly buffer
+    uint64_t fragmented() const noexcept { return _fragmented; }
+
     //! Reset ITCH handler
     void Reset();
 
@@ -500,6 +564,13 @@ protected:
     virtual bool onMessage(const RPIIMessage& message) { return true; }
     virtual bool onMessage(const UnknownMessage& message) { return true; }
 
+    // Check if there is an incomplete frame in the reassembly buffer
+    bool cached() const noexcept { return _cached > 0; }
+    // Complete the frame of the reassembly buffer from the given buffer and process it
+    size_t ProcessCache(uint8_t* data, size_t size, bool& result);
+    // Keep the incomplete frame in the reassembly buffer till the next buffer
+    void CacheFrame(const uint8_t* data, size_t size);
+
 private:
     bool ProcessSystemEventMessage(void* buffer, size_t size);
     bool ProcessStockDirectoryMessage(void* buffer, size_t size);
@@ -524,8 +595,10 @@ private:
     bool ProcessUnknownMessage(void* buffer, size_t size);
 
 private:
-    size_t _size;
-    std::vector<uint8_t> _cache;
+    // Reassembly buffer of the frame split between buffers: 2 bytes size and up to 64KiB message
+    uint8_t _cache[2 + 65535];
+    size_t _cached;
+    uint64_t _fragmented;
 };
 
 /*! \example itch_handler.cpp NASDAQ ITCH handler example */
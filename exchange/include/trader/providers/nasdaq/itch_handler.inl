@@ -13,9 +13,8 @@ namespace ITCH {
 
 inline size_t SystemEventMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 12) && "Invalid size of the ITCH message type 'S'");
-    if (size < 12)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'S'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -25,13 +24,13 @@ inline size_t SystemEventMessage::serialize(void *buffer, size_t size) const
     data += WriteTimestamp(data, this->Timestamp);
     *data++ = this->EventCode;
     
-    return size;
+    return SIZE;
 }
 
 inline bool SystemEventMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 12) && "Invalid size of the ITCH message type 'S'");
-    if (size < 12)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'S'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -59,9 +58,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const SystemEventMessage
 
 inline size_t StockDirectoryMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 39) && "Invalid size of the ITCH message type 'R'");
-    if (size < 39)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'R'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -84,13 +82,13 @@ inline size_t StockDirectoryMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->ETPLeverageFactor);
     *data++ = this->InverseIndicator;
 
-    return size;
+    return SIZE;
 }
 
 inline bool StockDirectoryMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 39) && "Invalid size of the ITCH message type 'R'");
-    if (size < 39)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'R'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -144,9 +142,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const StockDirectoryMess
 
 inline size_t StockTradingActionMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 25) && "Invalid size of the ITCH message type 'H'");
-    if (size < 25)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'H'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -157,15 +154,15 @@ inline size_t StockTradingActionMessage::serialize(void *buffer, size_t size) co
     data += WriteString(data, this->Stock);
     *data++ = this->TradingState;
     *data++ = this->Reserved;
-    *data++ = this->Reason;
+    data += WriteString(data, this->Reason);
 
-    return size;
+    return SIZE;
 }
 
 inline bool StockTradingActionMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 25) && "Invalid size of the ITCH message type 'H'");
-    if (size < 25)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'H'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -177,7 +174,7 @@ inline bool StockTradingActionMessage::deserialize(void *buffer, size_t size)
     data += ReadString(data, this->Stock);
     this->TradingState = *data++;
     this->Reserved = *data++;
-    this->Reason = *data++;
+    data += ReadString(data, this->Reason);
 
     return true;
 }
@@ -192,16 +189,15 @@ inline TOutputStream& operator<<(TOutputStream& stream, const StockTradingAction
         << "; Stock=" << CppCommon::WriteString(message.Stock)
         << "; TradingState=" << CppCommon::WriteChar(message.TradingState)
         << "; Reserved=" << CppCommon::WriteChar(message.Reserved)
-        << "; Reason=" << CppCommon::WriteChar(message.Reason)
+        << "; Reason=" << CppCommon::WriteString(message.Reason)
         << ")";
     return stream;
 }
 
 inline size_t RegSHOMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 20) && "Invalid size of the ITCH message type 'Y'");
-    if (size < 20)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'Y'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -212,13 +208,13 @@ inline size_t RegSHOMessage::serialize(void *buffer, size_t size) const
     data += WriteString(data, this->Stock);
     *data++ = this->RegSHOAction;
 
-    return size;
+    return SIZE;
 }
 
 inline bool RegSHOMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 20) && "Invalid size of the ITCH message type 'Y'");
-    if (size < 20)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'Y'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -248,9 +244,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const RegSHOMessage& mes
 
 inline size_t MarketParticipantPositionMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 26) && "Invalid size of the ITCH message type 'L'");
-    if (size < 26)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'L'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -264,13 +259,13 @@ inline size_t MarketParticipantPositionMessage::serialize(void *buffer, size_t s
     *data++ = this->MarketMakerMode;
     *data++ = this->MarketParticipantState;
 
-    return size;
+    return SIZE;
 }
 
 inline bool MarketParticipantPositionMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 26) && "Invalid size of the ITCH message type 'L'");
-    if (size < 26)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'L'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -306,9 +301,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const MarketParticipantP
 
 inline size_t MWCBDeclineMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 35) && "Invalid size of the ITCH message type 'V'");
-    if (size < 35)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'V'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -320,13 +314,13 @@ inline size_t MWCBDeclineMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->Level2);
     data += CppCommon::Endian::WriteBigEndian(data, this->Level3);
 
-    return size;
+    return SIZE;
 }
 
 inline bool MWCBDeclineMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 35) && "Invalid size of the ITCH message type 'V'");
-    if (size < 35)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'V'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -358,9 +352,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const MWCBDeclineMessage
 
 inline size_t MWCBStatusMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 12) && "Invalid size of the ITCH message type 'W'");
-    if (size < 12)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'W'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -370,13 +363,13 @@ inline size_t MWCBStatusMessage::serialize(void *buffer, size_t size) const
     data += WriteTimestamp(data, this->Timestamp);
     *data++ = this->BreachedLevel;
 
-    return size;
+    return SIZE;
 }
 
 inline bool MWCBStatusMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 12) && "Invalid size of the ITCH message type 'W'");
-    if (size < 12)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'W'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -404,9 +397,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const MWCBStatusMessage&
 
 inline size_t IPOQuotingMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 28) && "Invalid size of the ITCH message type 'W'");
-    if (size < 28)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'W'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -419,13 +411,13 @@ inline size_t IPOQuotingMessage::serialize(void *buffer, size_t size) const
     *data++ = this->IPOReleaseQualifier;
     data += CppCommon::Endian::WriteBigEndian(data, this->IPOPrice);
 
-    return size;
+    return SIZE;
 }
 
 inline bool IPOQuotingMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 28) && "Invalid size of the ITCH message type 'W'");
-    if (size < 28)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'W'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -459,9 +451,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const IPOQuotingMessage&
 
 inline size_t AddOrderMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 36) && "Invalid size of the ITCH message type 'A'");
-    if (size < 36)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'A'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -475,13 +466,13 @@ inline size_t AddOrderMessage::serialize(void *buffer, size_t size) const
     data += WriteString(data, this->Stock);
     data += CppCommon::Endian::WriteBigEndian(data, this->Price);
     
-    return size;
+    return SIZE;
 }
 
 inline bool AddOrderMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 36) && "Invalid size of the ITCH message type 'A'");
-    if (size < 36)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'A'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -517,9 +508,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const AddOrderMessage& m
 
 inline size_t AddOrderMPIDMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 40) && "Invalid size of the ITCH message type 'F'");
-    if (size < 40)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'F'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -532,15 +522,15 @@ inline size_t AddOrderMPIDMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->Shares);
     data += WriteString(data, this->Stock);
     data += CppCommon::Endian::WriteBigEndian(data, this->Price);
-    *data++ = this->Attribution;
+    data += WriteString(data, this->Attribution);
 
-    return size;
+    return SIZE;
 }
 
 inline bool AddOrderMPIDMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 40) && "Invalid size of the ITCH message type 'F'");
-    if (size < 40)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'F'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -554,7 +544,7 @@ inline bool AddOrderMPIDMessage::deserialize(void *buffer, size_t size)
     data += CppCommon::Endian::ReadBigEndian(data, this->Shares);
     data += ReadString(data, this->Stock);
     data += CppCommon::Endian::ReadBigEndian(data, this->Price);
-    this->Attribution = *data++;
+    data += ReadString(data, this->Attribution);
 
     return true;
 }
@@ -571,16 +561,15 @@ inline TOutputStream& operator<<(TOutputStream& stream, const AddOrderMPIDMessag
         << "; Shares=" << message.Shares
         << "; Stock=" << CppCommon::WriteString(message.Stock)
         << "; Price=" << message.Price
-        << "; Attribution=" << CppCommon::WriteChar(message.Attribution)
+        << "; Attribution=" << CppCommon::WriteString(message.Attribution)
         << ")";
     return stream;
 }
 
 inline size_t OrderExecutedMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 31) && "Invalid size of the ITCH message type 'E'");
-    if (size < 31)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'E'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -592,13 +581,13 @@ inline size_t OrderExecutedMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->ExecutedShares);
     data += CppCommon::Endian::WriteBigEndian(data, this->MatchNumber);
 
-    return size;
+    return SIZE;
 }
 
 inline bool OrderExecutedMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 31) && "Invalid size of the ITCH message type 'E'");
-    if (size < 31)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'E'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -630,9 +619,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderExecutedMessa
 
 inline size_t OrderExecutedWithPriceMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 36) && "Invalid size of the ITCH message type 'C'");
-    if (size < 36)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'C'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -646,13 +634,13 @@ inline size_t OrderExecutedWithPriceMessage::serialize(void *buffer, size_t size
     *data++ = this->Printable;
     data += CppCommon::Endian::WriteBigEndian(data, this->ExecutionPrice);
 
-    return size;
+    return SIZE;
 }
 
 inline bool OrderExecutedWithPriceMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 36) && "Invalid size of the ITCH message type 'C'");
-    if (size < 36)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'C'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -688,9 +676,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderExecutedWithP
 
 inline size_t OrderCancelMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 23) && "Invalid size of the ITCH message type 'X'");
-    if (size < 23)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'X'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -701,13 +688,13 @@ inline size_t OrderCancelMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->OrderReferenceNumber);
     data += CppCommon::Endian::WriteBigEndian(data, this->CanceledShares);
 
-    return size;
+    return SIZE;
 }
 
 inline bool OrderCancelMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 23) && "Invalid size of the ITCH message type 'X'");
-    if (size < 23)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'X'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -737,9 +724,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderCancelMessage
 
 inline size_t OrderDeleteMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 19) && "Invalid size of the ITCH message type 'D'");
-    if (size < 19)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'D'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -749,13 +735,13 @@ inline size_t OrderDeleteMessage::serialize(void *buffer, size_t size) const
     data += WriteTimestamp(data, this->Timestamp);
     data += CppCommon::Endian::WriteBigEndian(data, this->OrderReferenceNumber);
 
-    return size;
+    return SIZE;
 }
 
 inline bool OrderDeleteMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 19) && "Invalid size of the ITCH message type 'D'");
-    if (size < 19)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'D'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -783,9 +769,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderDeleteMessage
 
 inline size_t OrderReplaceMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 35) && "Invalid size of the ITCH message type 'U'");
-    if (size < 35)
-        return false;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'U'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -798,13 +783,13 @@ inline size_t OrderReplaceMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->Shares);
     data += CppCommon::Endian::WriteBigEndian(data, this->Price);
 
-    return size;
+    return SIZE;
 }
 
 inline bool OrderReplaceMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 35) && "Invalid size of the ITCH message type 'U'");
-    if (size < 35)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'U'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -838,9 +823,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderReplaceMessag
 
 inline size_t TradeMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 44) && "Invalid size of the ITCH message type 'P'");
-    if (size < 44)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'P'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -855,13 +839,13 @@ inline size_t TradeMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->Price);
     data += CppCommon::Endian::WriteBigEndian(data, this->MatchNumber);
 
-    return size;
+    return SIZE;
 }
 
 inline bool TradeMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 44) && "Invalid size of the ITCH message type 'P'");
-    if (size < 44)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'P'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -899,9 +883,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const TradeMessage& mess
 
 inline size_t CrossTradeMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 40) && "Invalid size of the ITCH message type 'Q'");
-    if (size < 40)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'Q'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -915,13 +898,13 @@ inline size_t CrossTradeMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->MatchNumber);
     *data++ = this->CrossType;
     
-    return size;
+    return SIZE;
 }
 
 inline bool CrossTradeMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 40) && "Invalid size of the ITCH message type 'Q'");
-    if (size < 40)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'Q'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -957,9 +940,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const CrossTradeMessage&
 
 inline size_t BrokenTradeMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 19) && "Invalid size of the ITCH message type 'B'");
-    if (size < 19)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'B'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -969,13 +951,13 @@ inline size_t BrokenTradeMessage::serialize(void *buffer, size_t size) const
     data += WriteTimestamp(data, this->Timestamp);
     data += CppCommon::Endian::WriteBigEndian(data, this->MatchNumber);
 
-    return size;
+    return SIZE;
 }
 
 inline bool BrokenTradeMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 19) && "Invalid size of the ITCH message type 'B'");
-    if (size < 19)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'B'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -1003,9 +985,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const BrokenTradeMessage
 
 inline size_t NOIIMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 50) && "Invalid size of the ITCH message type 'I'");
-    if (size < 50)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'I'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -1023,13 +1004,13 @@ inline size_t NOIIMessage::serialize(void *buffer, size_t size) const
     *data++ = this->CrossType;
     *data++ = this->PriceVariationIndicator;
 
-    return size;
+    return SIZE;
 }
 
 inline bool NOIIMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 50) && "Invalid size of the ITCH message type 'I'");
-    if (size < 50)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'I'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -1073,9 +1054,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const NOIIMessage& messa
 
 inline size_t RPIIMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 20) && "Invalid size of the ITCH message type 'N'");
-    if (size < 20)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'N'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -1086,13 +1066,13 @@ inline size_t RPIIMessage::serialize(void *buffer, size_t size) const
     data += WriteString(data, this->Stock);
     *data++ = this->InterestFlag;
 
-    return size;
+    return SIZE;
 }
 
 inline bool RPIIMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 20) && "Invalid size of the ITCH message type 'N'");
-    if (size < 20)
+    assert((size >= SIZE) && "Invalid size of the ITCH message type 'N'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -1122,15 +1102,14 @@ inline TOutputStream& operator<<(TOutputStream& stream, const RPIIMessage& messa
 
 inline size_t UnknownMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size > 0) && "Invalid size of the unknown ITCH message!");
-    if (size == 0)
-        return false;
+    assert((size >= SIZE) && "Invalid size of the unknown ITCH message!");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
     *data = this->Type;
 
-    return size;
+    return SIZE;
 }
 
 inline bool UnknownMessage::deserialize(void *buffer, size_t size)
@@ -1154,7 +1133,7 @@ inline TOutputStream& operator<<(TOutputStream& stream, const UnknownMessage& me
 }
 
 template <size_t N>
-inline size_t SerializableMessage::ReadString(const void* buffer, char (&str)[N])
+inline size_t ReadString(const void* buffer, char (&str)[N])
 {
     std::memcpy(str, buffer, N);
 
@@ -1162,14 +1141,14 @@ inline size_t SerializableMessage::ReadString(const void* buffer, char (&str)[N]
 }
 
 template <size_t N>
-inline size_t SerializableMessage::WriteString(void* buffer, const char (&str)[N])
+inline size_t WriteString(void* buffer, const char (&str)[N])
 {
     std::memcpy(buffer, str, N);
 
     return N;
 }
 
-inline size_t SerializableMessage::ReadTimestamp(const void* buffer, uint64_t& value)
+inline size_t ReadTimestamp(const void* buffer, uint64_t& value)
 {
     if (CppCommon::Endian::IsBigEndian())
     {
@@ -1197,7 +1176,7 @@ inline size_t SerializableMessage::ReadTimestamp(const void* buffer, uint64_t& v
     return 6;
 }
 
-inline size_t SerializableMessage::WriteTimestamp(void* buffer, const uint64_t& value)
+inline size_t WriteTimestamp(void* buffer, const uint64_t& value)
 {
     if (CppCommon::Endian::IsBigEndian())
     {
@@ -1210,8 +1189,10 @@ inline size_t SerializableMessage::WriteTimestamp(void* buffer, const uint64_t&
         ((uint8_t*)buffer)[2] = ((const uint8_t*)&value)[0];
         ((uint8_t*)buffer)[1] = ((const uint8_t*)&value)[1];
         ((uint8_t*)buffer)[0] = ((const uint8_t*)&value)[2];
-
     }
+    ((uint8_t*)buffer)[3] = 0;
+    ((uint8_t*)buffer)[4] = 0;
+    ((uint8_t*)buffer)[5] = 0;
 
     return 6;
 }
@@ -12,6 +12,7 @@
 #include "utility/endian.h"
 #include "utility/iostream.h"
 
+#include <type_traits>
 #include <vector>
 
 namespace TradingPlatform {
@@ -22,29 +23,24 @@ namespace TradingPlatform {
 */
 namespace OUCH {
 
-//! Base class for all OUCH messages
-class SerializableMessage
-{
-public:
-    virtual size_t serialize(void *buffer, size_t size) const = 0;
-    virtual bool deserialize(void *buffer, size_t size) = 0;
+//! Read the fixed size string of the OUCH message
+template <size_t N>
+size_t ReadString(const void* buffer, char (&str)[N]);
+//! Write the fixed size string of the OUCH message
+template <size_t N>
+size_t WriteString(void* buffer, const char (&str)[N]);
 
-protected:
-    template <size_t N>
-    static size_t ReadString(const void* buffer, char (&str)[N]);
-    template <size_t N>
-    static size_t WriteString(void* buffer, const char (&str)[N]);
-
-    static size_t ReadTimestamp(const void* buffer, uint64_t& value);
-    static size_t WriteTimestamp(void* buffer, const uint64_t& value);
-};
+//! Read the 6 bytes timestamp of the OUCH message
+size_t ReadTimestamp(const void* buffer, uint64_t& value);
+//! Write the 6 bytes timestamp of the OUCH message
+size_t WriteTimestamp(void* buffer, const uint64_t& value);
 
 /////////////////////////////////////////////
 // Inbound message
 /////////////////////////////////////////////
 
 //! Enter Order Message
-struct EnterOrderMessage : public SerializableMessage
+struct EnterOrderMessage
 {
     char Type;
     uint32_t OrderToken;
@@ -58,15 +54,17 @@ struct EnterOrderMessage : public SerializableMessage
     uint32_t ClientId;
     uint64_t MinimumQuantity;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 43;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const EnterOrderMessage& message);
 };
 
 //! Replace Order Message
-struct ReplaceOrderMessage : public SerializableMessage
+struct ReplaceOrderMessage
 {
     char Type;
     uint32_t ExistingOrderToken;
@@ -74,33 +72,39 @@ struct ReplaceOrderMessage : public SerializableMessage
     uint64_t Shares;
     uint32_t Price;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 21;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const ReplaceOrderMessage& message);
 };
 
 //! Cancel Order Message
-struct CancelOrderMessage : public SerializableMessage
+struct CancelOrderMessage
 {
     char Type;
     uint32_t OrderToken;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 5;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const CancelOrderMessage& message);
 };
 
 //! Unknown message
-struct UnknownMessage : public SerializableMessage
+struct UnknownMessage
 {
     char Type;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 1;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const UnknownMessage& message);
@@ -111,21 +115,23 @@ struct UnknownMessage : public SerializableMessage
 /////////////////////////////////////////////
 
 //! System Event Message
-struct SystemEventMessage : public SerializableMessage
+struct SystemEventMessage
 {
     char Type;
     uint64_t Timestamp;
     char EventCode;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 10;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const SystemEventMessage& message);
 };
 
 //! Order Accepted Message
-struct OrderAcceptedMessage : public SerializableMessage
+struct OrderAcceptedMessage
 {
     char Type;
     uint64_t Timestamp;
@@ -142,30 +148,34 @@ struct OrderAcceptedMessage : public SerializableMessage
     uint64_t MinimumQuantity;
     char OrderState;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 60;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderAcceptedMessage& message);
 };
 
 //! Order Rejected Message
-struct OrderRejectedMessage : public SerializableMessage
+struct OrderRejectedMessage
 {
     char Type;
     uint64_t Timestamp;
     uint32_t OrderToken;
     char Reason;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 14;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderRejectedMessage& message);
 };
 
 //! Order Replaced Message
-struct OrderReplacedMessage : public SerializableMessage
+struct OrderReplacedMessage
 {
     char Type;
     uint64_t Timestamp;
@@ -178,15 +188,17 @@ struct OrderReplacedMessage : public SerializableMessage
     char OrderState;
     uint32_t PreviousOrderToken;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 43;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderReplacedMessage& message);
 };
 
 //! Order Canceled Message
-struct OrderCanceledMessage : public SerializableMessage
+struct OrderCanceledMessage
 {
     char Type;
     uint64_t Timestamp;
@@ -194,15 +206,17 @@ struct OrderCanceledMessage : public SerializableMessage
     uint64_t Shares;
     char Reason;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 22;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderCanceledMessage& message);
 };
 
 //! Order Executed Message
-struct OrderExecutedMessage : public SerializableMessage
+struct OrderExecutedMessage
 {
     char Type;
     uint64_t Timestamp;
@@ -213,15 +227,17 @@ struct OrderExecutedMessage : public SerializableMessage
     uint64_t MatchNumber;
     uint32_t CounterPartyId;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 38;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const OrderExecutedMessage& message);
 };
 
 //! Broken Trade Message
-struct BrokenTradeMessage : public SerializableMessage
+struct BrokenTradeMessage
 {
     char Type;
     uint64_t Timestamp;
@@ -229,13 +245,28 @@ struct BrokenTradeMessage : public SerializableMessage
     uint64_t MatchNumber;
     char Reason;
 
-    size_t serialize(void *buffer, size_t size) const override;
-    bool deserialize(void *buffer, size_t size) override;
+    static constexpr size_t SIZE = 22;
+
+    size_t serialize(void *buffer, size_t size) const;
+    bool deserialize(void *buffer, size_t size);
 
     template <class TOutputStream>
     friend TOutputStream& operator<<(TOutputStream& stream, const BrokenTradeMessage& message);
 };
 
+// Messages are plain structs, so they could be copied into buffers and logs as is
+static_assert(std::is_trivially_copyable<EnterOrderMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<ReplaceOrderMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<CancelOrderMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<UnknownMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<SystemEventMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderAcceptedMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderRejectedMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderReplacedMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderCanceledMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<OrderExecutedMessage>::value, "OUCH message must be trivially copyable!");
+static_assert(std::is_trivially_copyable<BrokenTradeMessage>::value, "OUCH message must be trivially copyable!");
+
 /////////////////////////////////////////////
 // Handler
 /////////////////////////////////////////////
@@ -279,6 +310,9 @@ public:
     */
     bool ProcessMessage(void* buffer, size_t size);
 
+    //! Get count of frames split between buffers and completed in the reassembly buffer
+    uint64_t fragmented() const noexcept { return _fragmented; }
+
     //! Reset OUCH handler
     void Reset();
 
@@ -295,9 +329,14 @@ private:
     bool ProcessCancelOrderMessage(void* buffer, size_t size);
     bool ProcessUnknownMessage(void* buffer, size_t size);
 
+    size_t ProcessCache(uint8_t* data, size_t size, bool& result);
+    void CacheFrame(const uint8_t* data, size_t size);
+
 private:
-    size_t _size;
-    std::vector<uint8_t> _cache;
+    // Reassembly buffer of the frame split between buffers: 2 bytes size and up to 64KiB message
+    uint8_t _cache[2 + 65535];
+    size_t _cached;
+    uint64_t _fragmented;
 };
 
 /*! \example ouch_handler.cpp NASDAQ OUCH handler example */
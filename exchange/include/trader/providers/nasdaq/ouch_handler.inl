@@ -13,9 +13,8 @@ namespace OUCH {
 
 inline size_t EnterOrderMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 43) && "Invalid size of the OUCH message type 'O'");
-    if (size < 43)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'O'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -31,13 +30,13 @@ inline size_t EnterOrderMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->ClientId);
     data += CppCommon::Endian::WriteBigEndian(data, this->MinimumQuantity);
     
-    return size;
+    return SIZE;
 }
 
 inline bool EnterOrderMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 43) && "Invalid size of the OUCH message type 'O'");
-    if (size < 43)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'O'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -77,9 +76,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const EnterOrderMessage&
 
 inline size_t ReplaceOrderMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 21) && "Invalid size of the OUCH message type 'U'");
-    if (size < 21)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'U'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -89,13 +87,13 @@ inline size_t ReplaceOrderMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->Shares);
     data += CppCommon::Endian::WriteBigEndian(data, this->Price);
     
-    return size;
+    return SIZE;
 }
 
 inline bool ReplaceOrderMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 21) && "Invalid size of the OUCH message type 'U'");
-    if (size < 21)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'U'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -123,22 +121,21 @@ inline TOutputStream& operator<<(TOutputStream& stream, const ReplaceOrderMessag
 
 inline size_t CancelOrderMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 5) && "Invalid size of the OUCH message type 'X'");
-    if (size < 5)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'X'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
     *data++ = this->Type;
     data += CppCommon::Endian::WriteBigEndian(data, this->OrderToken);
     
-    return size;
+    return SIZE;
 }
 
 inline bool CancelOrderMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 5) && "Invalid size of the OUCH message type 'X'");
-    if (size < 5)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'X'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -160,15 +157,14 @@ inline TOutputStream& operator<<(TOutputStream& stream, const CancelOrderMessage
 
 inline size_t UnknownMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size > 0) && "Invalid size of the unknown OUCH message!");
-    if (size == 0)
-        return false;
+    assert((size >= SIZE) && "Invalid size of the unknown OUCH message!");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
     *data = this->Type;
 
-    return size;
+    return SIZE;
 }
 
 inline bool UnknownMessage::deserialize(void *buffer, size_t size)
@@ -193,9 +189,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const UnknownMessage& me
 
 inline size_t SystemEventMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 10) && "Invalid size of the OUCH message type 'S'");
-    if (size < 10)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'S'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -203,13 +198,13 @@ inline size_t SystemEventMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->Timestamp);
     *data++ = this->EventCode;
     
-    return size;
+    return SIZE;
 }
 
 inline bool SystemEventMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 10) && "Invalid size of the OUCH message type 'S'");
-    if (size < 10)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'S'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -233,9 +228,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const SystemEventMessage
 
 inline size_t OrderAcceptedMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 59) && "Invalid size of the OUCH message type 'A'");
-    if (size < 59)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'A'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -254,13 +248,13 @@ inline size_t OrderAcceptedMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->MinimumQuantity);
     *data++ = this->OrderState;
     
-    return size;
+    return SIZE;
 }
 
 inline bool OrderAcceptedMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 59) && "Invalid size of the OUCH message type 'A'");
-    if (size < 59)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'A'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -306,9 +300,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderAcceptedMessa
 
 inline size_t OrderRejectedMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 14) && "Invalid size of the OUCH message type 'J'");
-    if (size < 14)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'J'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -317,13 +310,13 @@ inline size_t OrderRejectedMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->OrderToken);
     *data++ = this->Reason;
     
-    return size;
+    return SIZE;
 }
 
 inline bool OrderRejectedMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 14) && "Invalid size of the OUCH message type 'J'");
-    if (size < 14)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'J'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -349,9 +342,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderRejectedMessa
 
 inline size_t OrderReplacedMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 43) && "Invalid size of the OUCH message type 'U'");
-    if (size < 43)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'U'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -360,18 +352,19 @@ inline size_t OrderReplacedMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->ReplacementOrderToken);
     *data++ = this->OrderVerb;
     data += CppCommon::Endian::WriteBigEndian(data, this->Shares);
+    data += CppCommon::Endian::WriteBigEndian(data, this->OrderbookId);
     data += CppCommon::Endian::WriteBigEndian(data, this->Price);
     data += CppCommon::Endian::WriteBigEndian(data, this->OrderReferenceNumber);
     *data++ = this->OrderState;
     data += CppCommon::Endian::WriteBigEndian(data, this->PreviousOrderToken);
     
-    return size;
+    return SIZE;
 }
 
 inline bool OrderReplacedMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 43) && "Invalid size of the OUCH message type 'U'");
-    if (size < 43)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'U'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -381,6 +374,7 @@ inline bool OrderReplacedMessage::deserialize(void *buffer, size_t size)
     data += CppCommon::Endian::ReadBigEndian(data, this->ReplacementOrderToken);
     this->OrderVerb = *data++;
     data += CppCommon::Endian::ReadBigEndian(data, this->Shares);
+    data += CppCommon::Endian::ReadBigEndian(data, this->OrderbookId);
     data += CppCommon::Endian::ReadBigEndian(data, this->Price);
     data += CppCommon::Endian::ReadBigEndian(data, this->OrderReferenceNumber);
     this->OrderState = *data++;
@@ -407,9 +401,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderReplacedMessa
 
 inline size_t OrderCanceledMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 22) && "Invalid size of the OUCH message type 'C'");
-    if (size < 22)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'C'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -419,13 +412,13 @@ inline size_t OrderCanceledMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->Shares);
     *data++ = this->Reason;
     
-    return size;
+    return SIZE;
 }
 
 inline bool OrderCanceledMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 22) && "Invalid size of the OUCH message type 'C'");
-    if (size < 22)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'C'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -453,9 +446,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderCanceledMessa
 
 inline size_t OrderExecutedMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 38) && "Invalid size of the OUCH message type 'E'");
-    if (size < 38)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'E'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -468,13 +460,13 @@ inline size_t OrderExecutedMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->MatchNumber);
     data += CppCommon::Endian::WriteBigEndian(data, this->CounterPartyId);
     
-    return size;
+    return SIZE;
 }
 
 inline bool OrderExecutedMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 38) && "Invalid size of the OUCH message type 'E'");
-    if (size < 38)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'E'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -508,9 +500,8 @@ inline TOutputStream& operator<<(TOutputStream& stream, const OrderExecutedMessa
 
 inline size_t BrokenTradeMessage::serialize(void *buffer, size_t size) const
 {
-    assert((size >= 22) && "Invalid size of the OUCH message type 'B'");
-    if (size < 22)
-        return 0;
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'B'");
+    (void)size;
 
     uint8_t* data = (uint8_t*)buffer;
 
@@ -520,13 +511,13 @@ inline size_t BrokenTradeMessage::serialize(void *buffer, size_t size) const
     data += CppCommon::Endian::WriteBigEndian(data, this->MatchNumber);
     *data++ = this->Reason;
     
-    return size;
+    return SIZE;
 }
 
 inline bool BrokenTradeMessage::deserialize(void *buffer, size_t size)
 {
-    assert((size >= 22) && "Invalid size of the OUCH message type 'B'");
-    if (size < 22)
+    assert((size >= SIZE) && "Invalid size of the OUCH message type 'B'");
+    if (size < SIZE)
         return false;
 
     uint8_t* data = (uint8_t*)buffer;
@@ -553,7 +544,7 @@ inline TOutputStream& operator<<(TOutputStream& stream, const BrokenTradeMessage
 }
 
 template <size_t N>
-inline size_t SerializableMessage::ReadString(const void* buffer, char (&str)[N])
+inline size_t ReadString(const void* buffer, char (&str)[N])
 {
     std::memcpy(str, buffer, N);
 
@@ -561,14 +552,14 @@ inline size_t SerializableMessage::ReadString(const void* buffer, char (&str)[N]
 }
 
 template <size_t N>
-inline size_t SerializableMessage::WriteString(void* buffer, const char (&str)[N])
+inline size_t WriteString(void* buffer, const char (&str)[N])
 {
     std::memcpy(buffer, str, N);
 
     return N;
 }
 
-inline size_t SerializableMessage::ReadTimestamp(const void* buffer, uint64_t& value)
+inline size_t ReadTimestamp(const void* buffer, uint64_t& value)
 {
     if (CppCommon::Endian::IsBigEndian())
     {
@@ -596,7 +587,7 @@ inline size_t SerializableMessage::ReadTimestamp(const void* buffer, uint64_t& v
     return 6;
 }
 
-inline size_t SerializableMessage::WriteTimestamp(void* buffer, const uint64_t& value)
+inline size_t WriteTimestamp(void* buffer, const uint64_t& value)
 {
     if (CppCommon::Endian::IsBigEndian())
     {
@@ -609,8 +600,10 @@ inline size_t SerializableMessage::WriteTimestamp(void* buffer, const uint64_t&
         ((uint8_t*)buffer)[2] = ((const uint8_t*)&value)[0];
         ((uint8_t*)buffer)[1] = ((const uint8_t*)&value)[1];
         ((uint8_t*)buffer)[0] = ((const uint8_t*)&value)[2];
-
     }
+    ((uint8_t*)buffer)[3] = 0;
+    ((uint8_t*)buffer)[4] = 0;
+    ((uint8_t*)buffer)[5] = 0;
 
     return 6;
 }
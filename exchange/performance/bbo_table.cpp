@@ -0,0 +1,105 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "trader/matching/market_manager.h"
+
+#include "benchmark/reporter_console.h"
+#include "time/timestamp.h"
+
+#include <OptionParser.h>
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+// Reader polls the best bid and offer of random symbols while the writer
+// (if enabled) keeps changing the top of the book of all symbols.
+void Read(MarketManager& market, BBOTable& table, size_t symbols, size_t reads, bool writer)
+{
+    std::atomic<bool> done(false);
+    std::thread thread;
+    if (writer)
+    {
+        thread = std::thread([&market, &done, symbols]()
+        {
+            uint64_t id = 0;
+            while (!done)
+            {
+                uint32_t symbol = (uint32_t)(id % symbols);
+                uint64_t price = 100 + (id % 10);
+                market.AddOrder(Order::BuyLimit(++id, symbol, price, 10));
+                market.DeleteOrder(id);
+            }
+        });
+    }
+
+    BBO bbo;
+    size_t found = 0;
+    uint64_t seed = 1;
+    uint64_t timestamp_start = Timestamp::nano();
+    for (size_t i = 0; i < reads; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        if (table.Read((uint32_t)((seed >> 33) % symbols), bbo))
+            ++found;
+    }
+    uint64_t timestamp_stop = Timestamp::nano();
+
+    done = true;
+    if (thread.joinable())
+        thread.join();
+
+    std::cout << (writer ? "Read with the concurrent writer" : "Read without writers") << std::endl;
+    std::cout << "Found records: " << found << std::endl;
+    std::cout << "Processing time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
+    std::cout << "Read latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod((timestamp_stop - timestamp_start) / reads) << std::endl;
+    std::cout << "Read throughput: " << reads * 1000000000 / (timestamp_stop - timestamp_start) << " ops/s" << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    auto parser = optparse::OptionParser().version("1.0.0.0");
+
+    parser.add_option("-s", "--symbols").dest("symbols").action("store").type("int").set_default(1024).help("Count of symbols. Default: %default");
+    parser.add_option("-n", "--reads").dest("reads").action("store").type("int").set_default(100000000).help("Count of reads. Default: %default");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    // Print help
+    if (options.get("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    size_t symbols = (size_t)std::max((int)options.get("symbols"), 1);
+    size_t reads = (size_t)std::max((int)options.get("reads"), 1);
+
+    BBOTable table("trading-platform-performance-bbo-table", symbols);
+    if (!table.valid())
+    {
+        std::cerr << "Failed to open the best bid and offer table!" << std::endl;
+        return -1;
+    }
+
+    MarketManager market;
+    for (uint32_t id = 0; id < symbols; ++id)
+    {
+        char name[8] = "";
+        std::snprintf(name, sizeof(name), "%u", id);
+        market.AddSymbol(Symbol(id, name));
+        market.AddOrderBook(Symbol(id, name));
+    }
+    market.AttachBBOTable(&table);
+
+    Read(market, table, symbols, reads, false);
+    Read(market, table, symbols, reads, true);
+
+    return 0;
+}
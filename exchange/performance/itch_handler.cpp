@@ -2,7 +2,7 @@
 // Created by Ivan Shynkarenka on 24.07.2017
 //
 
-#include "trader/providers/nasdaq/itch_handler.h"
+#include "trader/providers/nasdaq/batch_itch_handler.h"
 
 #include "benchmark/reporter_console.h"
 #include "filesystem/file.h"
@@ -14,7 +14,7 @@
 using namespace CppCommon;
 using namespace TradingPlatform::ITCH;
 
-class MyITCHHandler : public ITCHHandler
+class MyITCHHandler : public BatchITCHHandler
 {
 public:
     MyITCHHandler()
@@ -48,6 +48,9 @@ protected:
     bool onMessage(const RPIIMessage& message) override { ++_messages; return true; }
     bool onMessage(const UnknownMessage& message) override { ++_errors; return true; }
 
+    // Order messages are counted by batches
+    bool onMessages(const OrderMessageBatch& batch) override { _messages += batch.Size; return true; }
+
 private:
     size_t _messages;
     size_t _errors;
@@ -58,6 +61,7 @@ int main(int argc, char** argv)
     auto parser = optparse::OptionParser().version("1.0.0.0");
 
     parser.add_option("-i", "--input").dest("input").help("Input file name");
+    parser.add_option("-m", "--message").dest("message").action("store_true").help("Process messages one by one instead of batches");
 
     optparse::Values options = parser.parse_args(argc, argv);
 
@@ -69,6 +73,7 @@ int main(int argc, char** argv)
     }
 
     MyITCHHandler itch_handler;
+    bool batch = !options.get("message");
 
     // Open the input file or stdin
     std::unique_ptr<Reader> input(new StdInput());
@@ -87,7 +92,10 @@ int main(int argc, char** argv)
     while ((size = input->Read(buffer, sizeof(buffer))) > 0)
     {
         // Process the buffer
-        itch_handler.Process(buffer, size);
+        if (batch)
+            itch_handler.ProcessBatch(buffer, size);
+        else
+            itch_handler.Process(buffer, size);
     }
     uint64_t timestamp_stop = Timestamp::nano();
     std::cout << "Done!" << std::endl;
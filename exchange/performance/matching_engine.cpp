@@ -16,8 +16,10 @@ using namespace CppCommon;
 using namespace TradingPlatform::ITCH;
 using namespace TradingPlatform::Matching;
 
-class MyMarketHandler : public MarketHandler
+class MyMarketHandler final : public MarketHandler
 {
+    friend class BasicMarketManager<MyMarketHandler>;
+
 public:
     MyMarketHandler()
         : _updates(0),
@@ -50,7 +52,7 @@ protected:
     void onAddSymbol(const Symbol& symbol) override { ++_updates; ++_symbols; _max_symbols = std::max(_symbols, _max_symbols); }
     void onDeleteSymbol(const Symbol& symbol) override { ++_updates; --_symbols; }
     void onAddOrderBook(const OrderBook& order_book) override { ++_updates; ++_order_books; _max_order_books = std::max(_order_books, _max_order_books); }
-    void onUpdateOrderBook(const OrderBook& order_book, bool top) override { _max_order_book_levels = std::max(std::max(order_book.bids().size(), order_book.asks().size()), _max_order_book_levels); }
+    void onUpdateOrderBook(const OrderBook& order_book, bool top) override { _max_order_book_levels = std::max(std::max(order_book.bid_levels(), order_book.ask_levels()), _max_order_book_levels); }
     void onDeleteOrderBook(const OrderBook& order_book) override { ++_updates; --_order_books; }
     void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override { ++_updates; }
     void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override { ++_updates; _max_order_book_orders = std::max(level.Orders, _max_order_book_orders); }
@@ -76,10 +78,13 @@ private:
     size_t _execute_orders;
 };
 
+// Market manager with the statically bound counters handler
+typedef BasicMarketManager<MyMarketHandler> MyMarketManager;
+
 class MyITCHHandler : public ITCHHandler
 {
 public:
-    explicit MyITCHHandler(MarketManager& market)
+    explicit MyITCHHandler(MyMarketManager& market)
         : _market(market),
           _messages(0),
           _errors(0)
@@ -112,7 +117,7 @@ protected:
     bool onMessage(const UnknownMessage& message) override { ++_errors; return true; }
 
 private:
-    MarketManager& _market;
+    MyMarketManager& _market;
     size_t _messages;
     size_t _errors;
 };
@@ -133,7 +138,7 @@ int main(int argc, char** argv)
     }
 
     MyMarketHandler market_handler;
-    MarketManager market(market_handler);
+    MyMarketManager market(market_handler);
     MyITCHHandler itch_handler(market);
 
     // Enable automatic matching
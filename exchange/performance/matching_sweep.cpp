@@ -0,0 +1,98 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "trader/matching/market_manager.h"
+
+#include "benchmark/reporter_console.h"
+#include "time/timestamp.h"
+
+#include <OptionParser.h>
+
+#include <iostream>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+// Every round rests the given count of sell orders over price levels, then
+// one aggressive buy order sweeps them all. Only sweeps are timed.
+void Sweep(size_t orders, size_t levels, size_t rounds)
+{
+    Symbol symbol(0, "SWEEP   ");
+    MarketManager market;
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.EnableMatching();
+
+    uint64_t id = 0;
+    uint64_t total = 0;
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        for (size_t i = 0; i < orders; ++i)
+            market.AddOrder(Order::SellLimit(++id, 0, 100 + (i % levels), 10));
+
+        uint64_t timestamp_start = Timestamp::nano();
+        market.AddOrder(Order::BuyLimit(++id, 0, 100 + levels, orders * 10));
+        uint64_t timestamp_stop = Timestamp::nano();
+        total += timestamp_stop - timestamp_start;
+    }
+
+    std::cout << "Sweep of " << orders << " orders over " << levels << " price levels" << std::endl;
+    std::cout << "Sweep latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(total / rounds) << std::endl;
+    std::cout << "Fill latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(total / (rounds * orders)) << std::endl;
+    std::cout << std::endl;
+}
+
+// Many small sell orders partially fill big resting buy orders
+void PartialFills(size_t resting, size_t fills)
+{
+    Symbol symbol(0, "SWEEP   ");
+    MarketManager market;
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.EnableMatching();
+
+    uint64_t id = 0;
+    for (size_t i = 0; i < resting; ++i)
+        market.AddOrder(Order::BuyLimit(++id, 0, 100, fills));
+
+    uint64_t timestamp_start = Timestamp::nano();
+    for (size_t i = 0; i < fills; ++i)
+        market.AddOrder(Order::SellLimit(++id, 0, 100, 1));
+    uint64_t timestamp_stop = Timestamp::nano();
+
+    std::cout << "Partial fills of " << resting << " resting orders" << std::endl;
+    std::cout << "Fill latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod((timestamp_stop - timestamp_start) / fills) << std::endl;
+    std::cout << "Fill throughput: " << fills * 1000000000 / (timestamp_stop - timestamp_start) << " fills/s" << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    auto parser = optparse::OptionParser().version("1.0.0.0");
+
+    parser.add_option("-o", "--orders").dest("orders").action("store").type("int").set_default(50).help("Count of orders filled by each sweep. Default: %default");
+    parser.add_option("-l", "--levels").dest("levels").action("store").type("int").set_default(10).help("Count of price levels of each sweep. Default: %default");
+    parser.add_option("-r", "--rounds").dest("rounds").action("store").type("int").set_default(100000).help("Count of sweeps. Default: %default");
+    parser.add_option("-f", "--fills").dest("fills").action("store").type("int").set_default(10000000).help("Count of partial fills. Default: %default");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    // Print help
+    if (options.get("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    size_t orders = (size_t)std::max((int)options.get("orders"), 1);
+    size_t levels = (size_t)std::max((int)options.get("levels"), 1);
+    size_t rounds = (size_t)std::max((int)options.get("rounds"), 1);
+    size_t fills = (size_t)std::max((int)options.get("fills"), 1);
+
+    Sweep(orders, 1, rounds);
+    Sweep(orders, levels, rounds);
+    PartialFills(1000, fills);
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "trader/matching/fast_hash.h"
+#include "trader/matching/flat_hash_map.h"
+
+#include "benchmark/reporter_console.h"
+#include "containers/hashmap.h"
+#include "time/timestamp.h"
+
+#include <OptionParser.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+// Order index replay imitates cancel-heavy flow: most operations cancel a random
+// resting order and add a new one instead, the rest look up a resting order to reduce it.
+template <class TOrders>
+void Replay(const std::string& name, size_t orders, size_t operations, size_t cancels)
+{
+    TOrders index(16384, 0);
+    std::vector<uint64_t> resting;
+    resting.reserve(orders);
+
+    uint64_t seed = 1;
+    auto random = [&seed]()
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return seed >> 33;
+    };
+
+    // Fill the index with resting orders
+    uint64_t id = 0;
+    for (size_t i = 0; i < orders; ++i)
+    {
+        index.insert(std::make_pair(++id, (void*)(uintptr_t)id));
+        resting.push_back(id);
+    }
+
+    size_t found = 0;
+    uint64_t timestamp_start = Timestamp::nano();
+    for (size_t i = 0; i < operations; ++i)
+    {
+        size_t position = (size_t)(random() % resting.size());
+        auto it = index.find(resting[position]);
+        if (it != index.end())
+            ++found;
+
+        if ((random() % 100) < cancels)
+        {
+            // Cancel the resting order and add a new one
+            index.erase(it);
+            index.insert(std::make_pair(++id, (void*)(uintptr_t)id));
+            resting[position] = id;
+        }
+    }
+    uint64_t timestamp_stop = Timestamp::nano();
+
+    std::cout << name << std::endl;
+    std::cout << "Resting orders: " << index.size() << std::endl;
+    std::cout << "Found orders: " << found << std::endl;
+    std::cout << "Processing time: " << CppBenchmark::ReporterConsole::GenerateTimePeriod(timestamp_stop - timestamp_start) << std::endl;
+    std::cout << "Operation latency: " << CppBenchmark::ReporterConsole::GenerateTimePeriod((timestamp_stop - timestamp_start) / operations) << std::endl;
+    std::cout << "Operation throughput: " << operations * 1000000000 / (timestamp_stop - timestamp_start) << " ops/s" << std::endl;
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    auto parser = optparse::OptionParser().version("1.0.0.0");
+
+    parser.add_option("-o", "--orders").dest("orders").action("store").type("int").set_default(2000000).help("Count of resting orders. Default: %default");
+    parser.add_option("-n", "--operations").dest("operations").action("store").type("int").set_default(20000000).help("Count of replayed operations. Default: %default");
+    parser.add_option("-c", "--cancels").dest("cancels").action("store").type("int").set_default(90).help("Percent of cancel operations. Default: %default");
+
+    optparse::Values options = parser.parse_args(argc, argv);
+
+    // Print help
+    if (options.get("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    int orders = options.get("orders");
+    int operations = options.get("operations");
+    int cancels = options.get("cancels");
+
+    Replay<CppCommon::HashMap<uint64_t, void*, FastHash>>("CppCommon::HashMap", (size_t)std::max(orders, 1), (size_t)std::max(operations, 1), (size_t)cancels);
+    Replay<FlatHashMap<uint64_t, void*, FastHash>>("FlatHashMap", (size_t)std::max(orders, 1), (size_t)std::max(operations, 1), (size_t)cancels);
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*!
+    \file bbo_table.cpp
+    \brief Best bid and offer shared memory table implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/bbo_table.h"
+
+#include <cstring>
+
+namespace TradingPlatform {
+namespace Matching {
+
+constexpr char BBOTable::MAGIC[8];
+
+BBOTable::BBOTable(const std::string& name, size_t capacity)
+    : _shared_memory(name, sizeof(Header) + capacity * sizeof(Record)),
+      _records(nullptr),
+      _capacity(capacity)
+{
+    static_assert(sizeof(Header) == 64, "BBO table header must take one cache line!");
+    static_assert(sizeof(Record) == 64, "BBO table record must take one cache line!");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "BBO table requires lock-free 64-bit atomics!");
+
+    Header* header = (Header*)_shared_memory.ptr();
+
+    // Initialize the new table
+    if (_shared_memory.owner())
+    {
+        std::memset(_shared_memory.ptr(), 0, _shared_memory.size());
+        std::memcpy(header->Magic, MAGIC, sizeof(MAGIC));
+        header->Version = VERSION;
+        header->RecordSize = (uint32_t)sizeof(Record);
+        header->Capacity = capacity;
+    }
+
+    // Opened table must be created with the same layout
+    if ((std::memcmp(header->Magic, MAGIC, sizeof(MAGIC)) != 0) || (header->Version != VERSION) || (header->RecordSize != sizeof(Record)) || (header->Capacity != capacity))
+        return;
+
+    _records = (Record*)(header + 1);
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
@@ -0,0 +1,242 @@
+/*!
+    \file market_snapshot.cpp
+    \brief Market snapshot implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/matching/market_snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace TradingPlatform {
+namespace Matching {
+
+static_assert(std::is_trivially_copyable<Symbol>::value, "Symbol must be trivially copyable to be saved into the snapshot!");
+static_assert(std::is_trivially_copyable<Order>::value, "Order must be trivially copyable to be saved into the snapshot!");
+static_assert((sizeof(Order) % 8) == 0, "Order size must be aligned to 8 bytes to be restored from the memory-mapped snapshot!");
+
+constexpr char MarketSnapshot::MAGIC[8];
+
+bool MarketSnapshot::Save(const MarketManager& market, const std::string& path, uint64_t sequence)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    bool result = true;
+    auto write = [file, &result](const void* data, size_t size)
+    {
+        if (result && (size > 0))
+            result = (std::fwrite(data, 1, size, file) == size);
+    };
+
+    // Count symbols and order books
+    SnapshotHeader header = {};
+    std::memcpy(header.Magic, MAGIC, sizeof(MAGIC));
+    header.Version = VERSION;
+    header.OrderSize = (uint32_t)sizeof(Order);
+    header.Sequence = sequence;
+    header.Orders = market._orders.size();
+    header.Matching = market._matching ? 1 : 0;
+    for (auto symbol_ptr : market._symbols)
+        if (symbol_ptr != nullptr)
+            ++header.Symbols;
+    for (auto order_book_ptr : market._order_books)
+        if (order_book_ptr != nullptr)
+            ++header.OrderBooks;
+    write(&header, sizeof(header));
+
+    // Save symbols
+    for (auto symbol_ptr : market._symbols)
+    {
+        if (symbol_ptr != nullptr)
+        {
+            SnapshotSymbol symbol = {};
+            symbol.Id = symbol_ptr->Id;
+            std::memcpy(symbol.Name, symbol_ptr->Name, sizeof(symbol.Name));
+            write(&symbol, sizeof(symbol));
+        }
+    }
+
+    // Save order books with their orders in the queue order
+    std::vector<Order> orders;
+    for (auto order_book_ptr : market._order_books)
+    {
+        if (order_book_ptr != nullptr)
+        {
+            orders.clear();
+            SaveLevels(orders, *order_book_ptr, order_book_ptr->best_bid());
+            SaveLevels(orders, *order_book_ptr, order_book_ptr->best_ask());
+            SaveLevels(orders, order_book_ptr->buy_stop());
+            SaveLevels(orders, order_book_ptr->sell_stop());
+            SaveLevels(orders, order_book_ptr->trailing_buy_stop());
+            SaveLevels(orders, order_book_ptr->trailing_sell_stop());
+
+            SnapshotOrderBook order_book = {};
+            order_book.SymbolId = order_book_ptr->symbol().Id;
+            order_book.Ladder = order_book_ptr->_bid_ladder.capacity();
+            order_book.Tick = order_book_ptr->_bid_ladder.tick();
+            order_book.LastBidPrice = order_book_ptr->_last_bid_price;
+            order_book.LastAskPrice = order_book_ptr->_last_ask_price;
+            order_book.TrailingBidPrice = order_book_ptr->_trailing_bid_price;
+            order_book.TrailingAskPrice = order_book_ptr->_trailing_ask_price;
+            order_book.Orders = orders.size();
+            write(&order_book, sizeof(order_book));
+            write(orders.data(), orders.size() * sizeof(Order));
+        }
+    }
+
+    if (std::fflush(file) != 0)
+        result = false;
+    if (std::fclose(file) != 0)
+        result = false;
+    return result;
+}
+
+void MarketSnapshot::SaveLevels(std::vector<Order>& orders, const OrderBook& order_book, const LevelNode* level_ptr)
+{
+    for (; level_ptr != nullptr; level_ptr = order_book.GetNextLevel(level_ptr))
+        SaveLevel(orders, level_ptr);
+}
+
+void MarketSnapshot::SaveLevels(std::vector<Order>& orders, const OrderBook::Levels& levels)
+{
+    for (auto& level : levels)
+        SaveLevel(orders, &level);
+}
+
+void MarketSnapshot::SaveLevels(std::vector<Order>& orders, const TrailingStops& trailing_stops)
+{
+    // Stop prices of orders are saved from price levels which could be moved by the market
+    for (auto& level : trailing_stops)
+    {
+        for (auto& order : level.OrderList)
+        {
+            orders.push_back(order);
+            OrderBook::UpdateTrailingStopPrice(orders.back(), level.Price);
+        }
+    }
+}
+
+void MarketSnapshot::SaveLevel(std::vector<Order>& orders, const LevelNode* level_ptr)
+{
+    for (auto& order : level_ptr->OrderList)
+        orders.push_back(order);
+}
+
+bool MarketSnapshot::Load(MarketManager& market, const void* buffer, size_t size, uint64_t& sequence)
+{
+    // Restore only into the empty market manager
+    if (!market._orders.empty())
+        return false;
+    for (auto symbol_ptr : market._symbols)
+        if (symbol_ptr != nullptr)
+            return false;
+
+    const uint8_t* data = (const uint8_t*)buffer;
+    const uint8_t* end = data + size;
+
+    // Validate the snapshot header
+    SnapshotHeader header;
+    if (size < sizeof(header))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+    data += sizeof(header);
+    if ((std::memcmp(header.Magic, MAGIC, sizeof(MAGIC)) != 0) || (header.Version != VERSION) || (header.OrderSize != sizeof(Order)))
+        return false;
+    if ((uint64_t)(end - data) < header.Symbols * sizeof(SnapshotSymbol))
+        return false;
+
+    // Restore symbols
+    for (uint64_t i = 0; i < header.Symbols; ++i)
+    {
+        SnapshotSymbol symbol;
+        std::memcpy(&symbol, data, sizeof(symbol));
+        data += sizeof(symbol);
+
+        if (market._symbols.size() <= symbol.Id)
+            market._symbols.resize(symbol.Id + 1, nullptr);
+        if (market._symbols[symbol.Id] != nullptr)
+            return false;
+        market._symbols[symbol.Id] = market._symbol_pool.Create(Symbol(symbol.Id, symbol.Name));
+    }
+
+    // Bulk load orders index
+    market._orders.reserve(header.Orders);
+
+    // Restore order books and their orders in the queue order
+    for (uint64_t i = 0; i < header.OrderBooks; ++i)
+    {
+        SnapshotOrderBook order_book;
+        if ((size_t)(end - data) < sizeof(order_book))
+            return false;
+        std::memcpy(&order_book, data, sizeof(order_book));
+        data += sizeof(order_book);
+        if ((uint64_t)(end - data) < order_book.Orders * sizeof(Order))
+            return false;
+
+        if ((market._symbols.size() <= order_book.SymbolId) || (market._symbols[order_book.SymbolId] == nullptr))
+            return false;
+        if (market._order_books.size() <= order_book.SymbolId)
+            market._order_books.resize(order_book.SymbolId + 1, nullptr);
+        if (market._order_books[order_book.SymbolId] != nullptr)
+            return false;
+
+        OrderBook* order_book_ptr = market._order_book_pool.Create(*market._symbols[order_book.SymbolId], (size_t)order_book.Ladder, order_book.Tick);
+        market._order_books[order_book.SymbolId] = order_book_ptr;
+        order_book_ptr->_last_bid_price = order_book.LastBidPrice;
+        order_book_ptr->_last_ask_price = order_book.LastAskPrice;
+        order_book_ptr->_trailing_bid_price = order_book.TrailingBidPrice;
+        order_book_ptr->_trailing_ask_price = order_book.TrailingAskPrice;
+
+        for (uint64_t j = 0; j < order_book.Orders; ++j)
+        {
+            Order order;
+            std::memcpy(&order, data, sizeof(order));
+            data += sizeof(order);
+
+            OrderNode* order_ptr = market._order_pool.Create(order);
+            if (!market._orders.insert(std::make_pair(order_ptr->Id, order_ptr)).second)
+            {
+                market._order_pool.Release(order_ptr);
+                return false;
+            }
+
+            if (order_ptr->IsTrailingStop() || order_ptr->IsTrailingStopLimit())
+                order_book_ptr->AddTrailingStopOrder(order_ptr);
+            else if (order_ptr->IsStop() || order_ptr->IsStopLimit())
+                order_book_ptr->AddStopOrder(order_ptr);
+            else
+                order_book_ptr->AddOrder(order_ptr);
+        }
+    }
+
+    market._matching = (header.Matching != 0);
+    sequence = header.Sequence;
+    return true;
+}
+
+bool MarketSnapshot::Load(MarketManager& market, const std::string& path, uint64_t& sequence)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    // Read the whole snapshot file
+    std::vector<uint8_t> buffer;
+    uint8_t chunk[65536];
+    size_t size;
+    while ((size = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+        buffer.insert(buffer.end(), chunk, chunk + size);
+    bool result = (std::ferror(file) == 0);
+    std::fclose(file);
+
+    return result && Load(market, buffer.data(), buffer.size(), sequence);
+}
+
+} // namespace Matching
+} // namespace TradingPlatform
@@ -18,11 +18,27 @@ OrderBook::~OrderBook()
         _level_pool.Release(&bid);
     _bids.clear();
 
+    // Release bid price ladder levels
+    LevelNode* bid_ptr;
+    while ((bid_ptr = _bid_ladder.Lowest()) != nullptr)
+    {
+        _bid_ladder.Erase(bid_ptr);
+        _level_pool.Release(bid_ptr);
+    }
+
     // Release ask price levels
     for (auto& ask : _asks)
         _level_pool.Release(&ask);
     _asks.clear();
 
+    // Release ask price ladder levels
+    LevelNode* ask_ptr;
+    while ((ask_ptr = _ask_ladder.Lowest()) != nullptr)
+    {
+        _ask_ladder.Erase(ask_ptr);
+        _level_pool.Release(ask_ptr);
+    }
+
     // Release buy stop orders levels
     for (auto& buy_stop : _buy_stop)
         _level_pool.Release(&buy_stop);
@@ -33,15 +49,25 @@ OrderBook::~OrderBook()
         _level_pool.Release(&sell_stop);
     _sell_stop.clear();
 
-    // Release trailing buy stop orders levels
-    for (auto& trailing_buy_stop : _trailing_buy_stop)
-        _level_pool.Release(&trailing_buy_stop);
-    _trailing_buy_stop.clear();
+    // Release trailing buy/sell stop orders levels and buckets
+    ReleaseTrailingStops(_trailing_buy_stop);
+    ReleaseTrailingStops(_trailing_sell_stop);
+}
 
-    // Release trailing sell stop orders levels
-    for (auto& trailing_sell_stop : _trailing_sell_stop)
-        _level_pool.Release(&trailing_sell_stop);
-    _trailing_sell_stop.clear();
+void OrderBook::ReleaseTrailingStops(TrailingStops& trailing_stops)
+{
+    TrailingStopBucket* bucket_ptr;
+    while ((bucket_ptr = trailing_stops.buckets().front()) != nullptr)
+    {
+        LevelNode* level_ptr;
+        while ((level_ptr = bucket_ptr->Levels.lowest()) != nullptr)
+        {
+            trailing_stops.EraseLevel(level_ptr);
+            _level_pool.Release(level_ptr);
+        }
+        trailing_stops.EraseBucket(bucket_ptr);
+        _bucket_pool.Release(bucket_ptr);
+    }
 }
 
 LevelNode* OrderBook::AddLevel(OrderNode* order_ptr)
@@ -53,8 +79,9 @@ LevelNode* OrderBook::AddLevel(OrderNode* order_ptr)
         // Create a new price level
         level_ptr = _level_pool.Create(LevelType::BID, order_ptr->Price);
 
-        // Insert the price level into the bid collection
-        _bids.insert(*level_ptr);
+        // Insert the price level into the bid price ladder or the bid collection
+        InsertLevel(_bids, _bid_ladder, level_ptr);
+        _bid_index.Insert(level_ptr);
 
         // Update the best bid price level
         if ((_best_bid == nullptr) || (level_ptr->Price > _best_bid->Price))
@@ -65,8 +92,9 @@ LevelNode* OrderBook::AddLevel(OrderNode* order_ptr)
         // Create a new price level
         level_ptr = _level_pool.Create(LevelType::ASK, order_ptr->Price);
 
-        // Insert the price level into the ask collection
-        _asks.insert(*level_ptr);
+        // Insert the price level into the ask price ladder or the ask collection
+        InsertLevel(_asks, _ask_ladder, level_ptr);
+        _ask_index.Insert(level_ptr);
 
         // Update the best ask price level
         if ((_best_ask == nullptr) || (level_ptr->Price < _best_ask->Price))
@@ -85,19 +113,31 @@ LevelNode* OrderBook::DeleteLevel(OrderNode* order_ptr)
     {
         // Update the best bid price level
         if (level_ptr == _best_bid)
-            _best_bid = (_best_bid->left != nullptr) ? _best_bid->left : _best_bid->parent;
-
-        // Erase the price level from the bid collection
-        _bids.erase(Levels::iterator(&_bids, level_ptr));
+        {
+            if (_bid_ladder)
+                _best_bid = GetLowerLevel(_bids, _bid_ladder, _best_bid);
+            else
+                _best_bid = (_best_bid->left != nullptr) ? _best_bid->left : _best_bid->parent;
+        }
+
+        // Erase the price level from the bid price ladder or the bid collection
+        EraseLevel(_bids, _bid_ladder, level_ptr);
+        _bid_index.Erase(level_ptr);
     }
     else
     {
         // Update the best ask price level
         if (level_ptr == _best_ask)
-            _best_ask = (_best_ask->right != nullptr) ? _best_ask->right : _best_ask->parent;
-
-        // Erase the price level from the ask collection
-        _asks.erase(Levels::iterator(&_asks, level_ptr));
+        {
+            if (_ask_ladder)
+                _best_ask = GetHigherLevel(_asks, _ask_ladder, _best_ask);
+            else
+                _best_ask = (_best_ask->right != nullptr) ? _best_ask->right : _best_ask->parent;
+        }
+
+        // Erase the price level from the ask price ladder or the ask collection
+        EraseLevel(_asks, _ask_ladder, level_ptr);
+        _ask_index.Erase(level_ptr);
     }
 
     // Release the price level
@@ -106,6 +146,112 @@ LevelNode* OrderBook::DeleteLevel(OrderNode* order_ptr)
     return nullptr;
 }
 
+LevelNode* OrderBook::GetLowerLevel(Levels& levels, const PriceLadder& ladder, LevelNode* level) noexcept
+{
+    // Find the nearest lower price level in the price ladder
+    LevelNode* ladder_ptr = ladder.Lower(level->Price);
+
+    // Find the nearest lower price level in the fallback collection
+    LevelNode* levels_ptr = nullptr;
+    if (!ladder.Contains(level->Price))
+    {
+        Levels::reverse_iterator it(&levels, level);
+        ++it;
+        levels_ptr = it.operator->();
+    }
+    else if (!levels.empty())
+    {
+        // The given price level is kept in the price ladder, so the lower bound is strictly above it
+        auto it = levels.lower_bound(*level);
+        if (it != levels.end())
+        {
+            Levels::reverse_iterator rit(&levels, it.operator->());
+            ++rit;
+            levels_ptr = rit.operator->();
+        }
+        else
+            levels_ptr = levels.rbegin().operator->();
+    }
+
+    // Choose the best one
+    if (ladder_ptr == nullptr)
+        return levels_ptr;
+    if (levels_ptr == nullptr)
+        return ladder_ptr;
+    return (ladder_ptr->Price > levels_ptr->Price) ? ladder_ptr : levels_ptr;
+}
+
+LevelNode* OrderBook::GetHigherLevel(Levels& levels, const PriceLadder& ladder, LevelNode* level) noexcept
+{
+    // Find the nearest higher price level in the price ladder
+    LevelNode* ladder_ptr = ladder.Higher(level->Price);
+
+    // Find the nearest higher price level in the fallback collection
+    LevelNode* levels_ptr = nullptr;
+    if (!ladder.Contains(level->Price))
+    {
+        Levels::iterator it(&levels, level);
+        ++it;
+        levels_ptr = it.operator->();
+    }
+    else if (!levels.empty())
+    {
+        // The given price level is kept in the price ladder, so the lower bound is strictly above it
+        auto it = levels.lower_bound(*level);
+        levels_ptr = it.operator->();
+    }
+
+    // Choose the best one
+    if (ladder_ptr == nullptr)
+        return levels_ptr;
+    if (levels_ptr == nullptr)
+        return ladder_ptr;
+    return (ladder_ptr->Price < levels_ptr->Price) ? ladder_ptr : levels_ptr;
+}
+
+void OrderBook::InsertLevel(Levels& levels, PriceLadder& ladder, LevelNode* level)
+{
+    if (ladder)
+    {
+        // Re-centre the empty price ladder around the new price level
+        if (ladder.empty() && !ladder.Contains(level->Price) && ((level->Price % ladder.tick()) == 0))
+        {
+            ladder.Recenter(level->Price);
+
+            // Move fallback price levels inside the new window into the price ladder
+            auto it = levels.lower_bound(LevelNode(level->Type, ladder.low()));
+            while ((it != levels.end()) && (it->Price < ladder.high()))
+            {
+                LevelNode* level_ptr = it.operator->();
+                ++it;
+                if (ladder.Contains(level_ptr->Price))
+                {
+                    levels.erase(Levels::iterator(&levels, level_ptr));
+                    ladder.Insert(level_ptr);
+                }
+            }
+        }
+
+        // Insert the price level into the price ladder
+        if (ladder.Contains(level->Price))
+        {
+            ladder.Insert(level);
+            return;
+        }
+    }
+
+    // Insert the price level into the fallback collection
+    levels.insert(*level);
+}
+
+void OrderBook::EraseLevel(Levels& levels, PriceLadder& ladder, LevelNode* level)
+{
+    if (ladder.Contains(level->Price))
+        ladder.Erase(level);
+    else
+        levels.erase(Levels::iterator(&levels, level));
+}
+
 LevelUpdate OrderBook::AddOrder(OrderNode* order_ptr)
 {
     // Find the price level for the order
@@ -120,14 +266,21 @@ LevelUpdate OrderBook::AddOrder(OrderNode* order_ptr)
     }
 
     // Update the price level volume
+    uint64_t aon = order_ptr->IsAON() ? order_ptr->LeavesQuantity : 0;
     level_ptr->TotalVolume += order_ptr->LeavesQuantity;
     level_ptr->HiddenVolume += order_ptr->HiddenQuantity();
     level_ptr->VisibleVolume += order_ptr->VisibleQuantity();
+    level_ptr->AONVolume += aon;
+    (order_ptr->IsBuy() ? _bid_index : _ask_index).Add(level_ptr, order_ptr->LeavesQuantity, order_ptr->VisibleQuantity(), aon);
 
     // Link the new order to the orders list of the price level
     level_ptr->OrderList.push_back(*order_ptr);
     ++level_ptr->Orders;
 
+    // Count 'All-Or-None' orders of the order book side
+    if (order_ptr->IsAON())
+        ++(order_ptr->IsBuy() ? _aon_bids : _aon_asks);
+
     // Cache the price level in the given order
     order_ptr->Level = level_ptr;
 
@@ -141,15 +294,21 @@ LevelUpdate OrderBook::ReduceOrder(OrderNode* order_ptr, uint64_t quantity, uint
     LevelNode* level_ptr = order_ptr->Level;
 
     // Update the price level volume
+    uint64_t aon = order_ptr->IsAON() ? quantity : 0;
     level_ptr->TotalVolume -= quantity;
     level_ptr->HiddenVolume -= hidden;
     level_ptr->VisibleVolume -= visible;
+    level_ptr->AONVolume -= aon;
+    (order_ptr->IsBuy() ? _bid_index : _ask_index).Subtract(level_ptr, quantity, visible, aon);
 
     // Unlink the empty order from the orders list of the price level
     if (order_ptr->LeavesQuantity == 0)
     {
         level_ptr->OrderList.pop_current(*order_ptr);
         --level_ptr->Orders;
+
+        if (order_ptr->IsAON())
+            --(order_ptr->IsBuy() ? _aon_bids : _aon_asks);
     }
 
     Level level(*level_ptr);
@@ -173,14 +332,20 @@ LevelUpdate OrderBook::DeleteOrder(OrderNode* order_ptr)
     LevelNode* level_ptr = order_ptr->Level;
 
     // Update the price level volume
+    uint64_t aon = order_ptr->IsAON() ? order_ptr->LeavesQuantity : 0;
     level_ptr->TotalVolume -= order_ptr->LeavesQuantity;
     level_ptr->HiddenVolume -= order_ptr->HiddenQuantity();
     level_ptr->VisibleVolume -= order_ptr->VisibleQuantity();
+    level_ptr->AONVolume -= aon;
+    (order_ptr->IsBuy() ? _bid_index : _ask_index).Subtract(level_ptr, order_ptr->LeavesQuantity, order_ptr->VisibleQuantity(), aon);
 
     // Unlink the empty order from the orders list of the price level
     level_ptr->OrderList.pop_current(*order_ptr);
     --level_ptr->Orders;
 
+    if (order_ptr->IsAON())
+        --(order_ptr->IsBuy() ? _aon_bids : _aon_asks);
+
     Level level(*level_ptr);
 
     // Delete the empty price level
@@ -329,70 +494,93 @@ void OrderBook::DeleteStopOrder(OrderNode* order_ptr)
 
 LevelNode* OrderBook::AddTrailingStopLevel(OrderNode* order_ptr)
 {
-    LevelNode* level_ptr = nullptr;
+    TrailingStops& trailing_stops = order_ptr->IsBuy() ? _trailing_buy_stop : _trailing_sell_stop;
 
-    if (order_ptr->IsBuy())
+    // Find the bucket of the order trailing distance and step or create a new one
+    TrailingStopBucket* bucket_ptr = trailing_stops.GetBucket(order_ptr->TrailingDistance, order_ptr->TrailingStep);
+    if (bucket_ptr == nullptr)
     {
-        // Create a new price level
-        level_ptr = _level_pool.Create(LevelType::ASK, order_ptr->StopPrice);
-
-        // Insert the price level into the trailing buy stop orders collection
-        _trailing_buy_stop.insert(*level_ptr);
-
-        // Update the best trailing buy stop order price level
-        if ((_best_trailing_buy_stop == nullptr) || (level_ptr->Price < _best_trailing_buy_stop->Price))
-            _best_trailing_buy_stop = level_ptr;
+        bucket_ptr = _bucket_pool.Create(order_ptr->TrailingDistance, order_ptr->TrailingStep);
+        trailing_stops.InsertBucket(bucket_ptr);
     }
-    else
-    {
-        // Create a new price level
-        level_ptr = _level_pool.Create(LevelType::BID, order_ptr->StopPrice);
 
-        // Insert the price level into the trailing sell stop orders collection
-        _trailing_sell_stop.insert(*level_ptr);
+    // Create a new price level
+    LevelNode* level_ptr = _level_pool.Create(order_ptr->IsBuy() ? LevelType::ASK : LevelType::BID, order_ptr->StopPrice);
 
-        // Update the best trailing sell stop order price level
-        if ((_best_trailing_sell_stop == nullptr) || (level_ptr->Price > _best_trailing_sell_stop->Price))
-            _best_trailing_sell_stop = level_ptr;
-    }
+    // Insert the price level into the bucket
+    trailing_stops.InsertLevel(bucket_ptr, level_ptr);
 
     return level_ptr;
 }
 
 LevelNode* OrderBook::DeleteTrailingStopLevel(OrderNode* order_ptr)
 {
+    TrailingStops& trailing_stops = order_ptr->IsBuy() ? _trailing_buy_stop : _trailing_sell_stop;
+
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
+    TrailingStopBucket* bucket_ptr = level_ptr->Bucket;
 
-    if (order_ptr->IsBuy())
+    // Erase the price level from its bucket
+    trailing_stops.EraseLevel(level_ptr);
+
+    // Release the price level
+    _level_pool.Release(level_ptr);
+
+    // Release the empty bucket
+    if (bucket_ptr->Levels.empty())
     {
-        // Update the best trailing buy stop order price level
-        if (level_ptr == _best_trailing_buy_stop)
-            _best_trailing_buy_stop = (_best_trailing_buy_stop->right != nullptr) ? _best_trailing_buy_stop->right : _best_trailing_buy_stop->parent;
+        trailing_stops.EraseBucket(bucket_ptr);
+        _bucket_pool.Release(bucket_ptr);
+    }
+
+    return nullptr;
+}
+
+LevelNode* OrderBook::MergeTrailingStopLevels(LevelNode* level1, LevelNode* level2)
+{
+    // Orders of the first price level keep priority, orders of the smaller price level are relinked
+    LevelNode* target_ptr = (level1->Orders < level2->Orders) ? level2 : level1;
+    LevelNode* source_ptr = (target_ptr == level1) ? level2 : level1;
 
-        // Erase the price level from the trailing buy stop orders collection
-        _trailing_buy_stop.erase(Levels::iterator(&_trailing_buy_stop, level_ptr));
+    // Update the price level volume
+    target_ptr->TotalVolume += source_ptr->TotalVolume;
+    target_ptr->HiddenVolume += source_ptr->HiddenVolume;
+    target_ptr->VisibleVolume += source_ptr->VisibleVolume;
+    target_ptr->Orders += source_ptr->Orders;
+
+    // Relink orders and cache the new price level in them
+    OrderNode* order_ptr;
+    if (target_ptr == level1)
+    {
+        while ((order_ptr = level2->OrderList.pop_front()) != nullptr)
+        {
+            level1->OrderList.push_back(*order_ptr);
+            order_ptr->Level = level1;
+        }
     }
     else
     {
-        // Update the best trailing sell stop order price level
-        if (level_ptr == _best_trailing_sell_stop)
-            _best_trailing_sell_stop = (_best_trailing_sell_stop->left != nullptr) ? _best_trailing_sell_stop->left : _best_trailing_sell_stop->parent;
-
-        // Erase the price level from the trailing sell stop orders collection
-        _trailing_sell_stop.erase(Levels::iterator(&_trailing_sell_stop, level_ptr));
+        while ((order_ptr = level1->OrderList.pop_back()) != nullptr)
+        {
+            level2->OrderList.push_front(*order_ptr);
+            order_ptr->Level = level2;
+        }
     }
 
-    // Release the price level
-    _level_pool.Release(level_ptr);
+    // Release the merged price level
+    _level_pool.Release(source_ptr);
 
-    return nullptr;
+    return target_ptr;
 }
 
 void OrderBook::AddTrailingStopOrder(OrderNode* order_ptr)
 {
-    // Find the price level for the order
-    LevelNode* level_ptr = order_ptr->IsBuy() ? (LevelNode*)GetTrailingBuyStopLevel(order_ptr->StopPrice) : (LevelNode*)GetTrailingSellStopLevel(order_ptr->StopPrice);
+    TrailingStops& trailing_stops = order_ptr->IsBuy() ? _trailing_buy_stop : _trailing_sell_stop;
+
+    // Find the price level for the order in the bucket of its trailing distance and step
+    TrailingStopBucket* bucket_ptr = trailing_stops.GetBucket(order_ptr->TrailingDistance, order_ptr->TrailingStep);
+    LevelNode* level_ptr = (bucket_ptr != nullptr) ? trailing_stops.GetLevel(bucket_ptr, order_ptr->StopPrice) : nullptr;
 
     // Create a new price level if no one found
     if (level_ptr == nullptr)
@@ -416,6 +604,9 @@ void OrderBook::ReduceTrailingStopOrder(OrderNode* order_ptr, uint64_t quantity,
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
+    // Update the stop price of the order moved by the market
+    UpdateTrailingStopOrder(order_ptr);
+
     // Update the price level volume
     level_ptr->TotalVolume -= quantity;
     level_ptr->HiddenVolume -= hidden;
@@ -441,6 +632,9 @@ void OrderBook::DeleteTrailingStopOrder(OrderNode* order_ptr)
     // Find the price level for the order
     LevelNode* level_ptr = order_ptr->Level;
 
+    // Update the stop price of the order moved by the market
+    UpdateTrailingStopOrder(order_ptr);
+
     // Update the price level volume
     level_ptr->TotalVolume -= order_ptr->LeavesQuantity;
     level_ptr->HiddenVolume -= order_ptr->HiddenQuantity();
@@ -462,9 +656,11 @@ uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcep
 {
     // Get the current market price
     uint64_t market_price = order.IsBuy() ? GetMarketStopPriceAsk() : GetMarketStopPriceBid();
-    int64_t trailing_distance = order.TrailingDistance;
-    int64_t trailing_step = order.TrailingStep;
+    return CalculateTrailingStopPrice(order.IsBuy(), order.TrailingDistance, order.TrailingStep, market_price, order.StopPrice);
+}
 
+uint64_t OrderBook::CalculateTrailingStopPrice(bool buy, int64_t trailing_distance, int64_t trailing_step, uint64_t market_price, uint64_t old_price) noexcept
+{
     // Convert percentage trailing values into absolute ones
     if (trailing_distance < 0)
     {
@@ -472,9 +668,7 @@ uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcep
         trailing_step = (int64_t)((-trailing_step * market_price) / 10000);
     }
 
-    uint64_t old_price = order.StopPrice;
-
-    if (order.IsBuy())
+    if (buy)
     {
         // Calculate a new stop price
         uint64_t new_price = (market_price < (std::numeric_limits<uint64_t>::max() - trailing_distance)) ? (market_price + trailing_distance) : std::numeric_limits<uint64_t>::max();
@@ -498,5 +692,58 @@ uint64_t OrderBook::CalculateTrailingStopPrice(const Order& order) const noexcep
     return old_price;
 }
 
+bool OrderBook::RecalculateTrailingStops(TrailingStops& trailing_stops)
+{
+    bool buy = (trailing_stops.type() == LevelType::ASK);
+    uint64_t market_price = buy ? GetMarketStopPriceAsk() : GetMarketStopPriceBid();
+
+    bool result = false;
+
+    for (TrailingStopBucket* bucket_ptr = trailing_stops.buckets().front(); bucket_ptr != nullptr; bucket_ptr = bucket_ptr->next)
+    {
+        // Orders of the bucket move by the market in the same way, so all price
+        // levels far enough from the market are merged into the single price
+        // level with a new stop price. Stop prices of their orders are updated
+        // later from the price level. Orders keep their activation priority:
+        // orders of the existing price level with the new stop price go first,
+        // then orders of moved price levels from the best one.
+        LevelNode* moved_ptr = nullptr;
+        uint64_t new_stop_price = 0;
+
+        LevelNode* level_ptr;
+        while ((level_ptr = trailing_stops.GetWorstLevel(bucket_ptr)) != nullptr)
+        {
+            uint64_t stop_price = CalculateTrailingStopPrice(buy, bucket_ptr->TrailingDistance, bucket_ptr->TrailingStep, market_price, level_ptr->Price);
+            if (stop_price == level_ptr->Price)
+                break;
+
+            new_stop_price = stop_price;
+            trailing_stops.EraseLevel(level_ptr);
+            // Price levels are taken from the worst one, so orders of the better price level go first
+            moved_ptr = (moved_ptr != nullptr) ? MergeTrailingStopLevels(level_ptr, moved_ptr) : level_ptr;
+        }
+
+        if (moved_ptr == nullptr)
+            continue;
+
+        // Merge with the existing price level of the new stop price
+        level_ptr = trailing_stops.GetLevel(bucket_ptr, new_stop_price);
+        if (level_ptr != nullptr)
+        {
+            trailing_stops.EraseLevel(level_ptr);
+            moved_ptr = MergeTrailingStopLevels(level_ptr, moved_ptr);
+        }
+
+        // Insert the moved price level with the new stop price
+        moved_ptr->Price = new_stop_price;
+        trailing_stops.InsertLevel(bucket_ptr, moved_ptr);
+        bucket_ptr->Moved.push_back(moved_ptr);
+
+        result = true;
+    }
+
+    return result;
+}
+
 } // namespace Matching
 } // namespace TradingPlatform
@@ -0,0 +1,280 @@
+/*!
+    \file batch_itch_handler.cpp
+    \brief NASDAQ ITCH batch handler implementation
+    \author Igor Sokolov
+    \date 17.10.2026
+    \copyright MIT License
+*/
+
+#include "trader/providers/nasdaq/batch_itch_handler.h"
+
+#include <algorithm>
+
+namespace TradingPlatform {
+namespace ITCH {
+
+namespace {
+
+const uint64_t MASK64 = ~(uint64_t)0;
+const uint32_t MASK32 = ~(uint32_t)0;
+const uint8_t MASK8 = 0xFF;
+
+// Layout index of the message type
+struct LayoutIndex
+{
+    uint8_t Index[256];
+
+    LayoutIndex() : Index()
+    {
+        Index['A'] = 1;
+        Index['E'] = 2;
+        Index['C'] = 3;
+        Index['X'] = 4;
+        Index['D'] = 5;
+        Index['U'] = 6;
+    }
+
+    uint8_t operator[](uint8_t type) const noexcept { return Index[type]; }
+};
+
+const LayoutIndex LAYOUT_INDEX;
+
+} // namespace
+
+// Size, offsets of new order reference number, buy/sell indicator, shares, stock, price, match number, printable and their masks
+const BatchITCHHandler::Layout BatchITCHHandler::LAYOUTS[7] =
+{
+    { 0xFF, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { AddOrderMessage::SIZE, 0, 19, 20, 24, 32, 0, 0, 0, MASK64, 0, MASK32, MASK32, MASK8, 0 },
+    { OrderExecutedMessage::SIZE, 0, 0, 19, 0, 0, 23, 0, 0, 0, MASK64, MASK32, 0, 0, 0 },
+    { OrderExecutedWithPriceMessage::SIZE, 0, 0, 19, 0, 32, 23, 31, 0, 0, MASK64, MASK32, MASK32, 0, MASK8 },
+    { OrderCancelMessage::SIZE, 0, 0, 19, 0, 0, 0, 0, 0, 0, 0, MASK32, 0, 0, 0 },
+    { OrderDeleteMessage::SIZE, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+    { OrderReplaceMessage::SIZE, 19, 0, 27, 0, 31, 0, 0, MASK64, 0, 0, MASK32, MASK32, 0, 0 }
+};
+
+void OrderMessageBatch::Resize(size_t capacity)
+{
+    Size = 0;
+    Type.resize(capacity);
+    StockLocate.resize(capacity);
+    TrackingNumber.resize(capacity);
+    Timestamp.resize(capacity);
+    OrderReferenceNumber.resize(capacity);
+    NewOrderReferenceNumber.resize(capacity);
+    BuySellIndicator.resize(capacity);
+    Shares.resize(capacity);
+    Stock.resize(capacity);
+    Price.resize(capacity);
+    MatchNumber.resize(capacity);
+    Printable.resize(capacity);
+}
+
+BatchITCHHandler::BatchITCHHandler(size_t capacity)
+    : _capacity(std::max(capacity, (size_t)1))
+{
+    _frames.resize(_capacity);
+    _sizes.resize(_capacity);
+    _layouts.resize(_capacity);
+    _orders.Resize(_capacity);
+}
+
+bool BatchITCHHandler::ProcessBatch(void* buffer, size_t size)
+{
+    size_t index = 0;
+    uint8_t* data = (uint8_t*)buffer;
+
+    // Complete the frame left from the previous buffer
+    if (cached())
+    {
+        bool result = true;
+        index += ProcessCache(data, size, result);
+        if (!result)
+            return false;
+    }
+
+    while (index < size)
+    {
+        // Index whole frames of the buffer
+        size_t count = 0;
+        size_t indexed = IndexFrames(&data[index], size - index, count);
+
+        // Keep the incomplete frame till the next buffer
+        if (indexed == 0)
+        {
+            CacheFrame(&data[index], size - index);
+            break;
+        }
+
+        if (!ProcessFrames(count))
+            return false;
+        index += indexed;
+    }
+
+    return true;
+}
+
+size_t BatchITCHHandler::IndexFrames(uint8_t* data, size_t size, size_t& count)
+{
+    size_t index = 0;
+
+    while ((count < _capacity) && (index + 2 <= size))
+    {
+        size_t frame = ((size_t)data[index] << 8) | data[index + 1];
+        if (index + 2 + frame > size)
+            break;
+
+        // Empty frames are skipped the same way as Process() does
+        if (frame > 0)
+        {
+            uint8_t* message = &data[index + 2];
+
+            // Batch only order messages of the valid size, others are processed one by one
+            uint8_t layout = LAYOUT_INDEX[*message];
+            if (frame < LAYOUTS[layout].Size)
+                layout = 0;
+
+            _frames[count] = message;
+            _sizes[count] = (uint16_t)frame;
+            _layouts[count] = layout;
+            ++count;
+        }
+
+        index += 2 + frame;
+    }
+
+    return index;
+}
+
+bool BatchITCHHandler::ProcessFrames(size_t count)
+{
+    size_t first = 0;
+    while (first < count)
+    {
+        // Process other messages one by one
+        if (_layouts[first] == 0)
+        {
+            if (!ProcessMessage(_frames[first], _sizes[first]))
+                return false;
+            ++first;
+            continue;
+        }
+
+        // Find the run of order messages
+        size_t last = first + 1;
+        while ((last < count) && (_layouts[last] != 0))
+            ++last;
+
+        if (!ProcessOrders(first, last))
+            return false;
+
+        first = last;
+    }
+
+    return true;
+}
+
+bool BatchITCHHandler::ProcessOrders(size_t first, size_t last)
+{
+    Decode(_orders, &_frames[first], &_layouts[first], last - first);
+    return onMessages(_orders);
+}
+
+bool BatchITCHHandler::onMessages(const OrderMessageBatch& batch)
+{
+    for (size_t i = 0; i < batch.Size; ++i)
+    {
+        bool result = true;
+        switch (batch.Type[i])
+        {
+            case 'A':
+            {
+                AddOrderMessage message;
+                message.Type = batch.Type[i];
+                message.StockLocate = batch.StockLocate[i];
+                message.TrackingNumber = batch.TrackingNumber[i];
+                message.Timestamp = batch.Timestamp[i];
+                message.OrderReferenceNumber = batch.OrderReferenceNumber[i];
+                message.BuySellIndicator = batch.BuySellIndicator[i];
+                message.Shares = batch.Shares[i];
+                std::memcpy(message.Stock, batch.Stock[i].data(), sizeof(message.Stock));
+                message.Price = batch.Price[i];
+                result = onMessage(message);
+                break;
+            }
+            case 'E':
+            {
+                OrderExecutedMessage message;
+                message.Type = batch.Type[i];
+                message.StockLocate = batch.StockLocate[i];
+                message.TrackingNumber = batch.TrackingNumber[i];
+                message.Timestamp = batch.Timestamp[i];
+                message.OrderReferenceNumber = batch.OrderReferenceNumber[i];
+                message.ExecutedShares = batch.Shares[i];
+                message.MatchNumber = batch.MatchNumber[i];
+                result = onMessage(message);
+                break;
+            }
+            case 'C':
+            {
+                OrderExecutedWithPriceMessage message;
+                message.Type = batch.Type[i];
+                message.StockLocate = batch.StockLocate[i];
+                message.TrackingNumber = batch.TrackingNumber[i];
+                message.Timestamp = batch.Timestamp[i];
+                message.OrderReferenceNumber = batch.OrderReferenceNumber[i];
+                message.ExecutedShares = batch.Shares[i];
+                message.MatchNumber = batch.MatchNumber[i];
+                message.Printable = batch.Printable[i];
+                message.ExecutionPrice = batch.Price[i];
+                result = onMessage(message);
+                break;
+            }
+            case 'X':
+            {
+                OrderCancelMessage message;
+                message.Type = batch.Type[i];
+                message.StockLocate = batch.StockLocate[i];
+                message.TrackingNumber = batch.TrackingNumber[i];
+                message.Timestamp = batch.Timestamp[i];
+                message.OrderReferenceNumber = batch.OrderReferenceNumber[i];
+                message.CanceledShares = batch.Shares[i];
+                result = onMessage(message);
+                break;
+            }
+            case 'D':
+            {
+                OrderDeleteMessage message;
+                message.Type = batch.Type[i];
+                message.StockLocate = batch.StockLocate[i];
+                message.TrackingNumber = batch.TrackingNumber[i];
+                message.Timestamp = batch.Timestamp[i];
+                message.OrderReferenceNumber = batch.OrderReferenceNumber[i];
+                result = onMessage(message);
+                break;
+            }
+            case 'U':
+            {
+                OrderReplaceMessage message;
+                message.Type = batch.Type[i];
+                message.StockLocate = batch.StockLocate[i];
+                message.TrackingNumber = batch.TrackingNumber[i];
+                message.Timestamp = batch.Timestamp[i];
+                message.OriginalOrderReferenceNumber = batch.OrderReferenceNumber[i];
+                message.NewOrderReferenceNumber = batch.NewOrderReferenceNumber[i];
+                message.Shares = batch.Shares[i];
+                message.Price = batch.Price[i];
+                result = onMessage(message);
+                break;
+            }
+            default:
+                break;
+        }
+        if (!result)
+            return false;
+    }
+    return true;
+}
+
+} // namespace ITCH
+} // namespace TradingPlatform
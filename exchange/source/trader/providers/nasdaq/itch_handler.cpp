@@ -8,7 +8,9 @@
 
 #include "trader/providers/nasdaq/itch_handler.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace TradingPlatform {
 namespace ITCH {
@@ -18,87 +20,76 @@ bool ITCHHandler::Process(void* buffer, size_t size)
     size_t index = 0;
     uint8_t* data = (uint8_t*)buffer;
 
-    while (index < size)
+    // Complete the frame split between buffers
+    if (_cached > 0)
     {
-        if (_size == 0)
-        {
-            size_t remaining = size - index;
-
-            // Collect message size into the cache
-            if (((_cache.size() == 0) && (remaining < 3)) || (_cache.size() == 1))
-            {
-                _cache.push_back(data[index++]);
-                continue;
-            }
-
-            // Read a new message size
-            uint16_t message_size;
-            if (_cache.empty())
-            {
-                // Read the message size directly from the input buffer
-                index += CppCommon::Endian::ReadBigEndian(&data[index], message_size);
-            }
-            else
-            {
-                // Read the message size from the cache
-                CppCommon::Endian::ReadBigEndian(_cache.data(), message_size);
-
-                // Clear the cache
-                _cache.clear();
-            }
-            _size = message_size;
-        }
-
-        // Read a new message
-        if (_size > 0)
-        {
-            size_t remaining = size - index;
-
-            // Complete or place the message into the cache
-            if (!_cache.empty())
-            {
-                size_t tail = _size - _cache.size();
-                if (tail > remaining)
-                    tail = remaining;
-                _cache.insert(_cache.end(), &data[index], &data[index + tail]);
-                index += tail;
-                if (_cache.size() < _size)
-                    continue;
-            }
-            else if (_size > remaining)
-            {
-                _cache.reserve(_size);
-                _cache.insert(_cache.end(), &data[index], &data[index + remaining]);
-                index += remaining;
-                continue;
-            }
-
-            // Process the current message
-            if (_cache.empty())
-            {
-                // Process the current message size directly from the input buffer
-                if (!ProcessMessage(&data[index], _size))
-                    return false;
-                index += _size;
-            }
-            else
-            {
-                // Process the current message size directly from the cache
-                if (!ProcessMessage(_cache.data(), _size))
-                    return false;
-
-                // Clear the cache
-                _cache.clear();
-            }
-
-            // Process the next message
-            _size = 0;
-        }
+        bool result = true;
+        index += ProcessCache(data, size, result);
+        if (!result)
+            return false;
     }
 
+    // Process whole frames directly from the input buffer
+    while (index + 2 <= size)
+    {
+        size_t frame = ((size_t)data[index] << 8) | data[index + 1];
+        if (index + 2 + frame > size)
+            break;
+
+        // Empty frames are skipped
+        if ((frame > 0) && !ProcessMessage(&data[index + 2], frame))
+            return false;
+
+        index += 2 + frame;
+    }
+
+    // Keep the incomplete frame till the next buffer
+    if (index < size)
+        CacheFrame(&data[index], size - index);
+
     return true;
 }
 
+void ITCHHandler::CacheFrame(const uint8_t* data, size_t size)
+{
+    assert((size < sizeof(_cache)) && "Incomplete frame is too big for the reassembly buffer!");
+
+    std::memcpy(_cache, data, size);
+    _cached = size;
+}
+
+size_t ITCHHandler::ProcessCache(uint8_t* data, size_t size, bool& result)
+{
+    size_t index = 0;
+
+    // Collect the frame size
+    if (_cached < 2)
+    {
+        size_t header = std::min(2 - _cached, size);
+        std::memcpy(&_cache[_cached], data, header);
+        _cached += header;
+        index += header;
+        if (_cached < 2)
+            return index;
+    }
+
+    // Collect the frame body
+    size_t frame = 2 + (((size_t)_cache[0] << 8) | _cache[1]);
+    size_t tail = std::min(frame - _cached, size - index);
+    std::memcpy(&_cache[_cached], &data[index], tail);
+    _cached += tail;
+    index += tail;
+    if (_cached < frame)
+        return index;
+
+    // Empty frames are skipped
+    if (frame > 2)
+        result = ProcessMessage(&_cache[2], frame - 2);
+    _cached = 0;
+    ++_fragmented;
+    return index;
+}
+
 bool ITCHHandler::ProcessMessage(void* buffer, size_t size)
 {
     // Message is empty
@@ -156,8 +147,8 @@ bool ITCHHandler::ProcessMessage(void* buffer, size_t size)
 
 void ITCHHandler::Reset()
 {
-    _size = 0;
-    _cache.clear();
+    _cached = 0;
+    _fragmented = 0;
 }
 
 bool ITCHHandler::ProcessSystemEventMessage(void* buffer, size_t size)
@@ -0,0 +1,281 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/providers/nasdaq/batch_itch_handler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace TradingPlatform::ITCH;
+
+namespace {
+
+// Serialized copies of all received messages in the order they were handled
+class RecordingITCHHandler : public BatchITCHHandler
+{
+public:
+    explicit RecordingITCHHandler(size_t capacity = 1024) : BatchITCHHandler(capacity) {}
+
+    std::vector<std::vector<uint8_t>> messages;
+
+protected:
+    bool onMessage(const SystemEventMessage& message) override { return Record(message); }
+    bool onMessage(const StockDirectoryMessage& message) override { return Record(message); }
+    bool onMessage(const AddOrderMessage& message) override { return Record(message); }
+    bool onMessage(const OrderExecutedMessage& message) override { return Record(message); }
+    bool onMessage(const OrderExecutedWithPriceMessage& message) override { return Record(message); }
+    bool onMessage(const OrderCancelMessage& message) override { return Record(message); }
+    bool onMessage(const OrderDeleteMessage& message) override { return Record(message); }
+    bool onMessage(const OrderReplaceMessage& message) override { return Record(message); }
+    bool onMessage(const TradeMessage& message) override { return Record(message); }
+    bool onMessage(const UnknownMessage& message) override { messages.emplace_back(1, (uint8_t)message.Type); return true; }
+
+private:
+    template <class TMessage>
+    bool Record(const TMessage& message)
+    {
+        uint8_t buffer[TMessage::SIZE] = {};
+        message.serialize(buffer, sizeof(buffer));
+        messages.emplace_back(buffer, buffer + sizeof(buffer));
+        return true;
+    }
+};
+
+// Checks columns of order message batches
+class ColumnsITCHHandler : public BatchITCHHandler
+{
+public:
+    size_t orders = 0;
+    size_t adds = 0;
+    size_t deletes = 0;
+    uint64_t shares = 0;
+    uint64_t references = 0;
+    uint64_t replaces = 0;
+
+protected:
+    bool onMessages(const OrderMessageBatch& batch) override
+    {
+        orders += batch.Size;
+        for (size_t i = 0; i < batch.Size; ++i)
+        {
+            switch (batch.Type[i])
+            {
+                case 'A':
+                    ++adds;
+                    shares += batch.Shares[i];
+                    REQUIRE(batch.NewOrderReferenceNumber[i] == 0);
+                    break;
+                case 'D':
+                    ++deletes;
+                    references += batch.OrderReferenceNumber[i];
+                    REQUIRE(batch.Shares[i] == 0);
+                    REQUIRE(batch.Price[i] == 0);
+                    break;
+                case 'U':
+                    replaces += batch.NewOrderReferenceNumber[i] - batch.OrderReferenceNumber[i];
+                    break;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+};
+
+template <class TMessage>
+void Append(std::vector<uint8_t>& stream, const TMessage& message)
+{
+    uint8_t buffer[TMessage::SIZE] = {};
+    message.serialize(buffer, sizeof(buffer));
+    stream.push_back((uint8_t)(TMessage::SIZE >> 8));
+    stream.push_back((uint8_t)(TMessage::SIZE & 0xFF));
+    stream.insert(stream.end(), buffer, buffer + sizeof(buffer));
+}
+
+std::vector<uint8_t> Stream()
+{
+    std::vector<uint8_t> stream;
+
+    SystemEventMessage system;
+    system.Type = 'S';
+    system.StockLocate = 0;
+    system.TrackingNumber = 1;
+    system.Timestamp = 0x123456;
+    system.EventCode = 'O';
+    Append(stream, system);
+
+    StockDirectoryMessage directory = {};
+    directory.Type = 'R';
+    directory.StockLocate = 1;
+    std::memcpy(directory.Stock, "TEST    ", 8);
+    Append(stream, directory);
+
+    // Empty frame is skipped
+    stream.push_back(0);
+    stream.push_back(0);
+
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        // Runs of different lengths
+        for (uint64_t j = 0; j < (i % 5) + 1; ++j)
+        {
+            AddOrderMessage add;
+            add.Type = 'A';
+            add.StockLocate = (uint16_t)(i % 7);
+            add.TrackingNumber = (uint16_t)j;
+            add.Timestamp = 0xABCDEF - i;
+            add.OrderReferenceNumber = 0x0102030405060708ull + i * 10 + j;
+            add.BuySellIndicator = (j % 2) ? 'B' : 'S';
+            add.Shares = (uint32_t)(i * 100 + j);
+            std::memcpy(add.Stock, "TEST    ", 8);
+            add.Price = (uint32_t)(0x01020304 + i);
+            Append(stream, add);
+        }
+
+        OrderExecutedMessage executed;
+        executed.Type = 'E';
+        executed.StockLocate = 1;
+        executed.TrackingNumber = 2;
+        executed.Timestamp = i;
+        executed.OrderReferenceNumber = i * 10;
+        executed.ExecutedShares = (uint32_t)i;
+        executed.MatchNumber = 0x1122334455667788ull + i;
+        Append(stream, executed);
+
+        OrderExecutedWithPriceMessage executed_with_price;
+        executed_with_price.Type = 'C';
+        executed_with_price.StockLocate = 1;
+        executed_with_price.TrackingNumber = 3;
+        executed_with_price.Timestamp = i;
+        executed_with_price.OrderReferenceNumber = i * 10 + 1;
+        executed_with_price.ExecutedShares = (uint32_t)i;
+        executed_with_price.MatchNumber = i;
+        executed_with_price.Printable = 'Y';
+        executed_with_price.ExecutionPrice = (uint32_t)(1000 + i);
+        Append(stream, executed_with_price);
+
+        OrderCancelMessage cancel;
+        cancel.Type = 'X';
+        cancel.StockLocate = 1;
+        cancel.TrackingNumber = 4;
+        cancel.Timestamp = i;
+        cancel.OrderReferenceNumber = i * 10 + 2;
+        cancel.CanceledShares = (uint32_t)i;
+        Append(stream, cancel);
+
+        if ((i % 3) == 0)
+        {
+            TradeMessage trade = {};
+            trade.Type = 'P';
+            trade.OrderReferenceNumber = i;
+            Append(stream, trade);
+        }
+
+        OrderDeleteMessage remove;
+        remove.Type = 'D';
+        remove.StockLocate = 1;
+        remove.TrackingNumber = 5;
+        remove.Timestamp = i;
+        remove.OrderReferenceNumber = i * 10 + 3;
+        Append(stream, remove);
+        remove.OrderReferenceNumber = i * 10 + 4;
+        Append(stream, remove);
+
+        OrderReplaceMessage replace;
+        replace.Type = 'U';
+        replace.StockLocate = 1;
+        replace.TrackingNumber = 6;
+        replace.Timestamp = i;
+        replace.OriginalOrderReferenceNumber = i * 10 + 5;
+        replace.NewOrderReferenceNumber = i * 10 + 6;
+        replace.Shares = (uint32_t)i;
+        replace.Price = (uint32_t)(2000 + i);
+        Append(stream, replace);
+    }
+
+    // Unknown message
+    stream.push_back(0);
+    stream.push_back(3);
+    stream.push_back('Z');
+    stream.push_back(1);
+    stream.push_back(2);
+
+    return stream;
+}
+
+} // namespace
+
+TEST_CASE("ITCH batch handler", "[TradingPlatform][ITCH]")
+{
+    std::vector<uint8_t> stream = Stream();
+
+    RecordingITCHHandler expected;
+    REQUIRE(expected.Process(stream.data(), stream.size()));
+    REQUIRE(expected.messages.size() == 936);
+
+    // Buffers split frames at any position and batches of different capacity give the same messages
+    for (size_t capacity : { 1, 3, 1024 })
+    {
+        for (size_t chunk : { 1, 2, 7, 100, 4096 })
+        {
+            RecordingITCHHandler handler(capacity);
+            for (size_t offset = 0; offset < stream.size(); offset += chunk)
+                REQUIRE(handler.ProcessBatch(&stream[offset], std::min(chunk, stream.size() - offset)));
+            REQUIRE(handler.messages == expected.messages);
+        }
+    }
+
+    // Frames split between buffers are completed in the reassembly buffer
+    for (size_t chunk : { 1, 2, 7, 100, 4096 })
+    {
+        RecordingITCHHandler handler;
+        for (size_t offset = 0; offset < stream.size(); offset += chunk)
+            REQUIRE(handler.Process(&stream[offset], std::min(chunk, stream.size() - offset)));
+        REQUIRE(handler.messages == expected.messages);
+        REQUIRE(handler.fragmented() > 0);
+    }
+    REQUIRE(expected.fragmented() == 0);
+
+    // Process() and ProcessBatch() could be mixed for the same stream
+    RecordingITCHHandler mixed;
+    for (size_t offset = 0, i = 0; offset < stream.size(); offset += 100, ++i)
+    {
+        size_t chunk = std::min((size_t)100, stream.size() - offset);
+        bool result = ((i % 2) == 0) ? mixed.Process(&stream[offset], chunk) : mixed.ProcessBatch(&stream[offset], chunk);
+        REQUIRE(result);
+    }
+    REQUIRE(mixed.messages == expected.messages);
+}
+
+TEST_CASE("ITCH batch handler columns", "[TradingPlatform][ITCH]")
+{
+    std::vector<uint8_t> stream = Stream();
+
+    ColumnsITCHHandler handler;
+    REQUIRE(handler.ProcessBatch(stream.data(), stream.size()));
+
+    size_t adds = 0;
+    uint64_t shares = 0;
+    uint64_t references = 0;
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        for (uint64_t j = 0; j < (i % 5) + 1; ++j)
+        {
+            ++adds;
+            shares += i * 100 + j;
+        }
+        references += (i * 10 + 3) + (i * 10 + 4);
+    }
+
+    // Execute, execute with price, cancel, two deletes and replace per iteration
+    REQUIRE(handler.orders == adds + 600);
+    REQUIRE(handler.adds == adds);
+    REQUIRE(handler.shares == shares);
+    REQUIRE(handler.deletes == 200);
+    REQUIRE(handler.references == references);
+    REQUIRE(handler.replaces == 100);
+}
@@ -0,0 +1,179 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/batch_market_handler.h"
+#include "trader/matching/market_manager.h"
+
+#include <tuple>
+#include <vector>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+namespace {
+
+typedef std::tuple<MarketEventType, uint64_t, uint64_t, uint64_t> Event;
+
+// Records every market handler callback
+class RecordingHandler final : public MarketHandler
+{
+    friend class BasicMarketManager<RecordingHandler>;
+
+public:
+    std::vector<Event> events;
+
+protected:
+    void onAddSymbol(const Symbol& symbol) override { events.emplace_back(MarketEventType::ADD_SYMBOL, symbol.Id, 0, 0); }
+    void onDeleteSymbol(const Symbol& symbol) override { events.emplace_back(MarketEventType::DELETE_SYMBOL, symbol.Id, 0, 0); }
+    void onAddOrderBook(const OrderBook& order_book) override { events.emplace_back(MarketEventType::ADD_ORDER_BOOK, order_book.symbol().Id, 0, 0); }
+    void onUpdateOrderBook(const OrderBook& order_book, bool top) override { events.emplace_back(MarketEventType::UPDATE_ORDER_BOOK, order_book.symbol().Id, top, 0); }
+    void onDeleteOrderBook(const OrderBook& order_book) override { events.emplace_back(MarketEventType::DELETE_ORDER_BOOK, order_book.symbol().Id, 0, 0); }
+    void onAddLevel(const OrderBook& order_book, const Level& level, bool top) override { events.emplace_back(MarketEventType::ADD_LEVEL, level.Price, level.TotalVolume, level.Orders); }
+    void onUpdateLevel(const OrderBook& order_book, const Level& level, bool top) override { events.emplace_back(MarketEventType::UPDATE_LEVEL, level.Price, level.TotalVolume, level.Orders); }
+    void onDeleteLevel(const OrderBook& order_book, const Level& level, bool top) override { events.emplace_back(MarketEventType::DELETE_LEVEL, level.Price, level.TotalVolume, level.Orders); }
+    void onAddOrder(const Order& order) override { events.emplace_back(MarketEventType::ADD_ORDER, order.Id, order.Price, order.LeavesQuantity); }
+    void onUpdateOrder(const Order& order) override { events.emplace_back(MarketEventType::UPDATE_ORDER, order.Id, order.Price, order.LeavesQuantity); }
+    void onDeleteOrder(const Order& order) override { events.emplace_back(MarketEventType::DELETE_ORDER, order.Id, order.Price, order.LeavesQuantity); }
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { events.emplace_back(MarketEventType::EXECUTE_ORDER, order.Id, price, quantity); }
+};
+
+// Converts batches of market events into the same records
+class RecordingBatchHandler : public BatchMarketHandler
+{
+public:
+    std::vector<Event> events;
+    size_t batches = 0;
+
+protected:
+    void onMarketEvents(const MarketEvent* batch, size_t size) override
+    {
+        ++batches;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const MarketEvent& event = batch[i];
+            switch (event.Type)
+            {
+                case MarketEventType::ADD_SYMBOL:
+                case MarketEventType::DELETE_SYMBOL:
+                case MarketEventType::ADD_ORDER_BOOK:
+                case MarketEventType::DELETE_ORDER_BOOK:
+                    events.emplace_back(event.Type, event.SymbolId, 0, 0);
+                    break;
+                case MarketEventType::UPDATE_ORDER_BOOK:
+                    events.emplace_back(event.Type, event.SymbolId, event.Top, 0);
+                    break;
+                case MarketEventType::ADD_LEVEL:
+                case MarketEventType::UPDATE_LEVEL:
+                case MarketEventType::DELETE_LEVEL:
+                    events.emplace_back(event.Type, event.Price, event.Quantity, event.ExecutedQuantity);
+                    break;
+                case MarketEventType::EXECUTE_ORDER:
+                    events.emplace_back(event.Type, event.Id, event.Price, event.Quantity);
+                    break;
+                default:
+                    events.emplace_back(event.Type, event.Id, event.Price, event.LeavesQuantity);
+                    break;
+            }
+        }
+    }
+};
+
+template <class TMarketManager>
+void RunFlow(TMarketManager& market, size_t& commands)
+{
+    const char name[8] = "test";
+    market.AddSymbol(Symbol(0, name));
+    market.AddOrderBook(Symbol(0, name));
+    market.EnableMatching();
+    commands = 3;
+
+    uint64_t seed = 1;
+    auto random = [&seed](uint64_t range)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return (seed >> 33) % range;
+    };
+
+    for (uint64_t id = 1; id <= 5000; ++id)
+    {
+        uint64_t price = 900 + random(200);
+        uint64_t quantity = 1 + random(100);
+        switch (random(6))
+        {
+            case 0:
+                market.AddOrder(Order::SellLimit(id, 0, price, quantity, OrderTimeInForce::GTC, quantity / 4));
+                break;
+            case 1:
+                market.AddOrder(Order::BuyStop(id, 0, price, quantity));
+                break;
+            case 2:
+            {
+                uint64_t order_id = 1 + random(id);
+                if (market.GetOrder(order_id) == nullptr)
+                    continue;
+                market.ReplaceOrder(order_id, Order::BuyLimit(id, 0, price, quantity));
+                break;
+            }
+            case 3:
+            {
+                uint64_t order_id = 1 + random(id);
+                if (market.GetOrder(order_id) == nullptr)
+                    continue;
+                market.ModifyOrder(order_id, price, quantity);
+                break;
+            }
+            default:
+                market.AddOrder((random(2) == 0) ? Order::BuyLimit(id, 0, price, quantity) : Order::SellLimit(id, 0, price, quantity));
+                break;
+        }
+        ++commands;
+    }
+
+    market.DeleteOrderBook(0);
+    market.DeleteSymbol(0);
+    commands += 2;
+}
+
+}
+
+TEST_CASE("Batch market handler", "[TradingPlatform][Matching]")
+{
+    RecordingHandler handler;
+    MarketManager market(handler);
+    size_t commands;
+    RunFlow(market, commands);
+
+    RecordingBatchHandler batch_handler;
+    MarketManager batch_market(batch_handler);
+    size_t batch_commands;
+    RunFlow(batch_market, batch_commands);
+
+    // Batches should contain the same events in the same order
+    REQUIRE(!handler.events.empty());
+    REQUIRE(batch_handler.events == handler.events);
+
+    // Each command produces at most one batch (nested public commands are flushed once)
+    REQUIRE(batch_commands == commands);
+    REQUIRE(batch_handler.batches > 0);
+    REQUIRE(batch_handler.batches <= batch_commands);
+}
+
+TEST_CASE("Static market handler binding", "[TradingPlatform][Matching]")
+{
+    RecordingHandler handler;
+    MarketManager market(handler);
+    size_t commands;
+    RunFlow(market, commands);
+
+    RecordingHandler static_handler;
+    BasicMarketManager<RecordingHandler> static_market(static_handler);
+    size_t static_commands;
+    RunFlow(static_market, static_commands);
+
+    // Statically bound handler should receive the same events
+    REQUIRE(!handler.events.empty());
+    REQUIRE(static_handler.events == handler.events);
+}
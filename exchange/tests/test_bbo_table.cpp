@@ -0,0 +1,118 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_manager.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+TEST_CASE("BBO table", "[TradingPlatform][Matching]")
+{
+    BBOTable table("test_bbo_table", 16);
+    REQUIRE(table.valid());
+
+    MarketManager market;
+    market.AttachBBOTable(&table);
+    const char name[8] = "test";
+    market.AddSymbol(Symbol(1, name));
+    market.AddOrderBook(Symbol(1, name));
+    market.EnableMatching();
+
+    BBO bbo;
+    REQUIRE(table.Read(1, bbo));
+    REQUIRE(bbo.BidPrice == 0);
+    REQUIRE(bbo.AskPrice == 0);
+    REQUIRE(!table.Read(2, bbo));
+    REQUIRE(!table.Read(100, bbo));
+
+    market.AddOrder(Order::BuyLimit(1, 1, 10, 10));
+    market.AddOrder(Order::BuyLimit(2, 1, 10, 20));
+    market.AddOrder(Order::BuyLimit(3, 1, 9, 30));
+    market.AddOrder(Order::SellLimit(4, 1, 12, 40));
+    market.AddOrder(Order::SellLimit(5, 1, 13, 50, OrderTimeInForce::GTC, 10));
+    REQUIRE(table.Read(1, bbo));
+    REQUIRE(bbo.BidPrice == 10);
+    REQUIRE(bbo.BidVolume == 30);
+    REQUIRE(bbo.BidOrders == 2);
+    REQUIRE(bbo.AskPrice == 12);
+    REQUIRE(bbo.AskVolume == 40);
+    REQUIRE(bbo.AskOrders == 1);
+
+    // Sweep the best ask level and reach the iceberg
+    market.AddOrder(Order::BuyLimit(6, 1, 13, 45));
+    REQUIRE(table.Read(1, bbo));
+    REQUIRE(bbo.BidPrice == 10);
+    REQUIRE(bbo.BidVolume == 30);
+    REQUIRE(bbo.AskPrice == 13);
+    REQUIRE(bbo.AskVolume == 10);
+    REQUIRE(bbo.AskOrders == 1);
+
+    // Another process opens the same table
+    BBOTable reader("test_bbo_table", 16);
+    REQUIRE(reader.valid());
+    BBO other;
+    REQUIRE(reader.Read(1, other));
+    REQUIRE(other.BidPrice == bbo.BidPrice);
+    REQUIRE(other.AskPrice == bbo.AskPrice);
+    REQUIRE(other.AskVolume == bbo.AskVolume);
+
+    // Table with a different layout is not valid
+    BBOTable invalid("test_bbo_table", 8);
+    REQUIRE(!invalid.valid());
+    REQUIRE(!invalid.Read(1, other));
+
+    // Deleted order book is cleared
+    market.DeleteOrderBook(1);
+    REQUIRE(table.Read(1, bbo));
+    REQUIRE(bbo.BidPrice == 0);
+    REQUIRE(bbo.AskPrice == 0);
+}
+
+TEST_CASE("BBO table concurrent reads", "[TradingPlatform][Matching]")
+{
+    BBOTable table("test_bbo_table_concurrent", 4);
+    REQUIRE(table.valid());
+
+    MarketManager market;
+    market.AttachBBOTable(&table);
+    const char name[8] = "test";
+    market.AddSymbol(Symbol(0, name));
+    market.AddOrderBook(Symbol(0, name));
+
+    // Writer keeps the bid and ask volumes equal to the prices, so a torn read breaks it
+    std::atomic<bool> done(false);
+    std::atomic<size_t> reads(0);
+    std::atomic<size_t> errors(0);
+    std::thread thread([&]()
+    {
+        BBO bbo;
+        while (!done)
+        {
+            if (!table.Read(0, bbo))
+                continue;
+            if ((bbo.BidPrice != bbo.BidVolume) || (bbo.AskPrice != bbo.AskVolume))
+                ++errors;
+            ++reads;
+        }
+    });
+
+    for (uint64_t id = 1; id <= 100000; ++id)
+    {
+        uint64_t price = 100 + (id % 50);
+        market.AddOrder(Order::BuyLimit(2 * id, 0, price, price));
+        market.AddOrder(Order::SellLimit(2 * id + 1, 0, 1000 + price, 1000 + price));
+        market.DeleteOrder(2 * id);
+        market.DeleteOrder(2 * id + 1);
+    }
+
+    done = true;
+    thread.join();
+    REQUIRE(reads > 0);
+    REQUIRE(errors == 0);
+}
@@ -0,0 +1,232 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/l2ex/depth_feed.h"
+
+#include <vector>
+
+using namespace CppCommon;
+using namespace TradingPlatform::L2ex;
+using namespace TradingPlatform::Matching;
+
+namespace {
+
+// Decoded depth frame: snapshot ('F') or update ('L')
+struct Frame
+{
+    char Type;
+    DepthSnapshotMessage Snapshot;
+    DepthUpdateMessage Update;
+};
+
+// Records frames of published blocks
+class RecordingPublisher
+{
+public:
+    static const size_t FRAME_HEADER_SIZE = 2;
+
+    std::vector<Frame> frames;
+    size_t blocks = 0;
+    size_t message_size = 1024;
+
+    template <class TMessage>
+    static void serializeFrame(uint8_t* buffer, const TMessage& message)
+    {
+        buffer[0] = (uint8_t)(TMessage::SIZE >> 8);
+        buffer[1] = (uint8_t)(TMessage::SIZE & 0xFF);
+        message.serialize(buffer + FRAME_HEADER_SIZE, TMessage::SIZE);
+    }
+
+    size_t messageSize() const { return message_size; }
+
+    void publish(void* data, size_t size)
+    {
+        REQUIRE(size <= message_size);
+        ++blocks;
+
+        uint8_t* buffer = (uint8_t*)data;
+        size_t position = 0;
+        while (position < size)
+        {
+            size_t frame = ((size_t)buffer[position] << 8) | buffer[position + 1];
+            Frame record = {};
+            record.Type = (char)buffer[position + FRAME_HEADER_SIZE];
+            if (record.Type == 'F')
+                REQUIRE(record.Snapshot.deserialize(buffer + position + FRAME_HEADER_SIZE, frame));
+            else
+                REQUIRE(record.Update.deserialize(buffer + position + FRAME_HEADER_SIZE, frame));
+            frames.push_back(record);
+            position += FRAME_HEADER_SIZE + frame;
+        }
+        REQUIRE(position == size);
+    }
+
+    // Take recorded frames and start recording again
+    std::vector<Frame> take()
+    {
+        std::vector<Frame> result;
+        result.swap(frames);
+        return result;
+    }
+};
+
+typedef BasicDepthFeed<RecordingPublisher> TestDepthFeed;
+
+// Passes market events of every command into the depth feed
+class DepthHandler : public BatchMarketHandler
+{
+public:
+    TestDepthFeed* feed = nullptr;
+
+protected:
+    void onMarketEvents(const MarketEvent* events, size_t size) override
+    {
+        if (feed != nullptr)
+            feed->onMarketEvents(events, size);
+    }
+};
+
+void CheckUpdate(const Frame& frame, uint64_t sequence, char side, char action, uint64_t price, uint64_t volume, uint32_t orders)
+{
+    REQUIRE(frame.Type == 'L');
+    REQUIRE(frame.Update.SymbolId == 0);
+    REQUIRE(frame.Update.Sequence == sequence);
+    REQUIRE(frame.Update.Side == side);
+    REQUIRE(frame.Update.Action == action);
+    REQUIRE(frame.Update.Price == price);
+    REQUIRE(frame.Update.Volume == volume);
+    REQUIRE(frame.Update.Orders == orders);
+}
+
+}
+
+TEST_CASE("Depth feed", "[TradingPlatform][L2ex]")
+{
+    DepthHandler handler;
+    MarketManager market(handler);
+    RecordingPublisher publisher;
+
+    // Top two levels of each side are published after every command
+    DepthSettings settings;
+    settings.levels = 2;
+    settings.window = std::chrono::microseconds(0);
+    settings.refresh = std::chrono::milliseconds(0);
+    TestDepthFeed feed(market, &publisher, settings);
+    handler.feed = &feed;
+
+    const char name[8] = "test";
+    market.AddSymbol(Symbol(0, name));
+    market.AddOrderBook(Symbol(0, name));
+    market.EnableMatching();
+
+    // Empty order book snapshot
+    feed.refresh();
+    std::vector<Frame> frames = publisher.take();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].Type == 'F');
+    REQUIRE(frames[0].Snapshot.Sequence == 0);
+    REQUIRE(frames[0].Snapshot.BidLevels == 0);
+    REQUIRE(frames[0].Snapshot.AskLevels == 0);
+
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 101, 5));
+    frames = publisher.take();
+    REQUIRE(frames.size() == 2);
+    CheckUpdate(frames[0], 1, 'B', 'A', 100, 10, 1);
+    CheckUpdate(frames[1], 2, 'B', 'A', 101, 5, 1);
+
+    // The better level evicts the worst one from the top, the delete goes first
+    market.AddOrder(Order::BuyLimit(3, 0, 102, 7));
+    frames = publisher.take();
+    REQUIRE(frames.size() == 2);
+    CheckUpdate(frames[0], 3, 'B', 'D', 100, 0, 0);
+    CheckUpdate(frames[1], 4, 'B', 'A', 102, 7, 1);
+
+    // Levels outside of the top are not published
+    market.AddOrder(Order::BuyLimit(4, 0, 99, 1));
+    REQUIRE(publisher.take().empty());
+
+    market.AddOrder(Order::BuyLimit(5, 0, 101, 5));
+    frames = publisher.take();
+    REQUIRE(frames.size() == 1);
+    CheckUpdate(frames[0], 5, 'B', 'U', 101, 10, 2);
+
+    // The removed best level brings the next one back to the top
+    market.DeleteOrder(3);
+    frames = publisher.take();
+    REQUIRE(frames.size() == 2);
+    CheckUpdate(frames[0], 6, 'B', 'D', 102, 0, 0);
+    CheckUpdate(frames[1], 7, 'B', 'A', 100, 10, 1);
+
+    // Sequence is shared by both sides of the symbol
+    market.AddOrder(Order::SellLimit(6, 0, 110, 3));
+    frames = publisher.take();
+    REQUIRE(frames.size() == 1);
+    CheckUpdate(frames[0], 8, 'S', 'A', 110, 3, 1);
+
+    // Snapshot repeats the last sequence and lists best levels first
+    feed.refresh();
+    frames = publisher.take();
+    REQUIRE(frames.size() == 4);
+    REQUIRE(frames[0].Type == 'F');
+    REQUIRE(frames[0].Snapshot.Sequence == 8);
+    REQUIRE(frames[0].Snapshot.BidLevels == 2);
+    REQUIRE(frames[0].Snapshot.AskLevels == 1);
+    CheckUpdate(frames[1], 8, 'B', 'A', 101, 10, 2);
+    CheckUpdate(frames[2], 8, 'B', 'A', 100, 10, 1);
+    CheckUpdate(frames[3], 8, 'S', 'A', 110, 3, 1);
+
+    // Updates after the snapshot continue its sequence
+    market.AddOrder(Order::SellLimit(7, 0, 109, 4));
+    frames = publisher.take();
+    REQUIRE(frames.size() == 1);
+    CheckUpdate(frames[0], 9, 'S', 'A', 109, 4, 1);
+}
+
+TEST_CASE("Depth feed conflation", "[TradingPlatform][L2ex]")
+{
+    DepthHandler handler;
+    MarketManager market(handler);
+    RecordingPublisher publisher;
+    publisher.message_size = 100;
+
+    // Updates are published only on explicit flushes
+    DepthSettings settings;
+    settings.levels = 10;
+    settings.window = std::chrono::hours(1);
+    settings.refresh = std::chrono::milliseconds(0);
+    TestDepthFeed feed(market, &publisher, settings);
+    handler.feed = &feed;
+
+    const char name[8] = "test";
+    market.AddSymbol(Symbol(0, name));
+    market.AddOrderBook(Symbol(0, name));
+    market.EnableMatching();
+
+    // A burst of commands produces one update per level
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 100, 20));
+    market.AddOrder(Order::BuyLimit(3, 0, 99, 5));
+    market.AddOrder(Order::BuyLimit(4, 0, 98, 5));
+    market.AddOrder(Order::SellLimit(6, 0, 105, 5));
+    market.DeleteOrder(6);
+    REQUIRE(publisher.take().empty());
+    feed.flush();
+    std::vector<Frame> frames = publisher.take();
+    REQUIRE(frames.size() == 3);
+    CheckUpdate(frames[0], 1, 'B', 'A', 100, 30, 2);
+    CheckUpdate(frames[1], 2, 'B', 'A', 99, 5, 1);
+    CheckUpdate(frames[2], 3, 'B', 'A', 98, 5, 1);
+
+    // Frames are split into blocks which fit into one message
+    REQUIRE(publisher.blocks == 2);
+
+    // Restored levels produce no updates
+    market.AddOrder(Order::BuyLimit(7, 0, 100, 1));
+    market.DeleteOrder(7);
+    feed.flush();
+    REQUIRE(publisher.take().empty());
+}
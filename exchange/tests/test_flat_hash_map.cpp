@@ -0,0 +1,89 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/fast_hash.h"
+#include "trader/matching/flat_hash_map.h"
+
+#include <unordered_map>
+
+using namespace TradingPlatform::Matching;
+
+namespace {
+
+// Poor hash function which puts all keys into a few long probe sequences
+struct CollisionHash
+{
+    size_t operator()(uint64_t value) const noexcept { return ((value % 5) << 7) | (value & 0x7F); }
+};
+
+template <class THash>
+void Verify(size_t capacity, uint64_t keys)
+{
+    FlatHashMap<uint64_t, uint64_t, THash> hashmap(capacity);
+    std::unordered_map<uint64_t, uint64_t> reference;
+
+    uint64_t seed = 1;
+    auto random = [&seed](uint64_t range)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return (seed >> 33) % range;
+    };
+
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        uint64_t key = 1 + random(keys);
+        switch (random(4))
+        {
+            case 0:
+            case 1:
+            {
+                auto result = hashmap.insert(std::make_pair(key, i));
+                REQUIRE(result.second == reference.insert(std::make_pair(key, i)).second);
+                REQUIRE(result.first->first == key);
+                REQUIRE(result.first->second == reference[key]);
+                break;
+            }
+            case 2:
+            {
+                auto it = hashmap.find(key);
+                if (it != hashmap.end())
+                    hashmap.erase(it);
+                REQUIRE((it != hashmap.end()) == (reference.erase(key) > 0));
+                break;
+            }
+            default:
+            {
+                REQUIRE(hashmap.erase(key) == reference.erase(key));
+                break;
+            }
+        }
+        REQUIRE(hashmap.size() == reference.size());
+    }
+
+    // Check all items are still reachable after many erases
+    size_t count = 0;
+    for (auto& item : hashmap)
+    {
+        REQUIRE(reference.at(item.first) == item.second);
+        ++count;
+    }
+    REQUIRE(count == reference.size());
+    for (auto& item : reference)
+        REQUIRE(hashmap.find(item.first)->second == item.second);
+
+    hashmap.clear();
+    REQUIRE(hashmap.empty());
+    REQUIRE(hashmap.begin() == hashmap.end());
+}
+
+}
+
+TEST_CASE("Flat hash map", "[TradingPlatform][Matching]")
+{
+    Verify<FastHash>(16, 1000);
+    Verify<FastHash>(16384, 100000);
+    Verify<CollisionHash>(16, 300);
+}
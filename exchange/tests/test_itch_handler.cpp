@@ -8,6 +8,8 @@
 
 #include "filesystem/file.h"
 
+#include <cstring>
+
 using namespace CppCommon;
 using namespace TradingPlatform::ITCH;
 
@@ -78,3 +80,43 @@ TEST_CASE("ITCHHandler", "[TradingPlatform][Providers][NASDAQ]")
     REQUIRE(itch_handler.errors() == 0);
     REQUIRE(itch_handler.messages() == 1563071);
 }
+
+TEST_CASE("ITCH messages", "[TradingPlatform][Providers][NASDAQ]")
+{
+    // Serializers fill the whole wire size of the message
+    StockTradingActionMessage action = {};
+    action.Type = 'H';
+    action.Timestamp = 0x123456;
+    std::memcpy(action.Stock, "TEST    ", 8);
+    action.TradingState = 'T';
+    std::memcpy(action.Reason, "MWC1", 4);
+
+    uint8_t buffer[StockTradingActionMessage::SIZE];
+    std::memset(buffer, 0xFF, sizeof(buffer));
+    REQUIRE(action.serialize(buffer, sizeof(buffer)) == StockTradingActionMessage::SIZE);
+    REQUIRE(std::memcmp(buffer + 21, "MWC1", 4) == 0);
+    REQUIRE(buffer[8] == 0);
+
+    StockTradingActionMessage action_copy;
+    REQUIRE(action_copy.deserialize(buffer, sizeof(buffer)));
+    REQUIRE(action_copy.Timestamp == action.Timestamp);
+    REQUIRE(std::memcmp(action_copy.Reason, action.Reason, 4) == 0);
+
+    AddOrderMPIDMessage add = {};
+    add.Type = 'F';
+    add.OrderReferenceNumber = 42;
+    add.Shares = 100;
+    add.Price = 1000;
+    std::memcpy(add.Attribution, "NSDQ", 4);
+
+    uint8_t add_buffer[AddOrderMPIDMessage::SIZE];
+    std::memset(add_buffer, 0xFF, sizeof(add_buffer));
+    REQUIRE(add.serialize(add_buffer, sizeof(add_buffer)) == AddOrderMPIDMessage::SIZE);
+    REQUIRE(std::memcmp(add_buffer + 36, "NSDQ", 4) == 0);
+
+    AddOrderMPIDMessage add_copy;
+    REQUIRE(add_copy.deserialize(add_buffer, sizeof(add_buffer)));
+    REQUIRE(add_copy.OrderReferenceNumber == 42);
+    REQUIRE(add_copy.Price == 1000);
+    REQUIRE(std::memcmp(add_copy.Attribution, "NSDQ", 4) == 0);
+}
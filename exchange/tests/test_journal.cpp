@@ -0,0 +1,110 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "../aeron/journal.h"
+#include "trader/providers/nasdaq/ouch_handler.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace TradingPlatform::Aeron;
+using namespace TradingPlatform::OUCH;
+
+namespace {
+
+// Journal directory removed with all its files at the end of the test
+struct JournalDirectory
+{
+    std::string path;
+
+    JournalDirectory()
+    {
+        char name[] = "/tmp/journal-test-XXXXXX";
+        REQUIRE(::mkdtemp(name) != nullptr);
+        path = name;
+    }
+
+    ~JournalDirectory()
+    {
+        DIR* dir = ::opendir(path.c_str());
+        if (dir != nullptr)
+        {
+            while (struct dirent* entry = ::readdir(dir))
+                if (entry->d_name[0] != '.')
+                    ::unlink((path + "/" + entry->d_name).c_str());
+            ::closedir(dir);
+        }
+        ::rmdir(path.c_str());
+    }
+
+    std::string segment(size_t index) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/journal-%08zu.dat", index);
+        return path + name;
+    }
+};
+
+std::vector<uint64_t> Sequences(const Journal& journal)
+{
+    std::vector<uint64_t> sequences;
+    journal.replay([&sequences](const JournalRecord& record, uint8_t*) { sequences.push_back(record.sequence); });
+    return sequences;
+}
+
+}
+
+TEST_CASE("Journal restart", "[TradingPlatform][Aeron]")
+{
+    JournalDirectory directory;
+
+    JournalSettings settings;
+    settings.directory = directory.path;
+    settings.segmentSize = 0;
+    settings.fsync = JournalFsync::NEVER;
+
+    CancelOrderMessage message = {};
+    message.Type = 'X';
+
+    // Fill the first segment of one page and roll into the second one
+    uint64_t appended = 0;
+    {
+        Journal journal(settings);
+        REQUIRE(!journal.isFailed());
+        while (::access(directory.segment(1).c_str(), F_OK) != 0)
+        {
+            message.OrderToken = (uint32_t)appended;
+            REQUIRE(journal.append(message) == ++appended);
+        }
+    }
+
+    // The sequence continues after the last record of the last segment
+    {
+        Journal journal(settings);
+        REQUIRE(journal.sequence() == appended);
+    }
+
+    // The segment rolled just before a crash has no records
+    {
+        int file = ::open(directory.segment(2).c_str(), O_RDWR | O_CREAT, 0644);
+        REQUIRE(file >= 0);
+        ::close(file);
+    }
+
+    // The sequence continues after the newest record of older segments
+    {
+        Journal journal(settings);
+        REQUIRE(journal.sequence() == appended);
+        REQUIRE(journal.append(message) == appended + 1);
+    }
+
+    Journal journal(settings);
+    REQUIRE(journal.sequence() == appended + 1);
+    std::vector<uint64_t> sequences = Sequences(journal);
+    REQUIRE(sequences.size() == appended + 1);
+    for (size_t i = 0; i < sequences.size(); ++i)
+        REQUIRE(sequences[i] == i + 1);
+}
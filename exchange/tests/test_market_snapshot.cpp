@@ -0,0 +1,160 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_snapshot.h"
+
+#include <cstdio>
+#include <tuple>
+#include <vector>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+namespace {
+
+class ExecutionHandler : public MarketHandler
+{
+public:
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> executions;
+    size_t callbacks = 0;
+
+protected:
+    void onAddOrder(const Order& order) override { ++callbacks; }
+    void onExecuteOrder(const Order& order, uint64_t price, uint64_t quantity) override { executions.emplace_back(order.Id, price, quantity); }
+};
+
+// Random order flow with limit, iceberg, stop and trailing stop orders
+class OrderFlow
+{
+public:
+    explicit OrderFlow(uint64_t seed) : _seed(seed) {}
+
+    void Run(MarketManager& market, uint64_t from, uint64_t to)
+    {
+        for (uint64_t id = from; id < to; ++id)
+        {
+            uint32_t symbol = (uint32_t)Random(2);
+            uint64_t price = 900 + Random(200);
+            uint64_t quantity = 1 + Random(50);
+            switch (Random(10))
+            {
+                case 0:
+                    market.AddOrder(Order::BuyStop(id, symbol, price + 50, quantity));
+                    break;
+                case 1:
+                    market.AddOrder(Order::SellStopLimit(id, symbol, price - 50, price - 60, quantity));
+                    break;
+                case 2:
+                    // Trailing stop orders follow the market far enough to stay in the book
+                    market.AddOrder(Order::TrailingBuyStop(id, symbol, 0, quantity, 1000 + Random(100), 5));
+                    break;
+                case 3:
+                    market.AddOrder(Order::TrailingSellStopLimit(id, symbol, 0, 0, quantity, 1000 + Random(100), 5));
+                    break;
+                case 4:
+                {
+                    // Delete a random order if it is still in the market
+                    uint64_t order_id = 1 + Random(id);
+                    if (market.GetOrder(order_id) != nullptr)
+                        market.DeleteOrder(order_id);
+                    break;
+                }
+                case 5:
+                    market.AddOrder(Order::BuyLimit(id, symbol, price, quantity, OrderTimeInForce::GTC, quantity / 3));
+                    break;
+                default:
+                    market.AddOrder((Random(2) == 0) ? Order::BuyLimit(id, symbol, price - 20, quantity) : Order::SellLimit(id, symbol, price + 20, quantity));
+                    break;
+            }
+        }
+    }
+
+private:
+    uint64_t _seed;
+
+    uint64_t Random(uint64_t range)
+    {
+        _seed = _seed * 6364136223846793005ull + 1442695040888963407ull;
+        return (_seed >> 33) % range;
+    }
+};
+
+std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> BookLevels(const OrderBook* order_book_ptr, const LevelNode* level_ptr)
+{
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> levels;
+    for (; level_ptr != nullptr; level_ptr = order_book_ptr->GetNextLevel(level_ptr))
+        for (auto& order : level_ptr->OrderList)
+            levels.emplace_back(level_ptr->Price, order.Id, order.LeavesQuantity);
+    return levels;
+}
+
+}
+
+TEST_CASE("Market snapshot", "[TradingPlatform][Matching]")
+{
+    ExecutionHandler original_handler;
+    MarketManager original(original_handler);
+    const char name1[8] = "tree";
+    const char name2[8] = "ladder";
+    original.AddSymbol(Symbol(0, name1));
+    original.AddSymbol(Symbol(1, name2));
+    original.AddOrderBook(Symbol(0, name1));
+    original.AddOrderBook(Symbol(1, name2), 256, 1);
+    original.EnableMatching();
+
+    OrderFlow flow(1);
+    flow.Run(original, 1, 20000);
+    REQUIRE(original.orders().size() > 0);
+
+    // Save and restore the market
+    std::string path = "test_market_snapshot.bin";
+    REQUIRE(MarketSnapshot::Save(original, path, 12345));
+
+    ExecutionHandler restored_handler;
+    MarketManager restored(restored_handler);
+    uint64_t sequence = 0;
+    REQUIRE(MarketSnapshot::Load(restored, path, sequence));
+    std::remove(path.c_str());
+    REQUIRE(sequence == 12345);
+    REQUIRE(restored_handler.callbacks == 0);
+    REQUIRE(restored.IsMatchingEnabled());
+
+    // Restore into a non empty market is not allowed
+    REQUIRE(!MarketSnapshot::Load(restored, nullptr, 0, sequence));
+
+    // Check the restored state
+    REQUIRE(restored.orders().size() == original.orders().size());
+    for (auto& item : original.orders())
+    {
+        const Order* order_ptr = restored.GetOrder(item.first);
+        REQUIRE(order_ptr != nullptr);
+        REQUIRE(order_ptr->Type == item.second->Type);
+        REQUIRE(order_ptr->Price == item.second->Price);
+        REQUIRE(order_ptr->StopPrice == item.second->StopPrice);
+        REQUIRE(order_ptr->LeavesQuantity == item.second->LeavesQuantity);
+        REQUIRE(order_ptr->ExecutedQuantity == item.second->ExecutedQuantity);
+    }
+    for (uint32_t id = 0; id < 2; ++id)
+    {
+        const OrderBook* original_book_ptr = original.GetOrderBook(id);
+        const OrderBook* restored_book_ptr = restored.GetOrderBook(id);
+        REQUIRE(restored_book_ptr != nullptr);
+        REQUIRE(restored_book_ptr->bid_ladder().capacity() == original_book_ptr->bid_ladder().capacity());
+        REQUIRE(restored_book_ptr->size() == original_book_ptr->size());
+        REQUIRE(BookLevels(restored_book_ptr, restored_book_ptr->best_bid()) == BookLevels(original_book_ptr, original_book_ptr->best_bid()));
+        REQUIRE(BookLevels(restored_book_ptr, restored_book_ptr->best_ask()) == BookLevels(original_book_ptr, original_book_ptr->best_ask()));
+    }
+
+    // Both markets should behave the same way after restore
+    original_handler.executions.clear();
+    OrderFlow flow1(2);
+    OrderFlow flow2(2);
+    flow1.Run(original, 20000, 30000);
+    flow2.Run(restored, 20000, 30000);
+    REQUIRE(!original_handler.executions.empty());
+    REQUIRE(restored_handler.executions == original_handler.executions);
+    REQUIRE(restored.orders().size() == original.orders().size());
+}
@@ -326,11 +326,14 @@ TEST_CASE("Automatic matching - 'All-Or-None' limit order several levels full ma
     market.AddOrder(Order::BuyLimit(4, 0, 30, 10));
     REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(4, 0));
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(80, 0));
+    REQUIRE(market.GetOrderBook(0)->aon_bids() == 2);
 
     // Automatic matching 'All-Or-None' order
     market.AddOrder(Order::SellLimit(5, 0, 20, 80, OrderTimeInForce::AON));
     REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(market.GetOrderBook(0)->aon_bids() == 0);
+    REQUIRE(market.GetOrderBook(0)->aon_asks() == 0);
 }
 
 TEST_CASE("Automatic matching - 'All-Or-None' limit order several levels partial matching", "[TradingPlatform][Matching]")
@@ -358,11 +361,15 @@ TEST_CASE("Automatic matching - 'All-Or-None' limit order several levels partial
     market.AddOrder(Order::SellLimit(5, 0, 20, 100, OrderTimeInForce::AON));
     REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(4, 1));
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(80, 100));
+    REQUIRE(market.GetOrderBook(0)->aon_bids() == 2);
+    REQUIRE(market.GetOrderBook(0)->aon_asks() == 1);
 
     // Automatic matching 'All-Or-None' order
     market.AddOrder(Order::BuyLimit(6, 0, 20, 20, OrderTimeInForce::AON));
     REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(market.GetOrderBook(0)->aon_bids() == 0);
+    REQUIRE(market.GetOrderBook(0)->aon_asks() == 0);
 }
 
 TEST_CASE("Automatic matching - 'All-Or-None' limit order complex matching", "[TradingPlatform][Matching]")
@@ -394,6 +401,39 @@ TEST_CASE("Automatic matching - 'All-Or-None' limit order complex matching", "[T
     REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
 }
 
+TEST_CASE("Automatic matching - 'All-Or-None' order removed from the order book", "[TradingPlatform][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Add limit orders
+    market.AddOrder(Order::SellLimit(1, 0, 10, 30, OrderTimeInForce::AON));
+    market.AddOrder(Order::SellLimit(2, 0, 10, 10));
+    market.AddOrder(Order::SellLimit(3, 0, 20, 10));
+    REQUIRE(market.GetOrderBook(0)->aon_asks() == 1);
+
+    // Resting 'All-Or-None' order blocks smaller plain orders
+    market.AddOrder(Order::BuyLimit(4, 0, 20, 20));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 3));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(20, 50));
+
+    // Plain orders are matched as usual once the 'All-Or-None' order is deleted
+    market.DeleteOrder(4);
+    market.DeleteOrder(1);
+    REQUIRE(market.GetOrderBook(0)->aon_asks() == 0);
+    market.AddOrder(Order::BuyLimit(5, 0, 20, 20));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 0));
+}
+
 TEST_CASE("Automatic matching - 'Hidden' limit order", "[TradingPlatform][Matching]")
 {
     MarketManager market;
@@ -636,6 +676,114 @@ TEST_CASE("Automatic matching - trailing stop order", "[TradingPlatform][Matchin
     REQUIRE(market.GetOrder(5)->StopPrice == 190);
 }
 
+TEST_CASE("Automatic matching - trailing stop order activation", "[TradingPlatform][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Create the market with last prices
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 20));
+    market.AddOrder(Order::SellLimit(2, 0, 200, 20));
+    market.AddOrder(Order::SellMarket(3, 0, 10));
+    market.AddOrder(Order::BuyMarket(4, 0, 10));
+
+    // Add trailing sell stop order
+    market.AddOrder(Order::TrailingSellStop(5, 0, 0, 10, 10, 5));
+    REQUIRE(market.GetOrder(5)->StopPrice == 90);
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+
+    // Move the market bid price below the trailing stop price
+    market.AddOrder(Order::BuyLimit(6, 0, 80, 10));
+    market.AddOrder(Order::BuyLimit(7, 0, 70, 10));
+    market.AddOrder(Order::SellMarket(8, 0, 20));
+    REQUIRE(market.GetOrder(5) == nullptr);
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 10));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+}
+
+TEST_CASE("Automatic matching - stop orders cascade", "[TradingPlatform][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Add limit orders
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 10));
+    market.AddOrder(Order::BuyLimit(2, 0, 90, 10));
+    market.AddOrder(Order::BuyLimit(3, 0, 80, 10));
+    market.AddOrder(Order::BuyLimit(4, 0, 70, 10));
+    market.AddOrder(Order::BuyLimit(5, 0, 65, 10));
+    market.AddOrder(Order::SellLimit(6, 0, 200, 10));
+
+    // Add stop orders
+    market.AddOrder(Order::SellStop(7, 0, 95, 10));
+    market.AddOrder(Order::SellStop(8, 0, 85, 10));
+    market.AddOrder(Order::SellStopLimit(9, 0, 75, 60, 20));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 3));
+
+    // The last price of 100 does not reach stop prices
+    market.AddOrder(Order::SellMarket(10, 0, 10));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 3));
+
+    // Each activated stop order moves the market to the next stop price
+    market.AddOrder(Order::SellMarket(11, 0, 10));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 0));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(0, 2));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(0, 20));
+    REQUIRE(market.GetOrder(9)->LeavesQuantity == 10);
+}
+
+TEST_CASE("Automatic matching - crossed buy and sell stop orders", "[TradingPlatform][Matching]")
+{
+    MarketManager market;
+
+    // Prepare symbol & order book
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+
+    // Enable automatic matching
+    market.EnableMatching();
+
+    // Create the market with the last price of 990
+    market.AddOrder(Order::BuyLimit(1, 0, 990, 1));
+    market.AddOrder(Order::SellMarket(2, 0, 1));
+    market.AddOrder(Order::BuyLimit(3, 0, 900, 10));
+    market.AddOrder(Order::BuyLimit(4, 0, 1000, 1));
+    market.AddOrder(Order::BuyLimit(5, 0, 1010, 1));
+    market.AddOrder(Order::SellLimit(6, 0, 1051, 10));
+
+    // Add stop orders
+    market.AddOrder(Order::BuyStop(7, 0, 995, 10));
+    market.AddOrder(Order::SellStop(8, 0, 1005, 10));
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(1, 1));
+
+    // The last price of 1000 crosses both stop prices, but the activated buy stop order moves the market above the sell stop price
+    market.AddOrder(Order::SellLimit(9, 0, 1000, 2));
+    REQUIRE(market.GetOrder(7) == nullptr);
+    REQUIRE(market.GetOrder(8) != nullptr);
+    REQUIRE(BookStopOrders(market.GetOrderBook(0)) == std::make_pair(0, 1));
+    REQUIRE(BookOrders(market.GetOrderBook(0)) == std::make_pair(1, 0));
+    REQUIRE(BookVolume(market.GetOrderBook(0)) == std::make_pair(10, 0));
+}
+
 TEST_CASE("In-Flight Mitigation", "[TradingPlatform][Matching]")
 {
     MarketManager market;
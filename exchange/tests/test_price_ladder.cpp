@@ -0,0 +1,142 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_manager.h"
+
+#include <vector>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+namespace {
+
+std::vector<std::pair<uint64_t, uint64_t>> BookLevels(const OrderBook* order_book_ptr, const LevelNode* level_ptr)
+{
+    std::vector<std::pair<uint64_t, uint64_t>> levels;
+    for (; level_ptr != nullptr; level_ptr = order_book_ptr->GetNextLevel(level_ptr))
+        levels.emplace_back(level_ptr->Price, level_ptr->TotalVolume);
+    return levels;
+}
+
+}
+
+TEST_CASE("Price ladder", "[TradingPlatform][Matching]")
+{
+    PriceLadder ladder(100, 10);
+    REQUIRE(ladder.enabled());
+    REQUIRE(ladder.empty());
+    REQUIRE(ladder.capacity() == 128);
+    REQUIRE(!ladder.Contains(1000));
+
+    // Centre the ladder window
+    ladder.Recenter(1000);
+    REQUIRE(ladder.low() == 360);
+    REQUIRE(ladder.high() == 1640);
+    REQUIRE(ladder.Contains(1000));
+    REQUIRE(!ladder.Contains(1005));
+    REQUIRE(!ladder.Contains(350));
+    REQUIRE(!ladder.Contains(1640));
+
+    LevelNode level1(LevelType::BID, 400);
+    LevelNode level2(LevelType::BID, 1000);
+    LevelNode level3(LevelType::BID, 1630);
+    ladder.Insert(&level1);
+    ladder.Insert(&level2);
+    ladder.Insert(&level3);
+    REQUIRE(ladder.size() == 3);
+    REQUIRE(ladder.Find(1000) == &level2);
+    REQUIRE(ladder.Find(1010) == nullptr);
+    REQUIRE(ladder.Lowest() == &level1);
+    REQUIRE(ladder.Highest() == &level3);
+    REQUIRE(ladder.Lower(1000) == &level1);
+    REQUIRE(ladder.Lower(1005) == &level2);
+    REQUIRE(ladder.Lower(400) == nullptr);
+    REQUIRE(ladder.Lower(5000) == &level3);
+    REQUIRE(ladder.Higher(1000) == &level3);
+    REQUIRE(ladder.Higher(0) == &level1);
+    REQUIRE(ladder.Higher(1630) == nullptr);
+
+    ladder.Erase(&level2);
+    REQUIRE(ladder.size() == 2);
+    REQUIRE(ladder.Find(1000) == nullptr);
+    REQUIRE(ladder.Lower(1630) == &level1);
+    REQUIRE(ladder.Higher(400) == &level3);
+}
+
+TEST_CASE("Price ladder order book", "[TradingPlatform][Matching]")
+{
+    // Reference market uses price level trees only, the other one uses a small price ladder
+    // with ticks of 10 so some prices fall outside the window or between ticks
+    MarketManager tree_market;
+    MarketManager ladder_market;
+
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    tree_market.AddSymbol(symbol);
+    tree_market.AddOrderBook(symbol);
+    tree_market.EnableMatching();
+    ladder_market.AddSymbol(symbol);
+    ladder_market.AddOrderBook(symbol, 64, 10);
+    ladder_market.EnableMatching();
+
+    uint64_t seed = 1;
+    auto random = [&seed](uint64_t range)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return (seed >> 33) % range;
+    };
+
+    std::vector<uint64_t> ids;
+    for (uint64_t id = 1; id <= 20000; ++id)
+    {
+        if (!ids.empty() && (random(3) == 0))
+        {
+            // Delete a random order if it was not filled yet
+            size_t index = (size_t)random(ids.size());
+            REQUIRE((tree_market.GetOrder(ids[index]) == nullptr) == (ladder_market.GetOrder(ids[index]) == nullptr));
+            if (ladder_market.GetOrder(ids[index]) != nullptr)
+            {
+                tree_market.DeleteOrder(ids[index]);
+                ladder_market.DeleteOrder(ids[index]);
+            }
+            ids[index] = ids.back();
+            ids.pop_back();
+        }
+        else
+        {
+            // Add a limit order around the slowly moving mid price
+            uint64_t mid = 5000 + (id / 100) * 10;
+            uint64_t price = mid - 1000 + random(2000);
+            if (random(4) != 0)
+                price -= price % 10;
+            Order order = (random(2) == 0) ? Order::BuyLimit(id, 0, price - 500, 1 + random(100)) : Order::SellLimit(id, 0, price + 500, 1 + random(100));
+            tree_market.AddOrder(order);
+            ladder_market.AddOrder(order);
+            if (ladder_market.GetOrder(id) != nullptr)
+                ids.push_back(id);
+        }
+
+        const OrderBook* tree_book_ptr = tree_market.GetOrderBook(0);
+        const OrderBook* ladder_book_ptr = ladder_market.GetOrderBook(0);
+        REQUIRE(tree_book_ptr->bid_levels() == ladder_book_ptr->bid_levels());
+        REQUIRE(tree_book_ptr->ask_levels() == ladder_book_ptr->ask_levels());
+        REQUIRE(((tree_book_ptr->best_bid() == nullptr) ? 0 : tree_book_ptr->best_bid()->Price) == ((ladder_book_ptr->best_bid() == nullptr) ? 0 : ladder_book_ptr->best_bid()->Price));
+        REQUIRE(((tree_book_ptr->best_ask() == nullptr) ? 0 : tree_book_ptr->best_ask()->Price) == ((ladder_book_ptr->best_ask() == nullptr) ? 0 : ladder_book_ptr->best_ask()->Price));
+        if ((id % 100) == 0)
+        {
+            REQUIRE(BookLevels(tree_book_ptr, tree_book_ptr->best_bid()) == BookLevels(ladder_book_ptr, ladder_book_ptr->best_bid()));
+            REQUIRE(BookLevels(tree_book_ptr, tree_book_ptr->best_ask()) == BookLevels(ladder_book_ptr, ladder_book_ptr->best_ask()));
+            for (uint64_t price = 3000; price < 8000; ++price)
+            {
+                REQUIRE((tree_book_ptr->GetBid(price) == nullptr) == (ladder_book_ptr->GetBid(price) == nullptr));
+                REQUIRE((tree_book_ptr->GetAsk(price) == nullptr) == (ladder_book_ptr->GetAsk(price) == nullptr));
+            }
+        }
+    }
+
+    REQUIRE(ladder_market.GetOrderBook(0)->bid_ladder().size() > 0);
+    REQUIRE(ladder_market.GetOrderBook(0)->bids().size() > 0);
+}
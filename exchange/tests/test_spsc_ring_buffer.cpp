@@ -0,0 +1,122 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "../aeron/spsc_ring_buffer.h"
+
+#include <vector>
+
+using namespace TradingPlatform::Aeron;
+
+namespace {
+
+// Frames sent by the consumer or claimed directly by the producer while the ring is empty, like the publisher does
+class Sender
+{
+public:
+    std::vector<uint8_t> sent;
+
+    explicit Sender(SPSCRingBuffer& ring) : _ring(ring) {}
+
+    // Producer: claim the frame directly if nothing is buffered, buffer it otherwise
+    void publish(uint8_t id)
+    {
+        const uint8_t frame[3] = { 0, 1, id };
+        if (_ring.empty())
+            sent.push_back(id);
+        else
+            REQUIRE(_ring.push(frame, sizeof(frame)));
+    }
+
+    // Consumer: join the frame split by the end of the buffer lap, release it only after it is sent
+    void stitch()
+    {
+        const uint8_t* data = nullptr;
+        size_t size = _ring.read(data);
+        REQUIRE(size > 0);
+        REQUIRE(_ring.boundary(size));
+        std::vector<uint8_t> frame(data, data + size);
+
+        const size_t skipped = _ring.lap();
+        const size_t frameSize = 2 + (size_t)frame[1];
+        size_t joined = 0;
+        while (frame.size() < frameSize)
+        {
+            size_t read = _ring.read(data, frameSize - frame.size(), skipped + joined);
+            REQUIRE(read > 0);
+            frame.insert(frame.end(), data, data + read);
+            joined += read;
+        }
+        REQUIRE(!_ring.empty());
+
+        sent.push_back(frame.back());
+        _ring.release(skipped + joined);
+    }
+
+    // Consumer: send whole buffered frames
+    void drain()
+    {
+        const uint8_t* data = nullptr;
+        size_t size;
+        while ((size = _ring.read(data)) > 0)
+        {
+            for (size_t position = 0; position < size; position += 2 + data[position + 1])
+                sent.push_back(data[position + 2 + data[position + 1] - 1]);
+            _ring.release(size);
+        }
+    }
+
+private:
+    SPSCRingBuffer& _ring;
+};
+
+}
+
+TEST_CASE("SPSC ring buffer frame split by the end of the buffer lap", "[TradingPlatform][Aeron]")
+{
+    SPSCRingBuffer ring(16);
+    Sender sender(ring);
+
+    // Move the ring position close to the end of the buffer lap
+    const uint8_t padding[10] = { 0, 8 };
+    REQUIRE(ring.push(padding, sizeof(padding)));
+    sender.drain();
+    sender.sent.clear();
+
+    // Frame 1 is written in two parts: 6 bytes up to the end of the lap and 4 bytes at its beginning
+    const uint8_t frame[10] = { 0, 8, 0, 0, 0, 0, 0, 0, 0, 1 };
+    REQUIRE(ring.push(frame, 6));
+    REQUIRE(ring.push(frame + 6, 4));
+
+    // Joined frame is not released yet, so the next frame is buffered after it instead of being claimed
+    sender.stitch();
+    sender.publish(2);
+    sender.drain();
+    sender.publish(3);
+    REQUIRE(sender.sent == std::vector<uint8_t>({ 1, 2, 3 }));
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("SPSC ring buffer frame split by the skipped tail of the buffer", "[TradingPlatform][Aeron]")
+{
+    SPSCRingBuffer ring(16);
+    Sender sender(ring);
+
+    const uint8_t padding[10] = { 0, 8 };
+    REQUIRE(ring.push(padding, sizeof(padding)));
+    sender.drain();
+    sender.sent.clear();
+
+    // The second part of frame 1 does not fit into the rest of the lap, so the last 2 bytes are skipped
+    const uint8_t frame[8] = { 0, 6, 0, 0, 0, 0, 0, 1 };
+    REQUIRE(ring.push(frame, 4));
+    REQUIRE(ring.push(frame + 4, 4));
+
+    sender.stitch();
+    sender.publish(2);
+    sender.drain();
+    REQUIRE(sender.sent == std::vector<uint8_t>({ 1, 2 }));
+    REQUIRE(ring.empty());
+}
@@ -0,0 +1,59 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/l2ex/timestamp.h"
+
+#include <chrono>
+#include <ctime>
+
+using namespace TradingPlatform::L2ex;
+
+namespace {
+
+// Reference implementation with the local time conversion of every call
+uint64_t ReferenceSinceMidnight()
+{
+    auto now = std::chrono::system_clock::now();
+    time_t tnow = std::chrono::system_clock::to_time_t(now);
+    struct tm date;
+    localtime_r(&tnow, &date);
+    date.tm_hour = 0;
+    date.tm_min = 0;
+    date.tm_sec = 0;
+    date.tm_isdst = -1;
+    auto midnight = std::chrono::system_clock::from_time_t(std::mktime(&date));
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now - midnight).count();
+}
+
+}
+
+TEST_CASE("Timestamp since midnight", "[TradingPlatform][L2ex]")
+{
+    const uint64_t day = 24ull * 60 * 60 * 1000000000;
+
+    for (auto source : { TimestampSource::REALTIME, TimestampSource::REALTIME_COARSE, TimestampSource::TSC })
+    {
+        Timestamp::setSource(source);
+
+        uint64_t last = Timestamp::nanosecondsSinceMidnight();
+        for (int i = 0; i < 100000; ++i)
+        {
+            uint64_t timestamp = Timestamp::nanosecondsSinceMidnight();
+            // Allow timestamps to restart only on the day rollover
+            REQUIRE(((timestamp >= last) || (last - timestamp > day / 2)));
+            REQUIRE(timestamp < day + 3600ull * 1000000000);
+            last = timestamp;
+        }
+
+        // Cached midnight should match the reference one within the coarse clock resolution
+        uint64_t reference = ReferenceSinceMidnight();
+        uint64_t timestamp = Timestamp::nanosecondsSinceMidnight();
+        uint64_t difference = (timestamp > reference) ? (timestamp - reference) : (reference - timestamp);
+        REQUIRE(((difference < 100000000) || (difference > day / 2)));
+    }
+
+    Timestamp::setSource(TimestampSource::REALTIME);
+}
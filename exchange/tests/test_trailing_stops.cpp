@@ -0,0 +1,359 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_snapshot.h"
+
+#include <cstdio>
+#include <map>
+#include <vector>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+namespace {
+
+// Keep the last stop price of trailing stop orders notified by the market manager
+class TrailingStopHandler : public MarketHandler
+{
+public:
+    std::map<uint64_t, uint64_t> stop_prices;
+    std::vector<uint64_t> activated;
+    size_t updates = 0;
+
+protected:
+    void onAddOrder(const Order& order) override
+    {
+        if (order.IsTrailingStop() || order.IsTrailingStopLimit())
+            stop_prices[order.Id] = order.StopPrice;
+    }
+    void onUpdateOrder(const Order& order) override
+    {
+        if (order.IsTrailingStop() || order.IsTrailingStopLimit())
+        {
+            stop_prices[order.Id] = order.StopPrice;
+            ++updates;
+        }
+        else if (stop_prices.erase(order.Id) > 0)
+            activated.push_back(order.Id);
+    }
+    void onDeleteOrder(const Order& order) override { stop_prices.erase(order.Id); }
+};
+
+void CheckTrailingStops(const TrailingStops& trailing_stops, const TrailingStopHandler& handler)
+{
+    const LevelNode* best_ptr = nullptr;
+    for (auto& level : trailing_stops)
+    {
+        if ((best_ptr == nullptr) || (level.IsAsk() ? (level.Price < best_ptr->Price) : (level.Price > best_ptr->Price)))
+            best_ptr = &level;
+
+        // Stop prices of all orders are updated and notified at the end of the command
+        for (auto& order : level.OrderList)
+        {
+            REQUIRE(order.StopPrice == level.Price);
+            REQUIRE(handler.stop_prices.at(order.Id) == order.StopPrice);
+        }
+    }
+    // Best price levels of different buckets could have the same price
+    REQUIRE((trailing_stops.best() == nullptr) == (best_ptr == nullptr));
+    if (best_ptr != nullptr)
+        REQUIRE(trailing_stops.best()->Price == best_ptr->Price);
+}
+
+}
+
+TEST_CASE("Trailing stops", "[TradingPlatform][Matching]")
+{
+    TrailingStops trailing_stops(LevelType::BID);
+    REQUIRE(trailing_stops.empty());
+    REQUIRE(trailing_stops.best() == nullptr);
+    REQUIRE(trailing_stops.begin() == trailing_stops.end());
+
+    TrailingStopBucket absolute(10, 0);
+    TrailingStopBucket percentage(-100, 0);
+    trailing_stops.InsertBucket(&absolute);
+    trailing_stops.InsertBucket(&percentage);
+    REQUIRE(trailing_stops.GetBucket(10, 0) == &absolute);
+    REQUIRE(trailing_stops.GetBucket(-100, 0) == &percentage);
+    REQUIRE(trailing_stops.GetBucket(10, 5) == nullptr);
+    REQUIRE(trailing_stops.begin() == trailing_stops.end());
+
+    LevelNode level80(LevelType::BID, 80);
+    LevelNode level90(LevelType::BID, 90);
+    LevelNode level95(LevelType::BID, 95);
+    trailing_stops.InsertLevel(&absolute, &level80);
+    trailing_stops.InsertLevel(&absolute, &level90);
+    trailing_stops.InsertLevel(&percentage, &level95);
+    REQUIRE(trailing_stops.size() == 3);
+    REQUIRE(level80.Bucket == &absolute);
+    REQUIRE(absolute.Best == &level90);
+    REQUIRE(trailing_stops.best() == &level95);
+    REQUIRE(trailing_stops.GetLevel(&absolute, 90) == &level90);
+    REQUIRE(trailing_stops.GetLevel(&percentage, 90) == nullptr);
+    REQUIRE(trailing_stops.GetWorstLevel(&absolute) == &level80);
+
+    std::vector<uint64_t> prices;
+    for (auto& level : trailing_stops)
+        prices.push_back(level.Price);
+    REQUIRE(prices == std::vector<uint64_t>({ 80, 90, 95 }));
+
+    // The best price level of all buckets moves to another bucket
+    trailing_stops.EraseLevel(&level95);
+    REQUIRE(percentage.Best == nullptr);
+    REQUIRE(trailing_stops.best() == &level90);
+    trailing_stops.EraseBucket(&percentage);
+
+    absolute.Moved.push_back(&level90);
+    trailing_stops.EraseLevel(&level90);
+    REQUIRE(absolute.Moved.empty());
+    REQUIRE(absolute.Best == &level80);
+    REQUIRE(trailing_stops.best() == &level80);
+
+    trailing_stops.EraseLevel(&level80);
+    trailing_stops.EraseBucket(&absolute);
+    REQUIRE(trailing_stops.empty());
+    REQUIRE(trailing_stops.best() == nullptr);
+    REQUIRE(trailing_stops.buckets().empty());
+}
+
+TEST_CASE("Trailing stops order book", "[TradingPlatform][Matching]")
+{
+    TrailingStopHandler handler;
+    MarketManager market(handler);
+
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.EnableMatching();
+
+    // Create the market with last prices
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 20));
+    market.AddOrder(Order::SellLimit(2, 0, 200, 20));
+    market.AddOrder(Order::SellMarket(3, 0, 10));
+    market.AddOrder(Order::BuyMarket(4, 0, 10));
+
+    // Trailing sell stop orders with absolute and percentage distance
+    for (uint64_t id = 100; id < 200; ++id)
+    {
+        market.AddOrder(Order::TrailingSellStop(id, 0, 0, 1, 10));
+        market.AddOrder(Order::TrailingSellStopLimit(id + 100, 0, 0, 10, 1, -1000));
+    }
+    const OrderBook* order_book_ptr = market.GetOrderBook(0);
+    REQUIRE(order_book_ptr->trailing_sell_stop().buckets().size() == 2);
+    REQUIRE(order_book_ptr->trailing_sell_stop().size() == 2);
+    REQUIRE(market.GetOrder(100)->StopPrice == 90);
+    REQUIRE(market.GetOrder(200)->StopPrice == 90);
+    REQUIRE(market.GetOrder(200)->Price == 100);
+    CheckTrailingStops(order_book_ptr->trailing_sell_stop(), handler);
+
+    // Each moved order is notified once
+    handler.updates = 0;
+    market.ModifyOrder(1, 120, 20);
+    REQUIRE(handler.updates == 200);
+    REQUIRE(market.GetOrder(150)->StopPrice == 110);
+    REQUIRE(market.GetOrder(250)->StopPrice == 108);
+    REQUIRE(market.GetOrder(250)->Price == 118);
+    REQUIRE(order_book_ptr->trailing_sell_stop().size() == 2);
+    CheckTrailingStops(order_book_ptr->trailing_sell_stop(), handler);
+
+    // The market goes back, trailing stop orders stay
+    handler.updates = 0;
+    market.ModifyOrder(1, 110, 20);
+    REQUIRE(handler.updates == 0);
+    REQUIRE(market.GetOrder(150)->StopPrice == 110);
+
+    // New orders of the same bucket join moved price levels
+    market.AddOrder(Order::TrailingSellStop(300, 0, 0, 1, 10));
+    market.AddOrder(Order::TrailingSellStop(301, 0, 0, 1, 10, 5));
+    REQUIRE(market.GetOrder(300)->StopPrice == 100);
+    REQUIRE(market.GetOrder(301)->StopPrice == 100);
+    REQUIRE(order_book_ptr->trailing_sell_stop().buckets().size() == 3);
+    REQUIRE(order_book_ptr->trailing_sell_stop().size() == 4);
+    market.ModifyOrder(1, 130, 20);
+    REQUIRE(market.GetOrder(150)->StopPrice == 120);
+    REQUIRE(market.GetOrder(250)->StopPrice == 117);
+    REQUIRE(market.GetOrder(300)->StopPrice == 120);
+    REQUIRE(market.GetOrder(301)->StopPrice == 120);
+    REQUIRE(order_book_ptr->trailing_sell_stop().size() == 3);
+    CheckTrailingStops(order_book_ptr->trailing_sell_stop(), handler);
+
+    // Activate all trailing stop orders
+    market.AddOrder(Order::BuyLimit(5, 0, 115, 1000));
+    market.AddOrder(Order::SellMarket(6, 0, 20));
+    REQUIRE(order_book_ptr->trailing_sell_stop().size() == 3);
+    market.AddOrder(Order::SellMarket(7, 0, 1));
+    REQUIRE(order_book_ptr->trailing_sell_stop().empty());
+    REQUIRE(order_book_ptr->trailing_sell_stop().buckets().empty());
+    REQUIRE(order_book_ptr->best_bid()->TotalVolume == 1000 - 1 - 100 - 2);
+    REQUIRE(order_book_ptr->best_bid()->Orders == 1);
+
+    // Activated trailing sell stop-limit orders keep the distance to their stop price
+    REQUIRE(order_book_ptr->best_ask()->Price == 127);
+    REQUIRE(order_book_ptr->best_ask()->TotalVolume == 100);
+}
+
+TEST_CASE("Trailing stops throttle", "[TradingPlatform][Matching]")
+{
+    TrailingStopHandler handler;
+    MarketManager market(handler);
+    market.SetTrailingStopThrottle(4);
+    REQUIRE(market.trailing_stop_throttle() == 4);
+
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.EnableMatching();
+
+    market.AddOrder(Order::BuyLimit(1, 0, 100, 20));
+    market.AddOrder(Order::SellLimit(2, 0, 200, 20));
+    market.AddOrder(Order::SellMarket(3, 0, 10));
+    market.AddOrder(Order::BuyMarket(4, 0, 10));
+    for (uint64_t id = 100; id < 200; ++id)
+        market.AddOrder(Order::TrailingSellStop(id, 0, 0, 1, 10));
+    REQUIRE(market.GetOrder(150)->StopPrice == 90);
+
+    // Moved orders keep previous stop prices until the fourth command
+    market.ModifyOrder(1, 110, 20);
+    market.ModifyOrder(1, 120, 20);
+    REQUIRE(handler.updates == 0);
+    REQUIRE(market.GetOrder(150)->StopPrice == 90);
+
+    // Deleted and saved orders are updated from their price level
+    market.DeleteOrder(100);
+    std::string path = "test_trailing_stops.bin";
+    REQUIRE(MarketSnapshot::Save(market, path));
+    MarketManager restored;
+    uint64_t sequence = 0;
+    REQUIRE(MarketSnapshot::Load(restored, path, sequence));
+    std::remove(path.c_str());
+    REQUIRE(restored.GetOrder(150)->StopPrice == 110);
+
+    // Each moved order is notified once with its last stop price
+    market.ModifyOrder(1, 125, 20);
+    REQUIRE(handler.updates == 99);
+    REQUIRE(market.GetOrder(150)->StopPrice == 115);
+    CheckTrailingStops(market.GetOrderBook(0)->trailing_sell_stop(), handler);
+}
+
+TEST_CASE("Trailing stops activation order", "[TradingPlatform][Matching]")
+{
+    TrailingStopHandler handler;
+    MarketManager market(handler);
+
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.EnableMatching();
+
+    market.AddOrder(Order::BuyLimit(1, 0, 110, 100));
+    market.AddOrder(Order::SellLimit(2, 0, 200, 20));
+    market.AddOrder(Order::SellMarket(3, 0, 1));
+    market.AddOrder(Order::BuyMarket(4, 0, 1));
+
+    // Price levels of the same bucket added while the market goes down
+    std::vector<uint64_t> expected;
+    auto add = [&](uint64_t first, uint64_t count, uint64_t stop_price)
+    {
+        for (uint64_t id = first; id < first + count; ++id)
+        {
+            market.AddOrder(Order::TrailingSellStop(id, 0, 0, 1, 10, 5));
+            REQUIRE(market.GetOrder(id)->StopPrice == stop_price);
+            expected.push_back(id);
+        }
+    };
+    add(10, 8, 100);
+    market.ModifyOrder(1, 104, 100);
+    add(20, 2, 94);
+    market.ModifyOrder(1, 102, 100);
+    add(30, 4, 92);
+    market.ModifyOrder(1, 101, 100);
+    add(40, 3, 91);
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().size() == 4);
+
+    // Moved price levels are merged into the existing one of the new stop price
+    market.ModifyOrder(1, 110, 100);
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().size() == 1);
+    CheckTrailingStops(market.GetOrderBook(0)->trailing_sell_stop(), handler);
+
+    // Orders of the existing price level are activated first, then orders of moved price levels from the best one
+    market.AddOrder(Order::BuyLimit(5, 0, 90, 1000));
+    market.AddOrder(Order::SellMarket(6, 0, 101));
+    REQUIRE(market.GetOrderBook(0)->trailing_sell_stop().empty());
+    REQUIRE(handler.activated == expected);
+}
+
+TEST_CASE("Trailing stops random order flow", "[TradingPlatform][Matching]")
+{
+    TrailingStopHandler handler;
+    MarketManager market(handler);
+
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    market.AddSymbol(symbol);
+    market.AddOrderBook(symbol);
+    market.EnableMatching();
+
+    uint64_t seed = 1;
+    auto random = [&seed](uint64_t range)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return (seed >> 33) % range;
+    };
+
+    const int64_t distances[] = { 5, 20, -100, -500 };
+
+    std::vector<uint64_t> ids;
+    for (uint64_t id = 1; id <= 20000; ++id)
+    {
+        uint64_t price = 1000 + random(100);
+        switch (random(8))
+        {
+            case 0:
+            {
+                // Delete a random order if it was not filled or activated yet
+                if (!ids.empty())
+                {
+                    size_t index = (size_t)random(ids.size());
+                    if (market.GetOrder(ids[index]) != nullptr)
+                        market.DeleteOrder(ids[index]);
+                    ids[index] = ids.back();
+                    ids.pop_back();
+                }
+                break;
+            }
+            case 1:
+            {
+                int64_t distance = distances[random(4)];
+                int64_t step = (random(2) == 0) ? 0 : ((distance > 0) ? 3 : -30);
+                if (random(2) == 0)
+                    market.AddOrder(Order::TrailingBuyStop(id, 0, std::numeric_limits<uint64_t>::max(), 1 + random(10), distance, step));
+                else
+                    market.AddOrder(Order::TrailingSellStopLimit(id, 0, 0, 10, 1 + random(10), distance, step));
+                ids.push_back(id);
+                break;
+            }
+            default:
+            {
+                // Limit orders move the market around the middle price
+                if (random(2) == 0)
+                    market.AddOrder(Order::BuyLimit(id, 0, price - 10, 1 + random(20)));
+                else
+                    market.AddOrder(Order::SellLimit(id, 0, price + 10, 1 + random(20)));
+                ids.push_back(id);
+                break;
+            }
+        }
+
+        const OrderBook* order_book_ptr = market.GetOrderBook(0);
+        CheckTrailingStops(order_book_ptr->trailing_buy_stop(), handler);
+        CheckTrailingStops(order_book_ptr->trailing_sell_stop(), handler);
+    }
+
+    REQUIRE(handler.updates > 0);
+}
@@ -0,0 +1,210 @@
+//
+// Created by Igor Sokolov on 17.10.2026
+//
+
+#include "test.h"
+
+#include "trader/matching/market_manager.h"
+
+#include <vector>
+
+using namespace CppCommon;
+using namespace TradingPlatform::Matching;
+
+namespace {
+
+// Aggregate the volume by walking price levels from the best one
+VolumeIndex::Volume WalkVolume(const OrderBook* order_book_ptr, const LevelNode* level_ptr, uint64_t price)
+{
+    VolumeIndex::Volume volume = { 0, 0, 0 };
+    for (; level_ptr != nullptr; level_ptr = order_book_ptr->GetNextLevel(level_ptr))
+    {
+        if (level_ptr->IsBid() ? (level_ptr->Price < price) : (level_ptr->Price > price))
+            break;
+        volume.TotalVolume += level_ptr->TotalVolume;
+        volume.VisibleVolume += level_ptr->VisibleVolume;
+        volume.AONVolume += level_ptr->AONVolume;
+    }
+    return volume;
+}
+
+// Find the price level which completes the volume by walking price levels from the best one
+const LevelNode* WalkLevel(const OrderBook* order_book_ptr, const LevelNode* level_ptr, uint64_t volume)
+{
+    for (; (level_ptr != nullptr) && (volume > 0); level_ptr = order_book_ptr->GetNextLevel(level_ptr))
+    {
+        if (volume <= level_ptr->TotalVolume)
+            return level_ptr;
+        volume -= level_ptr->TotalVolume;
+    }
+    return nullptr;
+}
+
+void CheckVolume(const OrderBook* order_book_ptr, OrderSide side, uint64_t price)
+{
+    const LevelNode* best_ptr = (side == OrderSide::BUY) ? order_book_ptr->best_ask() : order_book_ptr->best_bid();
+    VolumeIndex::Volume expected = WalkVolume(order_book_ptr, best_ptr, price);
+    VolumeIndex::Volume volume = order_book_ptr->VolumeToPrice(side, price);
+    REQUIRE(volume.TotalVolume == expected.TotalVolume);
+    REQUIRE(volume.VisibleVolume == expected.VisibleVolume);
+    REQUIRE(volume.AONVolume == expected.AONVolume);
+}
+
+}
+
+TEST_CASE("Volume index", "[TradingPlatform][Matching]")
+{
+    VolumeIndex index(LevelType::ASK);
+    REQUIRE(index.empty());
+    REQUIRE(index.PriceForVolume(10) == nullptr);
+
+    std::vector<LevelNode> levels;
+    levels.reserve(100);
+    for (uint64_t price = 100; price > 0; --price)
+    {
+        levels.emplace_back(LevelType::ASK, price);
+        levels.back().TotalVolume = price;
+        levels.back().VisibleVolume = price / 2;
+        levels.back().AONVolume = ((price % 10) == 0) ? price : 0;
+        index.Insert(&levels.back());
+    }
+    REQUIRE(index.size() == 100);
+    REQUIRE(index.volume().TotalVolume == 5050);
+
+    // Prices 1..10
+    VolumeIndex::Volume volume = index.VolumeToPrice(10);
+    REQUIRE(volume.TotalVolume == 55);
+    REQUIRE(volume.VisibleVolume == 25);
+    REQUIRE(volume.AONVolume == 10);
+    REQUIRE(index.VolumeToPrice(0).TotalVolume == 0);
+    REQUIRE(index.VolumeToPrice(1000).TotalVolume == 5050);
+
+    REQUIRE(index.PriceForVolume(1)->Price == 1);
+    REQUIRE(index.PriceForVolume(55)->Price == 10);
+    REQUIRE(index.PriceForVolume(56)->Price == 11);
+    REQUIRE(index.PriceForVolume(5050)->Price == 100);
+    REQUIRE(index.PriceForVolume(5051) == nullptr);
+
+    // Volume changes of indexed price levels
+    LevelNode& level5 = levels[95];
+    REQUIRE(level5.Price == 5);
+    level5.TotalVolume += 100;
+    index.Add(&level5, 100, 0, 0);
+    REQUIRE(index.VolumeToPrice(10).TotalVolume == 155);
+    REQUIRE(index.PriceForVolume(16)->Price == 5);
+    REQUIRE(index.PriceForVolume(115)->Price == 5);
+    REQUIRE(index.PriceForVolume(116)->Price == 6);
+    level5.TotalVolume -= 100;
+    index.Subtract(&level5, 100, 0, 0);
+
+    // Erase every other price level
+    for (size_t i = 0; i < levels.size(); i += 2)
+        index.Erase(&levels[i]);
+    REQUIRE(index.size() == 50);
+    REQUIRE(index.VolumeToPrice(10).TotalVolume == 1 + 3 + 5 + 7 + 9);
+    REQUIRE(index.VolumeToPrice(10).AONVolume == 0);
+    REQUIRE(index.PriceForVolume(4)->Price == 3);
+
+    for (size_t i = 1; i < levels.size(); i += 2)
+        index.Erase(&levels[i]);
+    REQUIRE(index.empty());
+    REQUIRE(index.volume().TotalVolume == 0);
+}
+
+TEST_CASE("Volume index order book", "[TradingPlatform][Matching]")
+{
+    // Reference market uses price level trees only, the other one uses a small price ladder
+    MarketManager tree_market;
+    MarketManager ladder_market;
+
+    const char name[8] = "test";
+    Symbol symbol = { 0, name };
+    tree_market.AddSymbol(symbol);
+    tree_market.AddOrderBook(symbol);
+    tree_market.EnableMatching();
+    ladder_market.AddSymbol(symbol);
+    ladder_market.AddOrderBook(symbol, 64, 10);
+    ladder_market.EnableMatching();
+
+    uint64_t seed = 1;
+    auto random = [&seed](uint64_t range)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        return (seed >> 33) % range;
+    };
+
+    std::vector<uint64_t> ids;
+    for (uint64_t id = 1; id <= 10000; ++id)
+    {
+        if (!ids.empty() && (random(4) == 0))
+        {
+            // Delete or reduce a random order if it was not filled yet
+            size_t index = (size_t)random(ids.size());
+            if (ladder_market.GetOrder(ids[index]) != nullptr)
+            {
+                if (random(2) == 0)
+                {
+                    tree_market.DeleteOrder(ids[index]);
+                    ladder_market.DeleteOrder(ids[index]);
+                }
+                else
+                {
+                    tree_market.ReduceOrder(ids[index], 1);
+                    ladder_market.ReduceOrder(ids[index], 1);
+                }
+            }
+            if (ladder_market.GetOrder(ids[index]) == nullptr)
+            {
+                ids[index] = ids.back();
+                ids.pop_back();
+            }
+        }
+        else
+        {
+            // Add a limit order of a random time in force and visibility
+            uint64_t price = 900 + random(200);
+            uint64_t quantity = 1 + random(100);
+            OrderTimeInForce tif = OrderTimeInForce::GTC;
+            switch (random(8))
+            {
+                case 0: tif = OrderTimeInForce::AON; break;
+                case 1: tif = OrderTimeInForce::FOK; break;
+                case 2: tif = OrderTimeInForce::IOC; break;
+                default: break;
+            }
+            uint64_t max_visible = (random(4) == 0) ? random(quantity) : std::numeric_limits<uint64_t>::max();
+            Order order = (random(2) == 0) ? Order::BuyLimit(id, 0, price - 50, quantity, tif, max_visible) : Order::SellLimit(id, 0, price + 50, quantity, tif, max_visible);
+            tree_market.AddOrder(order);
+            ladder_market.AddOrder(order);
+            REQUIRE((tree_market.GetOrder(id) == nullptr) == (ladder_market.GetOrder(id) == nullptr));
+            if (ladder_market.GetOrder(id) != nullptr)
+                ids.push_back(id);
+        }
+
+        const OrderBook* tree_book_ptr = tree_market.GetOrderBook(0);
+        const OrderBook* ladder_book_ptr = ladder_market.GetOrderBook(0);
+        REQUIRE(tree_book_ptr->bid_index().size() == tree_book_ptr->bid_levels());
+        REQUIRE(tree_book_ptr->ask_index().size() == tree_book_ptr->ask_levels());
+        REQUIRE(ladder_book_ptr->bid_index().size() == ladder_book_ptr->bid_levels());
+        REQUIRE(ladder_book_ptr->ask_index().size() == ladder_book_ptr->ask_levels());
+        if ((id % 50) == 0)
+        {
+            for (uint64_t price = 800; price < 1200; price += 7)
+            {
+                CheckVolume(tree_book_ptr, OrderSide::BUY, price);
+                CheckVolume(tree_book_ptr, OrderSide::SELL, price);
+                CheckVolume(ladder_book_ptr, OrderSide::BUY, price);
+                CheckVolume(ladder_book_ptr, OrderSide::SELL, price);
+            }
+            for (uint64_t volume = 0; volume < 5000; volume += 13)
+            {
+                REQUIRE(tree_book_ptr->PriceForVolume(OrderSide::BUY, volume) == WalkLevel(tree_book_ptr, tree_book_ptr->best_ask(), volume));
+                REQUIRE(tree_book_ptr->PriceForVolume(OrderSide::SELL, volume) == WalkLevel(tree_book_ptr, tree_book_ptr->best_bid(), volume));
+                REQUIRE(ladder_book_ptr->PriceForVolume(OrderSide::BUY, volume) == WalkLevel(ladder_book_ptr, ladder_book_ptr->best_ask(), volume));
+                REQUIRE(ladder_book_ptr->PriceForVolume(OrderSide::SELL, volume) == WalkLevel(ladder_book_ptr, ladder_book_ptr->best_bid(), volume));
+            }
+        }
+    }
+
+    REQUIRE(tree_market.GetOrderBook(0)->bid_index().volume().AONVolume > 0);
+}
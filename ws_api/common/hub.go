@@ -1,6 +1,7 @@
 package common
 
 import (
+	"encoding/binary"
 	"time"
 
 	"github.com/lirm/aeron-go/aeron/atomic"
@@ -68,9 +69,17 @@ func (hub *Hub) listenAeron() {
 	defer hub.subscriber.Disconnect()
 
 	handler := func(buffer *atomic.Buffer, offset int32, length int32, header *logbuffer.Header) {
+		// Aeron message may contain several length-prefixed frames
 		message := buffer.GetBytesArray(offset, length)
-		if len(message) > 2 {
-			switch message[2] {
+		for len(message) > 2 {
+			size := int(binary.BigEndian.Uint16(message[0:2]))
+			if size == 0 || len(message) < 2+size {
+				hub.logger.Info("[AERON] Message received: malformed frame\n")
+				return
+			}
+			frame := message[2 : 2+size]
+			message = message[2+size:]
+			switch frame[0] {
 			case 'A':
 				// Accepted order
 				hub.logger.Info("[AERON] Message received: OrderAcceptedMessage\n")
@@ -83,9 +92,9 @@ func (hub *Hub) listenAeron() {
 			default:
 				// Unknown message type
 				hub.logger.Info("[AERON] Message received: unknown\n")
-				return
+				continue
 			}
-			hub.Broadcast <- message[2:]
+			hub.Broadcast <- frame
 		}
 	}
 